@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <ba/base_encoding.hpp>
+#include <ba/bytearray.hpp>
+
+static ba::bytearray<> filled(std::size_t size)
+{
+    ba::bytearray<> result;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back<uint8_t>(uint8_t(i * 151 + (i >> 8)));
+    }
+
+    return result;
+}
+
+static void hexToString(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::to_string(array).data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void base64Encode(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::base64_encode(array).data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void base64Decode(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+    auto text = ba::base64_encode(array);
+    auto mode = state.range(1) != 0 ? ba::decode_mode::lenient : ba::decode_mode::strict;
+
+    for (auto _ : state)
+    {
+        ba::bytearray<> result;
+
+        benchmark::DoNotOptimize(ba::base64_decode(text, result, ba::base64_alphabet::standard, mode));
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void base32Encode(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::base32_encode(array).data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void base32Decode(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+    auto text = ba::base32_encode(array);
+
+    for (auto _ : state)
+    {
+        ba::bytearray<> result;
+
+        benchmark::DoNotOptimize(ba::base32_decode(text, result));
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void z85Encode(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::z85_encode(array).data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void z85Decode(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+    auto text = ba::z85_encode(array);
+
+    for (auto _ : state)
+    {
+        ba::bytearray<> result;
+
+        benchmark::DoNotOptimize(ba::z85_decode(text, result));
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+BENCHMARK(hexToString)->Arg(1 << 16);
+BENCHMARK(base64Encode)->Arg(1 << 16);
+BENCHMARK(base64Decode)->Args({1 << 16, 0})->Args({1 << 16, 1});
+BENCHMARK(base32Encode)->Arg(1 << 16);
+BENCHMARK(base32Decode)->Arg(1 << 16);
+BENCHMARK(z85Encode)->Arg(1 << 16);
+BENCHMARK(z85Decode)->Arg(1 << 16);
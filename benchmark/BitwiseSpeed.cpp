@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <ba/bitwise.hpp>
+#include <ba/bytearray.hpp>
+
+static ba::bytearray<> filled(std::size_t size, uint8_t value)
+{
+    ba::bytearray<> result;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back<uint8_t>(uint8_t(value + i));
+    }
+
+    return result;
+}
+
+static void xorBytewise(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)), 1);
+    auto other = filled(array.size(), 2);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < array.size(); ++i)
+        {
+            array[i] ^= other[i];
+        }
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void xorWith(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)), 1);
+    auto other = filled(array.size(), 2);
+
+    for (auto _ : state)
+    {
+        array.xor_with(other);
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void xorMaskBytewise(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)), 1);
+    uint8_t key[4] = {0x37, 0xFA, 0x21, 0x3D};
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < array.size(); ++i)
+        {
+            array[i] ^= std::byte(key[i % 4]);
+        }
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void xorMask(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)), 1);
+    auto key = filled(static_cast<std::size_t>(state.range(1)), 0x37);
+
+    for (auto _ : state)
+    {
+        array.xor_mask(key);
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void invert(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)), 1);
+
+    for (auto _ : state)
+    {
+        array.invert();
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+BENCHMARK(xorBytewise)->Arg(1 << 16);
+BENCHMARK(xorWith)->Arg(1 << 16);
+BENCHMARK(xorMaskBytewise)->Arg(1 << 16);
+BENCHMARK(xorMask)->Args({1 << 16, 4})->Args({1 << 16, 3})->Args({1 << 16, 100});
+BENCHMARK(invert)->Arg(1 << 16);
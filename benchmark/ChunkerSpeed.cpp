@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/chunker.hpp>
+
+#include <random>
+
+static ba::bytearray<> blob(std::size_t size)
+{
+    std::mt19937 generator(45);
+
+    ba::bytearray<> result;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back<uint8_t>(uint8_t(generator()));
+    }
+
+    return result;
+}
+
+static void chunkerSplit(benchmark::State& state)
+{
+    auto data = blob(1 << 24);
+
+    ba::chunker chunker(2048, static_cast<std::size_t>(state.range(0)), 65536);
+
+    std::size_t chunks = 0;
+
+    for (auto _ : state)
+    {
+        chunks = 0;
+        chunker.split(data.data(), data.size(), [&](std::size_t, std::size_t) { ++chunks; });
+
+        benchmark::DoNotOptimize(chunks);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+    state.counters["chunk"] = double(data.size()) / double(chunks);
+}
+
+static void chunkerRange(benchmark::State& state)
+{
+    auto data = blob(1 << 24);
+
+    ba::chunker chunker;
+
+    for (auto _ : state)
+    {
+        std::size_t size = 0;
+
+        for (auto chunk : ba::chunks(data, chunker))
+        {
+            size += chunk.size();
+        }
+
+        benchmark::DoNotOptimize(size);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+BENCHMARK(chunkerSplit)->Arg(4096)->Arg(8192)->Arg(16384);
+BENCHMARK(chunkerRange);
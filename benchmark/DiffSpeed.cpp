@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/diff.hpp>
+
+#include <random>
+
+static ba::bytearray<> blob(std::size_t size)
+{
+    std::mt19937 generator(43);
+
+    ba::bytearray<> result;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back<uint8_t>(uint8_t(generator()));
+    }
+
+    return result;
+}
+
+static ba::bytearray<> changed(const ba::bytearray<>& source, std::size_t changes)
+{
+    std::mt19937 generator(44);
+
+    auto result = source;
+
+    for (std::size_t i = 0; i < changes; ++i)
+    {
+        result.set<uint8_t>(generator() % result.size(), uint8_t(generator()));
+    }
+
+    return result;
+}
+
+static void diffCreate(benchmark::State& state)
+{
+    auto source = blob(static_cast<std::size_t>(state.range(0)));
+    auto target = changed(source, 100);
+
+    ba::bytearray<> patch;
+
+    for (auto _ : state)
+    {
+        patch.clear();
+        ba::diff(source.data(), source.size(), target.data(), target.size(), patch);
+
+        benchmark::DoNotOptimize(patch.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(target.size()));
+    state.counters["patch"] = double(patch.size());
+}
+
+static void diffApply(benchmark::State& state)
+{
+    auto source = blob(static_cast<std::size_t>(state.range(0)));
+    auto target = changed(source, 100);
+    auto patch = ba::diff(source, target);
+
+    std::vector<uint8_t> output(target.size());
+
+    for (auto _ : state)
+    {
+        auto size = output.size();
+
+        ba::apply_diff(source.data(), source.size(), patch.data(), patch.size(), output.data(), size);
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(target.size()));
+}
+
+static void diffUnrelated(benchmark::State& state)
+{
+    auto source = blob(static_cast<std::size_t>(state.range(0)));
+    auto target = changed(source, source.size());
+
+    ba::bytearray<> patch;
+
+    for (auto _ : state)
+    {
+        patch.clear();
+        ba::diff(source.data(), source.size(), target.data(), target.size(), patch);
+
+        benchmark::DoNotOptimize(patch.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(target.size()));
+}
+
+BENCHMARK(diffCreate)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK(diffApply)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK(diffUnrelated)->Arg(1 << 20);
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/format.hpp>
+
+#include <random>
+#include <string>
+
+#if defined(__cpp_lib_format)
+#define BA_BENCHMARK_FORMAT std::format
+#elif defined(FMT_VERSION)
+#define BA_BENCHMARK_FORMAT fmt::format
+#endif
+
+static ba::bytearray<> sample(std::size_t size)
+{
+    std::mt19937 generator(42);
+    ba::bytearray<> result;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back(uint8_t(generator()));
+    }
+
+    return result;
+}
+
+static void hexToString(benchmark::State& state)
+{
+    auto data = sample(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::to_string(data));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+BENCHMARK(hexToString)->Arg(64)->Arg(1 << 16);
+
+#if defined(BA_BENCHMARK_FORMAT)
+static void hexFormat(benchmark::State& state)
+{
+    auto data = sample(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(BA_BENCHMARK_FORMAT("{:X}", data));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void hexFormatSeparated(benchmark::State& state)
+{
+    auto data = sample(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(BA_BENCHMARK_FORMAT("{:s}", data));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void hexdumpFormat(benchmark::State& state)
+{
+    auto data = sample(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(BA_BENCHMARK_FORMAT("{:d}", data));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+BENCHMARK(hexFormat)->Arg(64)->Arg(1 << 16);
+BENCHMARK(hexFormatSeparated)->Arg(1 << 16);
+BENCHMARK(hexdumpFormat)->Arg(1 << 16);
+#endif
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <ba/histogram.hpp>
+
+#include <random>
+#include <vector>
+
+static std::vector<uint8_t> sample(std::size_t size, uint32_t range)
+{
+    std::mt19937 generator(42);
+    std::vector<uint8_t> result(size);
+
+    for (auto& value : result)
+    {
+        value = uint8_t(generator() % range);
+    }
+
+    return result;
+}
+
+static void histogramBytewise(benchmark::State& state)
+{
+    auto data = sample(static_cast<std::size_t>(state.range(0)), static_cast<uint32_t>(state.range(1)));
+
+    for (auto _ : state)
+    {
+        ba::byte_histogram result{};
+
+        for (auto value : data)
+        {
+            ++result[value];
+        }
+
+        benchmark::DoNotOptimize(result.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void histogram(benchmark::State& state)
+{
+    auto data = sample(static_cast<std::size_t>(state.range(0)), static_cast<uint32_t>(state.range(1)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::histogram(data.data(), data.size()).data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void histogramThreads(benchmark::State& state)
+{
+    auto data = sample(static_cast<std::size_t>(state.range(0)), 256);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::histogram(data.data(), data.size(), unsigned(state.range(1))).data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void entropy(benchmark::State& state)
+{
+    auto data = sample(static_cast<std::size_t>(state.range(0)), 256);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::entropy(data.data(), data.size()));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+// Range 1 - all bytes are equal, worst case for single table
+BENCHMARK(histogramBytewise)->Args({1 << 16, 256})->Args({1 << 16, 1});
+BENCHMARK(histogram)->Args({1 << 16, 256})->Args({1 << 16, 1});
+BENCHMARK(histogramThreads)->Args({1 << 26, 1})->Args({1 << 26, 4})->UseRealTime();
+BENCHMARK(entropy)->Arg(1 << 16);
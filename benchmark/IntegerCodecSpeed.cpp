@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/integer_codec.hpp>
+
+static std::vector<uint64_t> timestamps(std::size_t count)
+{
+    std::vector<uint64_t> result(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        result[i] = 1600000000000ULL + i * 1000 + (i * 7919) % 64;
+    }
+
+    return result;
+}
+
+static void decodeIntegers(benchmark::State& state)
+{
+    auto values = timestamps(static_cast<std::size_t>(state.range(0)));
+
+    ba::bytearray<> array;
+
+    ba::encode_integers(array, values, ba::integer_encoding::delta);
+
+    ba::integer_decoder<uint64_t> decoder(array);
+
+    for (auto _ : state)
+    {
+        decoder.decode(values.data());
+
+        benchmark::DoNotOptimize(values.data());
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(values.size()));
+    state.counters["bytes_per_value"] = double(array.size()) / double(values.size());
+}
+
+static void readFixedWidth(benchmark::State& state)
+{
+    auto values = timestamps(static_cast<std::size_t>(state.range(0)));
+
+    ba::bytearray<> array;
+
+    array.push_back_multiple(values.begin(), values.end());
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = array.read<uint64_t>(i * sizeof(uint64_t));
+        }
+
+        benchmark::DoNotOptimize(values.data());
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(values.size()));
+    state.counters["bytes_per_value"] = double(array.size()) / double(values.size());
+}
+
+static void encodeIntegers(benchmark::State& state)
+{
+    auto values = timestamps(static_cast<std::size_t>(state.range(0)));
+
+    ba::bytearray<> array;
+
+    for (auto _ : state)
+    {
+        array.clear();
+        ba::encode_integers(array, values, ba::integer_encoding::delta);
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(values.size()));
+}
+
+BENCHMARK(decodeIntegers)
+    ->Range(1 << 10, 1 << 20);
+
+BENCHMARK(readFixedWidth)
+    ->Range(1 << 10, 1 << 20);
+
+BENCHMARK(encodeIntegers)
+    ->Range(1 << 10, 1 << 20);
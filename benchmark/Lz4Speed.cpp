@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/lz4.hpp>
+
+#include <cstring>
+#include <random>
+
+static ba::bytearray<> messages(std::size_t size)
+{
+    std::mt19937 generator(41);
+
+    ba::bytearray<> result;
+
+    while (result.size() < size)
+    {
+        auto line = "{\"id\":" + std::to_string(generator() % 100000) + ",\"sensor\":\"temperature\",\"value\":" +
+                    std::to_string(generator() % 1000) + "}\n";
+
+        for (auto c : line)
+        {
+            result.push_back<char>(c);
+        }
+    }
+
+    return result;
+}
+
+static void lz4Compress(benchmark::State& state)
+{
+    auto data = messages(static_cast<std::size_t>(state.range(0)));
+
+    ba::lz4_state lz4;
+
+    std::vector<uint8_t> output(ba::lz4_compress_bound(data.size()));
+
+    std::size_t compressed = 0;
+
+    for (auto _ : state)
+    {
+        compressed = ba::lz4_compress(data.data(), data.size(), output.data(), output.size(), lz4);
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+    state.counters["ratio"] = double(data.size()) / double(compressed);
+}
+
+static void lz4Decompress(benchmark::State& state)
+{
+    auto data = messages(static_cast<std::size_t>(state.range(0)));
+    auto compressed = ba::lz4_compress(data);
+
+    std::vector<uint8_t> output(data.size());
+
+    for (auto _ : state)
+    {
+        auto size = output.size();
+
+        ba::lz4_decompress(compressed.data(), compressed.size(), output.data(), size);
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void memcpyCopy(benchmark::State& state)
+{
+    auto data = messages(static_cast<std::size_t>(state.range(0)));
+
+    std::vector<uint8_t> output(data.size());
+
+    for (auto _ : state)
+    {
+        std::memcpy(output.data(), data.data(), data.size());
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+BENCHMARK(lz4Compress)
+    ->Range(1 << 12, 1 << 22);
+
+BENCHMARK(lz4Decompress)
+    ->Range(1 << 12, 1 << 22);
+
+BENCHMARK(memcpyCopy)
+    ->Range(1 << 12, 1 << 22);
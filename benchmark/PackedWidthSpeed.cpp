@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+
+static void unpackWidth(benchmark::State& state)
+{
+    std::vector<uint32_t> samples(static_cast<std::size_t>(state.range(0)), 0x123456);
+
+    ba::bytearray<> array;
+
+    array.pack_width<3>(samples);
+
+    for (auto _ : state)
+    {
+        array.unpack_width<3>(0, samples.data(), samples.size());
+
+        benchmark::DoNotOptimize(samples.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void readPartLoop(benchmark::State& state)
+{
+    std::vector<uint32_t> samples(static_cast<std::size_t>(state.range(0)), 0x123456);
+
+    ba::bytearray<> array;
+
+    array.pack_width<3>(samples);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < samples.size(); ++i)
+        {
+            samples[i] = array.read_part<uint32_t>(i * 3, 3);
+        }
+
+        benchmark::DoNotOptimize(samples.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void packWidth(benchmark::State& state)
+{
+    std::vector<uint32_t> samples(static_cast<std::size_t>(state.range(0)), 0x123456);
+
+    ba::bytearray<> array;
+
+    for (auto _ : state)
+    {
+        array.clear();
+        array.pack_width<3>(samples);
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+static void pushBackPartLoop(benchmark::State& state)
+{
+    std::vector<uint32_t> samples(static_cast<std::size_t>(state.range(0)), 0x123456);
+
+    ba::bytearray<> array;
+
+    for (auto _ : state)
+    {
+        array.clear();
+
+        for (auto sample : samples)
+        {
+            array.push_back_part(sample, 3);
+        }
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+BENCHMARK(unpackWidth)
+    ->Range(1 << 8, 1 << 20);
+
+BENCHMARK(readPartLoop)
+    ->Range(1 << 8, 1 << 20);
+
+BENCHMARK(packWidth)
+    ->Range(1 << 8, 1 << 20);
+
+BENCHMARK(pushBackPartLoop)
+    ->Range(1 << 8, 1 << 20);
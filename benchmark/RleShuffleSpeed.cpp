@@ -0,0 +1,152 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/rle.hpp>
+#include <ba/shuffle.hpp>
+
+#include <cstring>
+#include <random>
+
+static ba::bytearray<> sparse(std::size_t size)
+{
+    std::mt19937 generator(42);
+
+    ba::bytearray<> result(size);
+
+    for (std::size_t i = 0; i < size / 64; ++i)
+    {
+        result.set<uint8_t>(generator() % size, uint8_t(generator()));
+    }
+
+    return result;
+}
+
+static void rleEncode(benchmark::State& state)
+{
+    auto data = sparse(static_cast<std::size_t>(state.range(0)));
+
+    ba::bytearray<> encoded;
+
+    for (auto _ : state)
+    {
+        encoded.clear();
+        ba::rle_encode(data, encoded);
+
+        benchmark::DoNotOptimize(encoded.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+    state.counters["ratio"] = double(data.size()) / double(encoded.size());
+}
+
+static void rleDecode(benchmark::State& state)
+{
+    auto data = sparse(static_cast<std::size_t>(state.range(0)));
+
+    ba::bytearray<> encoded;
+    ba::rle_encode(data, encoded);
+
+    ba::bytearray<> decoded;
+
+    for (auto _ : state)
+    {
+        decoded.clear();
+        ba::rle_decode(encoded, decoded);
+
+        benchmark::DoNotOptimize(decoded.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void zeroRleEncode(benchmark::State& state)
+{
+    auto data = sparse(static_cast<std::size_t>(state.range(0)));
+
+    ba::bytearray<> encoded;
+
+    for (auto _ : state)
+    {
+        encoded.clear();
+        ba::zero_rle_encode(data, encoded);
+
+        benchmark::DoNotOptimize(encoded.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+    state.counters["ratio"] = double(data.size()) / double(encoded.size());
+}
+
+static void byteShuffle(benchmark::State& state)
+{
+    auto width = static_cast<std::size_t>(state.range(0));
+    auto data = sparse(1 << 20);
+
+    std::vector<uint8_t> output(data.size());
+
+    for (auto _ : state)
+    {
+        ba::byte_shuffle(data.data(), data.size(), width, output.data());
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void byteUnshuffle(benchmark::State& state)
+{
+    auto width = static_cast<std::size_t>(state.range(0));
+    auto data = sparse(1 << 20);
+
+    std::vector<uint8_t> output(data.size());
+
+    for (auto _ : state)
+    {
+        ba::byte_unshuffle(data.data(), data.size(), width, output.data());
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void bitShuffle(benchmark::State& state)
+{
+    auto width = static_cast<std::size_t>(state.range(0));
+    auto data = sparse(1 << 20);
+
+    std::vector<uint8_t> output(data.size());
+
+    for (auto _ : state)
+    {
+        ba::bit_shuffle(data.data(), data.size(), width, output.data());
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+static void shuffleMemcpy(benchmark::State& state)
+{
+    auto data = sparse(1 << 20);
+
+    std::vector<uint8_t> output(data.size());
+
+    for (auto _ : state)
+    {
+        std::memcpy(output.data(), data.data(), data.size());
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(data.size()));
+}
+
+BENCHMARK(rleEncode)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(rleDecode)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(zeroRleEncode)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(byteShuffle)->Arg(2)->Arg(3)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK(byteUnshuffle)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK(bitShuffle)->Arg(1)->Arg(4)->Arg(8);
+BENCHMARK(shuffleMemcpy);
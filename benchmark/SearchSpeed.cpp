@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/search.hpp>
+
+static void findByte(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    ba::bytearray<> array(size);
+
+    array[size - 1] = std::byte(0x0A);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::find(array, uint8_t(0x0A)));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+
+static void findByteLoop(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    ba::bytearray<> array(size);
+
+    array[size - 1] = std::byte(0x0A);
+
+    for (auto _ : state)
+    {
+        std::size_t i = 0;
+
+        while (array[i] != std::byte(0x0A))
+        {
+            ++i;
+        }
+
+        benchmark::DoNotOptimize(i);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+
+static void findNeedle(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    ba::bytearray<> array(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        array[i] = std::byte(i % 7);
+    }
+
+    auto needle = "0102030405060002"_ba;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::find(array, needle));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+
+static void countByte(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+
+    ba::bytearray<> array(size);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::count(array, uint8_t(0x00)));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+
+BENCHMARK(findByte)
+    ->Range(1 << 6, 1 << 22);
+
+BENCHMARK(findByteLoop)
+    ->Range(1 << 6, 1 << 22);
+
+BENCHMARK(findNeedle)
+    ->Range(1 << 6, 1 << 22);
+
+BENCHMARK(countByte)
+    ->Range(1 << 6, 1 << 22);
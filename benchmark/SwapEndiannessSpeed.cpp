@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+
+static ba::bytearray<> filled(std::size_t size)
+{
+    ba::bytearray<> result;
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        result.push_back<uint8_t>(uint8_t(i * 13));
+    }
+
+    return result;
+}
+
+template <typename T>
+static void swapReadSet(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+    auto count = array.size() / sizeof(T);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            array.set<T>(i * sizeof(T), array.read<T>(i * sizeof(T), ba::endianness::big), ba::endianness::little);
+        }
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+template <typename T>
+static void swapEndianness(benchmark::State& state)
+{
+    auto array = filled(static_cast<std::size_t>(state.range(0)));
+    auto count = array.size() / sizeof(T);
+
+    for (auto _ : state)
+    {
+        array.swap_endianness<T>(0, count);
+
+        benchmark::DoNotOptimize(array.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+}
+
+BENCHMARK_TEMPLATE(swapReadSet, uint16_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(swapReadSet, uint32_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(swapReadSet, uint64_t)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(swapEndianness, uint16_t)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(swapEndianness, uint32_t)->Arg(1 << 16)->Arg(1 << 24);
+BENCHMARK_TEMPLATE(swapEndianness, uint64_t)->Arg(1 << 16)->Arg(1 << 24);
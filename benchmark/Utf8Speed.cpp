@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/utf8.hpp>
+
+#include <string>
+
+static std::string text(std::size_t size, bool ascii)
+{
+    // Latin text with some 2 and 3 byte characters
+    const std::string words[] = {"lorem ", "ipsum ", "d\xC3\xB6lor ", "\xE2\x82\xAC" "42 ", "\xD0\xBF\xD1\x80\xD0\xB8 "};
+    std::string result;
+
+    for (std::size_t i = 0; result.size() < size; ++i)
+    {
+        result += words[ascii ? i % 2 : i % 5];
+    }
+
+    result.resize(size);
+
+    while (!ba::validate_utf8(result.data(), result.size()))
+    {
+        result.pop_back();
+    }
+
+    return result;
+}
+
+static bool scalarValidate(const std::string& text)
+{
+    std::size_t i = 0;
+
+    while (i < text.size())
+    {
+        auto lead = uint8_t(text[i]);
+        std::size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+
+        if (lead >= 0x80 && lead < 0xC2)
+        {
+            return false;
+        }
+
+        if (text.size() - i < length)
+        {
+            return false;
+        }
+
+        for (std::size_t j = 1; j < length; ++j)
+        {
+            if ((uint8_t(text[i + j]) & 0xC0) != 0x80)
+            {
+                return false;
+            }
+        }
+
+        i += length;
+    }
+
+    return true;
+}
+
+static void validateBytewise(benchmark::State& state)
+{
+    auto input = text(static_cast<std::size_t>(state.range(0)), state.range(1) != 0);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(scalarValidate(input));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+
+static void validateUtf8(benchmark::State& state)
+{
+    auto input = text(static_cast<std::size_t>(state.range(0)), state.range(1) != 0);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::validate_utf8(input.data(), input.size()));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+
+static void countPrintableBytewise(benchmark::State& state)
+{
+    auto input = text(static_cast<std::size_t>(state.range(0)), false);
+
+    for (auto _ : state)
+    {
+        std::size_t result = 0;
+
+        for (auto c : input)
+        {
+            result += c >= ' ' && c <= '~';
+        }
+
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+
+static void countPrintable(benchmark::State& state)
+{
+    auto input = text(static_cast<std::size_t>(state.range(0)), false);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::count_printable(input.data(), input.size()));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+
+static void isAscii(benchmark::State& state)
+{
+    auto input = text(static_cast<std::size_t>(state.range(0)), true);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ba::is_ascii(input.data(), input.size()));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(input.size()));
+}
+
+BENCHMARK(validateBytewise)->Args({1 << 16, 1})->Args({1 << 16, 0});
+BENCHMARK(validateUtf8)->Args({1 << 16, 1})->Args({1 << 16, 0});
+BENCHMARK(countPrintableBytewise)->Arg(1 << 16);
+BENCHMARK(countPrintable)->Arg(1 << 16);
+BENCHMARK(isAscii)->Arg(1 << 16);
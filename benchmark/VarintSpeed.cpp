@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <ba/bytearray.hpp>
+#include <ba/varint.hpp>
+
+#include <random>
+
+static ba::bytearray<> varints(std::size_t count, unsigned maxBits)
+{
+    std::mt19937_64 generator(1);
+
+    ba::bytearray<> array;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        array.push_back_varint(generator() & ((uint64_t(1) << (1 + generator() % maxBits)) - 1));
+    }
+
+    return array;
+}
+
+static void decodeVarints(benchmark::State& state)
+{
+    auto array = varints(1 << 16, unsigned(state.range(0)));
+
+    std::vector<uint64_t> output;
+
+    for (auto _ : state)
+    {
+        output.clear();
+
+        benchmark::DoNotOptimize(ba::decode_varints(array, output));
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(output.size()));
+}
+
+static void readVarintLoop(benchmark::State& state)
+{
+    auto array = varints(1 << 16, unsigned(state.range(0)));
+
+    std::vector<uint64_t> output;
+
+    for (auto _ : state)
+    {
+        output.clear();
+
+        std::size_t position = 0;
+
+        while (position < array.size())
+        {
+            auto result = array.read_varint(position);
+
+            output.push_back(result.first);
+            position += result.second;
+        }
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(array.size()));
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(output.size()));
+}
+
+BENCHMARK(decodeVarints)
+    ->Arg(7)->Arg(14)->Arg(32)->Arg(64);
+
+BENCHMARK(readVarintLoop)
+    ->Arg(7)->Arg(14)->Arg(32)->Arg(64);
@@ -0,0 +1,1098 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_processor.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ba {
+
+/**
+ * @brief Base64 alphabet: standard one (`+/`) or
+ * URL and file name safe one (`-_`).
+ */
+enum class base64_alphabet { standard, url };
+
+/**
+ * @brief Decoding mode. Strict one accepts only
+ * alphabet symbols and correct padding (it may be
+ * omitted), unused bits of last symbol have to be 0,
+ * so every data has single valid encoding. Lenient one
+ * also skips whitespace (line breaks of MIME or PEM),
+ * any amount of trailing padding and ignores unused bits.
+ */
+enum class decode_mode { strict, lenient };
+
+namespace detail {
+
+constexpr uint8_t code_invalid = 0xFF;
+constexpr uint8_t code_space = 0xFE;
+
+constexpr std::string_view base64_standard_symbols = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr std::string_view base64_url_symbols = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr std::string_view base32_symbols = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+constexpr std::string_view z85_symbols = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+
+/**
+ * @brief Function for building table, that maps
+ * symbol to it's value, `code_space` or `code_invalid`.
+ */
+constexpr std::array<uint8_t, 256> make_code_table(std::string_view symbols, bool ignoreCase) {
+    std::array<uint8_t, 256> result{};
+
+    for (auto& value : result) {
+        value = code_invalid;
+    }
+
+    result[' '] = code_space;
+    result['\t'] = code_space;
+    result['\r'] = code_space;
+    result['\n'] = code_space;
+
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        auto symbol = uint8_t(symbols[i]);
+
+        result[symbol] = uint8_t(i);
+
+        if (ignoreCase && symbol >= 'A' && symbol <= 'Z') {
+            result[symbol - 'A' + 'a'] = uint8_t(i);
+        }
+    }
+
+    return result;
+}
+
+inline constexpr auto base64_standard_codes = make_code_table(base64_standard_symbols, false);
+inline constexpr auto base64_url_codes = make_code_table(base64_url_symbols, false);
+inline constexpr auto base32_codes = make_code_table(base32_symbols, false);
+inline constexpr auto base32_lenient_codes = make_code_table(base32_symbols, true);
+inline constexpr auto z85_codes = make_code_table(z85_symbols, false);
+
+inline bool is_code_space(uint8_t symbol) { return symbol == ' ' || symbol == '\t' || symbol == '\r' || symbol == '\n'; }
+
+/**
+ * @brief Function for getting length of text
+ * without trailing padding (and whitespace in
+ * lenient mode).
+ * @param pads Amount of removed padding symbols.
+ */
+inline std::size_t strip_padding(const uint8_t* text, std::size_t length, bool lenient, std::size_t& pads) {
+    pads = 0;
+
+    while (length != 0 && (text[length - 1] == '=' || (lenient && is_code_space(text[length - 1])))) {
+        pads += text[length - 1] == '=';
+        --length;
+    }
+
+    return length;
+}
+
+/**
+ * @brief Function for encoding of `Bits` bits per
+ * symbol, groups of `8 * Bits` bits are encoded at once.
+ * @return Amount of written symbols.
+ */
+template <unsigned Bits>
+std::size_t encode_radix(const uint8_t* data, std::size_t size, char* output, std::string_view symbols, bool padding) {
+    constexpr std::size_t group = 8 / (Bits == 6 ? 2 : 1);
+    constexpr std::size_t groupBytes = group * Bits / 8;
+
+    std::size_t written = 0;
+    std::size_t position = 0;
+
+    for (; position + groupBytes <= size; position += groupBytes) {
+        uint64_t value = 0;
+
+        for (std::size_t i = 0; i < groupBytes; ++i) {
+            value = value << 8 | data[position + i];
+        }
+
+        for (std::size_t i = 0; i < group; ++i) {
+            output[written + i] = symbols[(value >> (Bits * (group - 1 - i))) & ((1u << Bits) - 1)];
+        }
+
+        written += group;
+    }
+
+    if (position == size) {
+        return written;
+    }
+
+    // Last group is filled with zero bits
+    uint64_t value = 0;
+    auto rest = size - position;
+
+    for (std::size_t i = 0; i < rest; ++i) {
+        value = value << 8 | data[position + i];
+    }
+
+    auto bits = rest * 8;
+    auto count = (bits + Bits - 1) / Bits;
+
+    value <<= count * Bits - bits;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        output[written++] = symbols[(value >> (Bits * (count - 1 - i))) & ((1u << Bits) - 1)];
+    }
+
+    for (; padding && count < group; ++count) {
+        output[written++] = '=';
+    }
+
+    return written;
+}
+
+/**
+ * @brief Function for decoding of `Bits` bits per
+ * symbol. Whole groups of symbols are decoded at once
+ * (`bulk` is tried first), symbol by symbol decoding is
+ * used only around whitespace and at the end.
+ * @param outputSize Capacity of output on input,
+ * decoded size on output.
+ * @return Is text valid.
+ */
+template <unsigned Bits, typename Bulk>
+bool decode_radix(const uint8_t* text,
+                  std::size_t length,
+                  uint8_t* output,
+                  std::size_t& outputSize,
+                  const std::array<uint8_t, 256>& codes,
+                  decode_mode mode,
+                  Bulk&& bulk) {
+    constexpr std::size_t group = 8 / (Bits == 6 ? 2 : 1);
+    constexpr std::size_t groupBytes = group * Bits / 8;
+    constexpr unsigned limit = 1u << Bits;
+
+    auto lenient = mode == decode_mode::lenient;
+
+    std::size_t pads;
+    auto end = strip_padding(text, length, lenient, pads);
+
+    if (!lenient && pads != 0 && (length % group != 0 || pads >= group)) {
+        return false;
+    }
+
+    auto capacity = outputSize;
+    std::size_t written = 0;
+    std::size_t position = 0;
+
+    uint64_t accumulator = 0;
+    unsigned bits = 0;
+
+    while (position < end) {
+        if (bits == 0) {
+            bulk(text, position, end, output, written, capacity);
+
+            for (; position + group <= end; position += group) {
+                uint64_t value = 0;
+                unsigned check = 0;
+
+                for (std::size_t i = 0; i < group; ++i) {
+                    auto code = codes[text[position + i]];
+
+                    check |= code;
+                    value = value << Bits | code;
+                }
+
+                if (check >= limit) {
+                    break;
+                }
+
+                if (capacity - written < groupBytes) {
+                    return false;
+                }
+
+                for (std::size_t i = 0; i < groupBytes; ++i) {
+                    output[written + i] = uint8_t(value >> (8 * (groupBytes - 1 - i)));
+                }
+
+                written += groupBytes;
+            }
+
+            if (position == end) {
+                break;
+            }
+        }
+
+        auto code = codes[text[position++]];
+
+        if (code < limit) {
+            accumulator = accumulator << Bits | code;
+            bits += Bits;
+
+            if (bits >= 8) {
+                bits -= 8;
+
+                if (written == capacity) {
+                    return false;
+                }
+
+                output[written++] = uint8_t(accumulator >> bits);
+                accumulator &= (uint64_t(1) << bits) - 1;
+            }
+        } else if (!lenient || code != code_space) {
+            return false;
+        }
+    }
+
+    // Last symbol has to give bits to last byte
+    if (bits >= Bits || (!lenient && accumulator != 0)) {
+        return false;
+    }
+
+    outputSize = written;
+
+    return true;
+}
+
+struct no_bulk {
+    void operator()(const uint8_t*, std::size_t&, std::size_t, uint8_t*, std::size_t&, std::size_t) const {}
+};
+
+#if defined(BA_SIMD_AVX2)
+/**
+ * @brief Function for encoding 24 bytes to 32
+ * symbols per iteration (Muła and Lemire). Every
+ * 3 bytes are spread to 4 byte lane, 6 bit values
+ * are extracted with multiplications and translated
+ * to symbols by offset, that is looked up by range.
+ */
+inline void base64_encode_avx2(const uint8_t* data, std::size_t& position, std::size_t size, char* output, std::size_t& written, bool url) {
+    auto spread = _mm256_setr_epi8(5, 4, 6, 5, 8, 7, 9, 8, 11, 10, 12, 11, 14, 13, 15, 14, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    auto shift = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+    auto plus = char(url ? '-' - 62 : '+' - 62);
+    auto slash = char(url ? '_' - 63 : '/' - 63);
+    auto offsets = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, plus, slash, 0, 0,
+                                    65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, plus, slash, 0, 0);
+
+    // 32 bytes are loaded, 24 are used
+    for (; position + 32 <= size; position += 24, written += 32) {
+        auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+
+        input = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(input, shift), spread);
+
+        auto high = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+        auto low = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+        auto values = _mm256_or_si256(high, low);
+
+        // 0 - 25, 26 - 51, 52 - 61, 62, 63 ranges
+        auto range = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+
+        range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(values, _mm256_set1_epi8(25)));
+
+        auto symbols = _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, range));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + written), symbols);
+    }
+}
+
+/**
+ * @brief Functor for decoding 32 symbols to 24
+ * bytes per iteration. Symbol is valid, if bit of it's
+ * high nibble is not set in mask of it's low nibble,
+ * value is symbol plus offset of it's high nibble, one
+ * symbol, that shares nibble with other range, has own
+ * offset. Block with invalid symbol is left for scalar
+ * decoding.
+ */
+class base64_decode_avx2 {
+public:
+    explicit base64_decode_avx2(bool url) {
+        auto& codes = url ? base64_url_codes : base64_standard_codes;
+
+        uint8_t low[16] = {};
+        uint8_t high[16] = {};
+
+        for (unsigned nibble = 0; nibble < 16; ++nibble) {
+            high[nibble] = nibble >= 2 && nibble <= 7 ? uint8_t(1u << (nibble - 1)) : 1;
+            low[nibble] = 1;
+
+            for (unsigned row = 2; row <= 7; ++row) {
+                if (codes[row << 4 | nibble] >= 64) {
+                    low[nibble] |= uint8_t(1u << (row - 1));
+                }
+            }
+        }
+
+        m_low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(low)));
+        m_high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(high)));
+
+        auto plus = char(url ? 62 - '-' : 62 - '+');
+
+        m_offsets = _mm256_setr_epi8(0, 0, plus, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                     0, 0, plus, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        m_special = _mm256_set1_epi8(url ? '_' : '/');
+        m_specialOffset = _mm256_set1_epi8(char(url ? 63 - '_' : 63 - '/'));
+    }
+
+    void operator()(const uint8_t* text, std::size_t& position, std::size_t end, uint8_t* output, std::size_t& written, std::size_t capacity) const {
+        auto nibbles = _mm256_set1_epi8(0x0F);
+        auto pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                     2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        auto gather = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+        // 32 bytes are stored, 24 are used
+        while (position + 32 <= end && capacity - written >= 32) {
+            auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + position));
+            auto high = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbles);
+            auto invalid = _mm256_and_si256(_mm256_shuffle_epi8(m_low, _mm256_and_si256(input, nibbles)), _mm256_shuffle_epi8(m_high, high));
+
+            if (!_mm256_testz_si256(invalid, invalid)) {
+                return;
+            }
+
+            auto offsets = _mm256_blendv_epi8(_mm256_shuffle_epi8(m_offsets, high), m_specialOffset, _mm256_cmpeq_epi8(input, m_special));
+            auto values = _mm256_add_epi8(input, offsets);
+
+            // 4 values of 6 bits to 24 bits of lane
+            auto pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+            auto lanes = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+            auto bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(lanes, pack), gather);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + written), bytes);
+
+            position += 32;
+            written += 24;
+        }
+    }
+
+private:
+    __m256i m_low;
+    __m256i m_high;
+    __m256i m_offsets;
+    __m256i m_special;
+    __m256i m_specialOffset;
+};
+
+/**
+ * @brief Function for encoding 20 bytes to 32
+ * symbols per iteration. Every lane gets 2 groups of 5
+ * bytes, even and odd symbols are shuffled to 16 bit
+ * windows, that contain their bits, and are shifted
+ * right by multiplication (AVX2 has no variable 16 bit
+ * shifts).
+ */
+inline void base32_encode_avx2(const uint8_t* data, std::size_t& position, std::size_t size, char* output, std::size_t& written) {
+    // Windows (big endian pairs) of symbols 0, 2, 4, 6 and 1, 3, 5, 7
+    auto even = _mm256_setr_epi8(1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8, 1, 0, 2, 1, 3, 2, 4, 3, 6, 5, 7, 6, 8, 7, 9, 8);
+    auto odd = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 6, 5, 7, 6, 9, 8, 10, 9, 1, 0, 2, 1, 4, 3, 5, 4, 6, 5, 7, 6, 9, 8, 10, 9);
+
+    // Right shifts by 11, 9, 7, 5 and 6, 4, 10, 8 bits
+    auto evenShift = _mm256_setr_epi16(32, 128, 512, 2048, 32, 128, 512, 2048, 32, 128, 512, 2048, 32, 128, 512, 2048);
+    auto oddShift = _mm256_setr_epi16(1024, 4096, 64, 256, 1024, 4096, 64, 256, 1024, 4096, 64, 256, 1024, 4096, 64, 256);
+    auto mask = _mm256_set1_epi16(0x1F);
+
+    // 26 bytes are loaded, 20 are used
+    for (; position + 26 <= size; position += 20, written += 32) {
+        auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + 10));
+        auto input = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+
+        auto evenValues = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(input, even), evenShift), mask);
+        auto oddValues = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(input, odd), oddShift), mask);
+        auto values = _mm256_or_si256(evenValues, _mm256_slli_epi16(oddValues, 8));
+
+        // A - Z, then 2 - 7
+        auto offsets = _mm256_add_epi8(_mm256_set1_epi8('A'), _mm256_and_si256(_mm256_cmpgt_epi8(values, _mm256_set1_epi8(25)),
+                                                                               _mm256_set1_epi8(char('2' - 26 - 'A'))));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + written), _mm256_add_epi8(values, offsets));
+    }
+}
+
+/**
+ * @brief Functor for decoding 32 symbols to 20 bytes
+ * per iteration. Symbols are translated by ranges
+ * (A - Z, 2 - 7 and a - z in lenient mode), 8 values of
+ * 5 bits are joined with multiply-adds and 64 bit shifts.
+ * Block with other symbols is left for scalar decoding.
+ */
+class base32_decode_avx2 {
+public:
+    explicit base32_decode_avx2(bool lenient) :
+        m_lenient(lenient) {}
+
+    void operator()(const uint8_t* text, std::size_t& position, std::size_t end, uint8_t* output, std::size_t& written, std::size_t capacity) const {
+        auto pack = _mm256_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1,
+                                     4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1);
+
+        // 26 bytes are stored, 20 are used
+        while (position + 32 <= end && capacity - written >= 26) {
+            auto input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + position));
+
+            auto letters = _mm256_sub_epi8(input, _mm256_set1_epi8('A'));
+            auto digits = _mm256_sub_epi8(input, _mm256_set1_epi8('2'));
+            auto isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(25)), letters);
+            auto isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(5)), digits);
+
+            if (m_lenient) {
+                auto lower = _mm256_sub_epi8(input, _mm256_set1_epi8('a'));
+                auto isLower = _mm256_cmpeq_epi8(_mm256_min_epu8(lower, _mm256_set1_epi8(25)), lower);
+
+                letters = _mm256_blendv_epi8(letters, lower, isLower);
+                isLetter = _mm256_or_si256(isLetter, isLower);
+            }
+
+            if (_mm256_movemask_epi8(_mm256_or_si256(isLetter, isDigit)) != -1) {
+                return;
+            }
+
+            auto values = _mm256_blendv_epi8(_mm256_add_epi8(digits, _mm256_set1_epi8(26)), letters, isLetter);
+
+            // 8 values of 5 bits to 40 bits of 64 bit lane
+            auto pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0120));
+            auto halves = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00010400));
+            auto groups = _mm256_or_si256(_mm256_and_si256(_mm256_slli_epi64(halves, 20), _mm256_set1_epi64x(0xFFFFFFFFFFLL)),
+                                          _mm256_srli_epi64(halves, 32));
+            auto bytes = _mm256_shuffle_epi8(groups, pack);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written), _mm256_castsi256_si128(bytes));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written + 10), _mm256_extracti128_si256(bytes, 1));
+
+            position += 32;
+            written += 20;
+        }
+    }
+
+private:
+    bool m_lenient;
+};
+
+/**
+ * @brief Function for division of 32 bit lanes by 85
+ * (multiplication by 2^38 / 85, it's exact for any
+ * 32 bit value).
+ */
+inline __m256i z85_divide_avx2(__m256i value) {
+    auto magic = _mm256_set1_epi32(int(0xC0C0C0C1U));
+    auto even = _mm256_srli_epi64(_mm256_mul_epu32(value, magic), 38);
+    auto odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(value, 32), magic), 6);
+
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+/**
+ * @brief Function for translating Z85 digits to
+ * symbols: 3 ranges of digits and letters by offset,
+ * punctuation by lookup.
+ */
+inline __m256i z85_symbols_avx2(__m256i digits) {
+    auto punctuation = _mm256_setr_epi8('.', '-', ':', '+', '=', '^', '!', '/', '*', '?', '&', '<', '>', '(', ')', '[',
+                                        '.', '-', ':', '+', '=', '^', '!', '/', '*', '?', '&', '<', '>', '(', ')', '[');
+    auto brackets = _mm256_setr_epi8(']', '{', '}', '@', '%', '$', '#', 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                     ']', '{', '}', '@', '%', '$', '#', 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+    // 0 - 9, a - z, A - Z
+    auto offsets = _mm256_add_epi8(_mm256_set1_epi8('0'), _mm256_and_si256(_mm256_cmpgt_epi8(digits, _mm256_set1_epi8(9)),
+                                                                           _mm256_set1_epi8('a' - 10 - '0')));
+
+    offsets = _mm256_add_epi8(offsets, _mm256_and_si256(_mm256_cmpgt_epi8(digits, _mm256_set1_epi8(35)), _mm256_set1_epi8('A' - 36 - 'a' + 10)));
+
+    auto symbols = _mm256_add_epi8(digits, offsets);
+
+    symbols = _mm256_blendv_epi8(symbols, _mm256_shuffle_epi8(punctuation, _mm256_sub_epi8(digits, _mm256_set1_epi8(62))),
+                                 _mm256_cmpgt_epi8(digits, _mm256_set1_epi8(61)));
+
+    return _mm256_blendv_epi8(symbols, _mm256_shuffle_epi8(brackets, _mm256_sub_epi8(digits, _mm256_set1_epi8(78))),
+                              _mm256_cmpgt_epi8(digits, _mm256_set1_epi8(77)));
+}
+
+/**
+ * @brief Function for encoding 32 bytes to 40 Z85
+ * symbols per iteration. Digits are extracted with
+ * division by multiplication, first 4 digits of group
+ * are kept in one 32 bit lane and the last one in other
+ * vector, lanes are interleaved to 5 symbol groups by
+ * shuffles.
+ */
+inline void z85_encode_avx2(const uint8_t* data, std::size_t& position, std::size_t size, char* output, std::size_t& written) {
+    auto swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    auto eightyFive = _mm256_set1_epi32(85);
+
+    // Bytes 0 - 15 and 16 - 19 of 4 groups
+    auto headFirst = _mm_setr_epi8(0, 1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12);
+    auto headLast = _mm_setr_epi8(-1, -1, -1, -1, 0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1);
+    auto tailFirst = _mm_setr_epi8(13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    auto tailLast = _mm_setr_epi8(-1, -1, -1, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+
+    for (; position + 32 <= size; position += 32, written += 40) {
+        auto value = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position)), swap);
+
+        // Digits from the last one
+        __m256i digits[5];
+
+        for (std::size_t i = 4; i > 0; --i) {
+            auto quotient = z85_divide_avx2(value);
+
+            digits[i] = _mm256_sub_epi32(value, _mm256_mullo_epi32(quotient, eightyFive));
+            value = quotient;
+        }
+
+        digits[0] = value;
+
+        auto first = _mm256_or_si256(_mm256_or_si256(digits[0], _mm256_slli_epi32(digits[1], 8)),
+                                     _mm256_or_si256(_mm256_slli_epi32(digits[2], 16), _mm256_slli_epi32(digits[3], 24)));
+
+        first = z85_symbols_avx2(first);
+
+        auto last = z85_symbols_avx2(digits[4]);
+
+        for (int lane = 0; lane < 2; ++lane) {
+            auto firstLane = lane == 0 ? _mm256_castsi256_si128(first) : _mm256_extracti128_si256(first, 1);
+            auto lastLane = lane == 0 ? _mm256_castsi256_si128(last) : _mm256_extracti128_si256(last, 1);
+
+            auto head = _mm_or_si128(_mm_shuffle_epi8(firstLane, headFirst), _mm_shuffle_epi8(lastLane, headLast));
+            auto tail = uint32_t(_mm_cvtsi128_si32(_mm_or_si128(_mm_shuffle_epi8(firstLane, tailFirst), _mm_shuffle_epi8(lastLane, tailLast))));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + written + 20 * lane), head);
+            std::memcpy(output + written + 20 * lane + 16, &tail, sizeof(tail));
+        }
+    }
+}
+
+/**
+ * @brief Functor for decoding 40 Z85 symbols to 32
+ * bytes per iteration. Symbols are translated to digits
+ * by lookup of their low nibble in table of their row
+ * (symbols are in rows 2 - 7). Every lane loads 20
+ * symbols of 4 groups in 2 overlapping parts, first 4
+ * digits of group are joined with multiply-adds. Block
+ * with other symbols or value, that doesn't fit 32 bits,
+ * is left for scalar decoding.
+ */
+class z85_decode_avx2 {
+public:
+    z85_decode_avx2() {
+        for (unsigned row = 0; row < 6; ++row) {
+            uint8_t codes[16];
+
+            for (unsigned nibble = 0; nibble < 16; ++nibble) {
+                codes[nibble] = z85_codes[(row + 2) << 4 | nibble];
+            }
+
+            m_rows[row] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(codes)));
+        }
+    }
+
+    void operator()(const uint8_t* text, std::size_t& position, std::size_t end, uint8_t* output, std::size_t& written, std::size_t capacity) const {
+        // First 4 digits from offsets 0 - 15 and 4 - 19, last one from 4 - 19
+        auto firstHead = _mm256_setr_epi8(0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13, -1, -1, -1, -1,
+                                          0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13, -1, -1, -1, -1);
+        auto firstTail = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, 12, 13, 14,
+                                          -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 11, 12, 13, 14);
+        auto lastTail = _mm256_setr_epi8(0, -1, -1, -1, 5, -1, -1, -1, 10, -1, -1, -1, 15, -1, -1, -1,
+                                         0, -1, -1, -1, 5, -1, -1, -1, 10, -1, -1, -1, 15, -1, -1, -1);
+        auto swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+        // 85^4 * 85 + 0 is the largest value
+        auto largest = _mm256_set1_epi32(50529027);
+
+        while (position + 40 <= end && capacity - written >= 32) {
+            auto head = digits(_mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + position))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + position + 20)), 1));
+            auto tail = digits(_mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + position + 4))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + position + 24)), 1));
+
+            // Invalid symbols have high bit set
+            if (_mm256_movemask_epi8(_mm256_or_si256(head, tail)) != 0) {
+                return;
+            }
+
+            auto first = _mm256_or_si256(_mm256_shuffle_epi8(head, firstHead), _mm256_shuffle_epi8(tail, firstTail));
+            auto last = _mm256_shuffle_epi8(tail, lastTail);
+
+            auto pairs = _mm256_maddubs_epi16(first, _mm256_set1_epi16(0x0155));
+            auto four = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011C39));
+
+            auto overflow = _mm256_or_si256(_mm256_cmpgt_epi32(four, largest),
+                                            _mm256_and_si256(_mm256_cmpeq_epi32(four, largest), _mm256_cmpgt_epi32(last, _mm256_setzero_si256())));
+
+            if (!_mm256_testz_si256(overflow, overflow)) {
+                return;
+            }
+
+            auto values = _mm256_add_epi32(_mm256_mullo_epi32(four, _mm256_set1_epi32(85)), last);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + written), _mm256_shuffle_epi8(values, swap));
+
+            position += 40;
+            written += 32;
+        }
+    }
+
+private:
+    __m256i digits(__m256i symbols) const {
+        auto nibbles = _mm256_and_si256(symbols, _mm256_set1_epi8(0x0F));
+        auto rows = _mm256_and_si256(_mm256_srli_epi16(symbols, 4), _mm256_set1_epi8(0x0F));
+        auto result = _mm256_set1_epi8(char(code_invalid));
+
+        for (int row = 0; row < 6; ++row) {
+            result = _mm256_blendv_epi8(result, _mm256_shuffle_epi8(m_rows[row], nibbles), _mm256_cmpeq_epi8(rows, _mm256_set1_epi8(char(row + 2))));
+        }
+
+        return result;
+    }
+
+    __m256i m_rows[6];
+};
+#endif
+
+/**
+ * @brief Function for decoding of up to 5 Z85 symbols,
+ * missing ones are treated as the highest digit.
+ * @return Is group valid (value fits 32 bits).
+ */
+inline bool z85_group(const uint8_t* codes, std::size_t count, uint32_t& value) {
+    uint64_t result = 0;
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        result = result * 85 + (i < count ? codes[i] : 84);
+    }
+
+    value = uint32_t(result);
+
+    return result <= 0xFFFFFFFFULL;
+}
+
+/**
+ * @brief Function for checking, that incomplete
+ * group is the one, that encoder writes for it's bytes.
+ */
+inline bool z85_canonical(const uint8_t* codes, std::size_t count, uint32_t value) {
+    uint32_t digits[5];
+
+    // Bytes, that are not decoded, are zero for encoder
+    value &= ~uint32_t(0) << (8 * (5 - count));
+
+    for (std::size_t i = 5; i-- > 0;) {
+        digits[i] = value % 85;
+        value /= 85;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (digits[i] != codes[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for getting exact size of Base64 text.
+ * @param size Size of data.
+ * @param padding Is text padded with `=` to multiple of 4.
+ */
+constexpr std::size_t base64_encoded_size(std::size_t size, bool padding = true) {
+    return padding ? (size + 2) / 3 * 4 : size / 3 * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+}
+
+/**
+ * @brief Function for getting size of data, decoded
+ * from Base64 text. It's exact for text without
+ * whitespace, otherwise it's upper bound.
+ */
+inline std::size_t base64_decoded_size(std::string_view text) {
+    std::size_t pads;
+
+    return detail::strip_padding(reinterpret_cast<const uint8_t*>(text.data()), text.size(), true, pads) * 6 / 8;
+}
+
+/**
+ * @brief Function for Base64 encoding (RFC 4648).
+ * Vectorized with AVX2.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param output Output buffer of `base64_encoded_size` bytes.
+ * @param alphabet Alphabet.
+ * @param padding Is text padded with `=`.
+ * @return Amount of written symbols.
+ */
+inline std::size_t base64_encode(const void* data,
+                                 std::size_t size,
+                                 char* output,
+                                 base64_alphabet alphabet = base64_alphabet::standard,
+                                 bool padding = true) {
+    auto input = static_cast<const uint8_t*>(data);
+    auto url = alphabet == base64_alphabet::url;
+
+    std::size_t position = 0;
+    std::size_t written = 0;
+
+#if defined(BA_SIMD_AVX2)
+    detail::base64_encode_avx2(input, position, size, output, written, url);
+#endif
+
+    return written + detail::encode_radix<6>(input + position, size - position, output + written,
+                                             url ? detail::base64_url_symbols : detail::base64_standard_symbols, padding);
+}
+
+/**
+ * @brief Function for Base64 encoding of byte array,
+ * reader or view to string (it's allocated once).
+ */
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, std::string>::type base64_encode(
+    const Sequence& sequence, base64_alphabet alphabet = base64_alphabet::standard, bool padding = true) {
+    std::string result(base64_encoded_size(detail::byte_size(sequence), padding), '\0');
+
+    base64_encode(detail::byte_data(sequence), detail::byte_size(sequence), result.data(), alphabet, padding);
+
+    return result;
+}
+
+/**
+ * @brief Function for Base64 decoding. Vectorized
+ * with AVX2, blocks with whitespace or invalid symbols
+ * are decoded by scalar code.
+ * @param text Text.
+ * @param output Output buffer.
+ * @param outputSize Size of output buffer on input
+ * (`base64_decoded_size` is enough), decoded size on output.
+ * @param alphabet Alphabet.
+ * @param mode Decoding mode.
+ * @return Is text valid and fits into output buffer.
+ */
+inline bool base64_decode(std::string_view text,
+                          void* output,
+                          std::size_t& outputSize,
+                          base64_alphabet alphabet = base64_alphabet::standard,
+                          decode_mode mode = decode_mode::strict) {
+    auto url = alphabet == base64_alphabet::url;
+    auto input = reinterpret_cast<const uint8_t*>(text.data());
+    auto& codes = url ? detail::base64_url_codes : detail::base64_standard_codes;
+
+#if defined(BA_SIMD_AVX2)
+    detail::base64_decode_avx2 bulk(url);
+#else
+    detail::no_bulk bulk;
+#endif
+
+    return detail::decode_radix<6>(input, text.size(), static_cast<uint8_t*>(output), outputSize, codes, mode, bulk);
+}
+
+/**
+ * @brief Function for Base64 decoding to the end
+ * of byte array. Target is resized once.
+ * @return Is text valid (target is not changed otherwise).
+ */
+template <typename ValueType, typename Allocator>
+bool base64_decode(std::string_view text,
+                   bytearray_processor<ValueType, Allocator>& target,
+                   base64_alphabet alphabet = base64_alphabet::standard,
+                   decode_mode mode = decode_mode::strict) {
+    auto& container = target.container();
+    auto offset = container.size();
+    auto size = base64_decoded_size(text);
+
+    container.resize(offset + size);
+
+    if (!base64_decode(text, container.data() + offset, size, alphabet, mode)) {
+        container.resize(offset);
+        return false;
+    }
+
+    container.resize(offset + size);
+
+    return true;
+}
+
+/**
+ * @brief Function for getting exact size of Base32 text.
+ * @param padding Is text padded with `=` to multiple of 8.
+ */
+constexpr std::size_t base32_encoded_size(std::size_t size, bool padding = true) {
+    return padding ? (size + 4) / 5 * 8 : (size * 8 + 4) / 5;
+}
+
+/**
+ * @brief Function for getting size of data, decoded
+ * from Base32 text. It's exact for text without
+ * whitespace, otherwise it's upper bound.
+ */
+inline std::size_t base32_decoded_size(std::string_view text) {
+    std::size_t pads;
+
+    return detail::strip_padding(reinterpret_cast<const uint8_t*>(text.data()), text.size(), true, pads) * 5 / 8;
+}
+
+/**
+ * @brief Function for Base32 encoding (RFC 4648).
+ * Vectorized with AVX2.
+ * @return Amount of written symbols.
+ */
+inline std::size_t base32_encode(const void* data, std::size_t size, char* output, bool padding = true) {
+    auto input = static_cast<const uint8_t*>(data);
+
+    std::size_t position = 0;
+    std::size_t written = 0;
+
+#if defined(BA_SIMD_AVX2)
+    detail::base32_encode_avx2(input, position, size, output, written);
+#endif
+
+    return written + detail::encode_radix<5>(input + position, size - position, output + written, detail::base32_symbols, padding);
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, std::string>::type base32_encode(const Sequence& sequence,
+                                                                                                  bool padding = true) {
+    std::string result(base32_encoded_size(detail::byte_size(sequence), padding), '\0');
+
+    base32_encode(detail::byte_data(sequence), detail::byte_size(sequence), result.data(), padding);
+
+    return result;
+}
+
+/**
+ * @brief Function for Base32 decoding. Lenient
+ * mode also accepts lower case symbols. Vectorized
+ * with AVX2, blocks with whitespace or invalid symbols
+ * are decoded by scalar code.
+ * @param outputSize Size of output buffer on input,
+ * decoded size on output.
+ * @return Is text valid and fits into output buffer.
+ */
+inline bool base32_decode(std::string_view text, void* output, std::size_t& outputSize, decode_mode mode = decode_mode::strict) {
+    auto& codes = mode == decode_mode::lenient ? detail::base32_lenient_codes : detail::base32_codes;
+
+#if defined(BA_SIMD_AVX2)
+    detail::base32_decode_avx2 bulk(mode == decode_mode::lenient);
+#else
+    detail::no_bulk bulk;
+#endif
+
+    return detail::decode_radix<5>(reinterpret_cast<const uint8_t*>(text.data()), text.size(), static_cast<uint8_t*>(output),
+                                   outputSize, codes, mode, bulk);
+}
+
+/**
+ * @brief Function for Base32 decoding to the end
+ * of byte array.
+ * @return Is text valid (target is not changed otherwise).
+ */
+template <typename ValueType, typename Allocator>
+bool base32_decode(std::string_view text, bytearray_processor<ValueType, Allocator>& target, decode_mode mode = decode_mode::strict) {
+    auto& container = target.container();
+    auto offset = container.size();
+    auto size = base32_decoded_size(text);
+
+    container.resize(offset + size);
+
+    if (!base32_decode(text, container.data() + offset, size, mode)) {
+        container.resize(offset);
+        return false;
+    }
+
+    container.resize(offset + size);
+
+    return true;
+}
+
+/**
+ * @brief Function for getting exact size of Z85 text.
+ * Data of any size is accepted: last 1 - 3 bytes
+ * are encoded with 2 - 4 symbols.
+ */
+constexpr std::size_t z85_encoded_size(std::size_t size) {
+    return size / 4 * 5 + (size % 4 == 0 ? 0 : size % 4 + 1);
+}
+
+/**
+ * @brief Function for getting size of data, decoded
+ * from Z85 text. It's exact for text without
+ * whitespace, otherwise it's upper bound.
+ */
+inline std::size_t z85_decoded_size(std::string_view text) {
+    return text.size() / 5 * 4 + (text.size() % 5 == 0 ? 0 : text.size() % 5 - 1);
+}
+
+/**
+ * @brief Function for Z85 encoding (ZeroMQ RFC 32),
+ * 4 bytes as big endian number are written as 5 base 85
+ * digits. Incomplete last group is encoded as the
+ * first symbols of group, that is filled with zeros.
+ * Vectorized with AVX2.
+ * @return Amount of written symbols.
+ */
+inline std::size_t z85_encode(const void* data, std::size_t size, char* output) {
+    auto input = static_cast<const uint8_t*>(data);
+
+    std::size_t position = 0;
+    std::size_t written = 0;
+
+#if defined(BA_SIMD_AVX2)
+    detail::z85_encode_avx2(input, position, size, output, written);
+#endif
+
+    for (; position < size; position += 4) {
+        auto count = std::min<std::size_t>(4, size - position);
+        uint32_t value = 0;
+
+        for (std::size_t i = 0; i < 4; ++i) {
+            value = value << 8 | (i < count ? input[position + i] : 0);
+        }
+
+        char digits[5];
+
+        for (std::size_t i = 5; i-- > 0;) {
+            digits[i] = detail::z85_symbols[value % 85];
+            value /= 85;
+        }
+
+        for (std::size_t i = 0; i < count + 1; ++i) {
+            output[written++] = digits[i];
+        }
+    }
+
+    return written;
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, std::string>::type z85_encode(const Sequence& sequence) {
+    std::string result(z85_encoded_size(detail::byte_size(sequence)), '\0');
+
+    z85_encode(detail::byte_data(sequence), detail::byte_size(sequence), result.data());
+
+    return result;
+}
+
+/**
+ * @brief Function for Z85 decoding. Vectorized with
+ * AVX2, blocks with whitespace or invalid symbols are
+ * decoded by scalar code.
+ * @param outputSize Size of output buffer on input,
+ * decoded size on output.
+ * @return Is text valid and fits into output buffer.
+ */
+inline bool z85_decode(std::string_view text, void* output, std::size_t& outputSize, decode_mode mode = decode_mode::strict) {
+    auto out = static_cast<uint8_t*>(output);
+    auto lenient = mode == decode_mode::lenient;
+
+    uint8_t codes[5];
+    std::size_t count = 0;
+    std::size_t written = 0;
+
+    auto flush = [&]() {
+        uint32_t value;
+
+        if (!detail::z85_group(codes, count, value) || outputSize - written < count - 1) {
+            return false;
+        }
+
+        if (!lenient && count < 5 && !detail::z85_canonical(codes, count, value)) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i + 1 < count; ++i) {
+            out[written++] = uint8_t(value >> (24 - 8 * i));
+        }
+
+        count = 0;
+
+        return true;
+    };
+
+    auto input = reinterpret_cast<const uint8_t*>(text.data());
+
+#if defined(BA_SIMD_AVX2)
+    detail::z85_decode_avx2 bulk;
+#endif
+
+    for (std::size_t position = 0; position < text.size();) {
+#if defined(BA_SIMD_AVX2)
+        if (count == 0) {
+            bulk(input, position, text.size(), out, written, outputSize);
+        }
+#endif
+
+        // Whole groups without whitespace
+        for (; count == 0 && position + 5 <= text.size() && outputSize - written >= 4; position += 5) {
+            uint64_t value = 0;
+            unsigned check = 0;
+
+            for (std::size_t i = 0; i < 5; ++i) {
+                auto code = detail::z85_codes[input[position + i]];
+
+                check |= code;
+                value = value * 85 + code;
+            }
+
+            if (check >= 128 || value > 0xFFFFFFFFULL) {
+                break;
+            }
+
+            for (std::size_t i = 0; i < 4; ++i) {
+                out[written++] = uint8_t(value >> (24 - 8 * i));
+            }
+        }
+
+        if (position == text.size()) {
+            break;
+        }
+
+        auto code = detail::z85_codes[input[position++]];
+
+        if (code == detail::code_invalid || (code == detail::code_space && !lenient)) {
+            return false;
+        }
+
+        if (code == detail::code_space) {
+            continue;
+        }
+
+        codes[count++] = code;
+
+        if (count == 5 && !flush()) {
+            return false;
+        }
+    }
+
+    // Single symbol can't hold a byte
+    if (count == 1 || (count != 0 && !flush())) {
+        return false;
+    }
+
+    outputSize = written;
+
+    return true;
+}
+
+/**
+ * @brief Function for Z85 decoding to the end of
+ * byte array.
+ * @return Is text valid (target is not changed otherwise).
+ */
+template <typename ValueType, typename Allocator>
+bool z85_decode(std::string_view text, bytearray_processor<ValueType, Allocator>& target, decode_mode mode = decode_mode::strict) {
+    auto& container = target.container();
+    auto offset = container.size();
+    auto size = z85_decoded_size(text);
+
+    container.resize(offset + size);
+
+    if (!z85_decode(text, container.data() + offset, size, mode)) {
+        container.resize(offset);
+        return false;
+    }
+
+    container.resize(offset + size);
+
+    return true;
+}
+
+}  // namespace ba
@@ -0,0 +1,335 @@
+#pragma once
+
+// ba
+#include <ba/compare.hpp>
+#include <ba/endianness.hpp>
+
+// C++ STL
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ba {
+
+/**
+ * @brief Order of bits inside of byte.
+ * `msb_first` - first bit is the highest bit of first
+ * byte (network protocols, most codecs).
+ * `lsb_first` - first bit is the lowest bit of first
+ * byte (deflate, some radio formats).
+ */
+enum class bit_order { msb_first, lsb_first };
+
+namespace detail {
+
+/**
+ * @brief Function for getting mask of lowest bits.
+ */
+inline uint64_t low_bits_mask(unsigned count) {
+    return count >= 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+}
+
+/**
+ * @brief Function for loading 8 bytes with defined
+ * byte order.
+ */
+inline uint64_t load_word(const uint8_t* data, bit_order order) {
+    uint64_t word;
+
+    std::memcpy(&word, data, sizeof(word));
+
+    auto native = detail::system_endianness() == endianness::big ? bit_order::msb_first : bit_order::lsb_first;
+
+    if (order != native) {
+        word = detail::byte_swap(word);
+    }
+
+    return word;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Class, that implements reading of values
+ * with arbitrary bit width. Bits are taken from 64 bit
+ * accumulator, that's refilled with single 8 byte load
+ * (byte by byte only at the end of data).
+ */
+class bit_reader {
+public:
+    /**
+     * @brief Constructor.
+     * @param data Pointer to data.
+     * @param size Size in bytes.
+     * @param order Bit order.
+     */
+    bit_reader(const void* data, std::size_t size, bit_order order = bit_order::msb_first)
+        : m_begin(static_cast<const uint8_t*>(data))
+        , m_current(m_begin)
+        , m_end(m_begin + size)
+        , m_accumulator(0)
+        , m_count(0)
+        , m_order(order) {}
+
+    /**
+     * @brief Constructor for byte array, it's
+     * reader, processor or view.
+     */
+    template <typename Sequence, typename = typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type>
+    explicit bit_reader(const Sequence& sequence, bit_order order = bit_order::msb_first)
+        : bit_reader(detail::byte_data(sequence), detail::byte_size(sequence), order) {}
+
+    /**
+     * @brief Method for reading value.
+     * @param count Amount of bits (0 - 64). Can't be
+     * bigger, than `bits_left()`.
+     * @return Value in lowest bits.
+     */
+    uint64_t read_bits(unsigned count) {
+        assert(count <= 64 && "Can't read more, than 64 bits.");
+        assert(count <= bits_left() && "Can't read after end of data.");
+
+        if (count <= 56) {
+            return take(count);
+        }
+
+        auto first = take(32);
+        auto second = take(count - 32);
+
+        return m_order == bit_order::msb_first ? (first << (count - 32)) | second : first | (second << 32);
+    }
+
+    /**
+     * @brief Method for reading value without
+     * moving position.
+     * @param count Amount of bits (0 - 56).
+     */
+    uint64_t peek_bits(unsigned count) {
+        assert(count <= 56 && "Can't peek more, than 56 bits.");
+        assert(count <= bits_left() && "Can't read after end of data.");
+
+        if (m_count < count) {
+            refill();
+        }
+
+        return m_order == bit_order::msb_first ? (count == 0 ? 0 : m_accumulator >> (64 - count))
+                                               : m_accumulator & detail::low_bits_mask(count);
+    }
+
+    /**
+     * @brief Method for reading single bit.
+     */
+    bool read_bit() { return take(1) != 0; }
+
+    /**
+     * @brief Method for skipping bits.
+     * @param count Amount of bits. Can't be bigger, than `bits_left()`.
+     */
+    void skip_bits(std::size_t count) {
+        assert(count <= bits_left() && "Can't skip after end of data.");
+
+        if (count <= m_count) {
+            drop(unsigned(count));
+            return;
+        }
+
+        count -= m_count;
+
+        m_current += count / 8;
+        m_accumulator = 0;
+        m_count = 0;
+
+        take(unsigned(count % 8));
+    }
+
+    /**
+     * @brief Method for skipping bits till
+     * the beginning of next byte.
+     */
+    void align_to_byte() { drop(m_count % 8); }
+
+    /**
+     * @brief Method for checking is position at
+     * the beginning of byte.
+     */
+    bool is_aligned() const { return m_count % 8 == 0; }
+
+    /**
+     * @brief Method for getting amount of read bits.
+     */
+    std::size_t position() const { return std::size_t(m_current - m_begin) * 8 - m_count; }
+
+    /**
+     * @brief Method for getting amount of not read bits.
+     */
+    std::size_t bits_left() const { return std::size_t(m_end - m_begin) * 8 - position(); }
+
+private:
+    /**
+     * @brief Method for refilling accumulator up to
+     * at least 56 bits (if data is available). Bits after
+     * `m_count` may contain next bytes, that are added
+     * to the same places on next refill.
+     */
+    void refill() {
+        if (m_end - m_current >= 8) {
+            auto word = detail::load_word(m_current, m_order);
+
+            m_accumulator |= m_order == bit_order::msb_first ? word >> m_count : word << m_count;
+            m_current += (63 - m_count) >> 3;
+            m_count |= 56;
+            return;
+        }
+
+        while (m_count <= 56 && m_current < m_end) {
+            uint64_t byte = *m_current++;
+
+            m_accumulator |= m_order == bit_order::msb_first ? byte << (56 - m_count) : byte << m_count;
+            m_count += 8;
+        }
+    }
+
+    void drop(unsigned count) {
+        if (count == 0) {
+            return;
+        }
+
+        if (m_order == bit_order::msb_first) {
+            m_accumulator <<= count;
+        } else {
+            m_accumulator >>= count;
+        }
+
+        m_count -= count;
+    }
+
+    uint64_t take(unsigned count) {
+        if (m_count < count) {
+            refill();
+        }
+
+        uint64_t value = m_order == bit_order::msb_first ? (count == 0 ? 0 : m_accumulator >> (64 - count))
+                                                         : m_accumulator & detail::low_bits_mask(count);
+
+        drop(count);
+
+        return value;
+    }
+
+    const uint8_t* m_begin;
+    const uint8_t* m_current;
+    const uint8_t* m_end;
+    uint64_t m_accumulator;
+    unsigned m_count;
+    bit_order m_order;
+};
+
+/**
+ * @brief Class, that implements appending of values
+ * with arbitrary bit width to byte array or view.
+ * Bits are collected in 64 bit accumulator, that's
+ * written with single `push_back<uint64_t>`. Last
+ * incomplete bytes are written by `flush`.
+ * @tparam Target Byte array, processor or view.
+ */
+template <typename Target>
+class bit_writer {
+public:
+    /**
+     * @brief Constructor.
+     * @param target Byte array, processor or view.
+     * @param order Bit order.
+     */
+    explicit bit_writer(Target& target, bit_order order = bit_order::msb_first)
+        : m_target(target)
+        , m_accumulator(0)
+        , m_count(0)
+        , m_position(0)
+        , m_order(order) {}
+
+    /**
+     * @brief Method for writing value.
+     * @param value Value. Bits above `count` are ignored.
+     * @param count Amount of bits (0 - 64).
+     */
+    void write_bits(uint64_t value, unsigned count) {
+        assert(count <= 64 && "Can't write more, than 64 bits.");
+
+        value &= detail::low_bits_mask(count);
+        m_position += count;
+
+        auto space = 64 - m_count;
+
+        if (count < space) {
+            if (m_order == bit_order::msb_first) {
+                m_accumulator = (m_accumulator << count) | value;
+            } else {
+                m_accumulator |= value << m_count;
+            }
+
+            m_count += count;
+            return;
+        }
+
+        // Accumulator is full
+        auto rest = count - space;
+
+        if (m_order == bit_order::msb_first) {
+            m_accumulator = (space == 64 ? 0 : m_accumulator << space) | (value >> rest);
+            m_target.template push_back<uint64_t>(m_accumulator, endianness::big);
+        } else {
+            m_accumulator |= value << m_count;
+            m_target.template push_back<uint64_t>(m_accumulator, endianness::little);
+        }
+
+        m_accumulator = rest == 0 ? 0 : (m_order == bit_order::msb_first ? value & detail::low_bits_mask(rest) : value >> space);
+        m_count = rest;
+    }
+
+    /**
+     * @brief Method for writing single bit.
+     */
+    void write_bit(bool value) { write_bits(value ? 1 : 0, 1); }
+
+    /**
+     * @brief Method for writing zero bits till
+     * the beginning of next byte.
+     */
+    void align_to_byte() { write_bits(0, (8 - m_count % 8) % 8); }
+
+    /**
+     * @brief Method for writing collected bits.
+     * Last byte is padded with zero bits. Has to be
+     * called after last write.
+     */
+    void flush() {
+        align_to_byte();
+
+        auto bytes = m_count / 8;
+
+        for (unsigned i = 0; i < bytes; ++i) {
+            auto shift = m_order == bit_order::msb_first ? 8 * (bytes - 1 - i) : 8 * i;
+
+            m_target.template push_back<uint8_t>(uint8_t(m_accumulator >> shift));
+        }
+
+        m_accumulator = 0;
+        m_count = 0;
+    }
+
+    /**
+     * @brief Method for getting amount of written bits.
+     */
+    std::size_t position() const { return m_position; }
+
+private:
+    Target& m_target;
+    uint64_t m_accumulator;
+    unsigned m_count;
+    std::size_t m_position;
+    bit_order m_order;
+};
+
+}  // namespace ba
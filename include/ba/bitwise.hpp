@@ -0,0 +1,138 @@
+#pragma once
+
+// ba
+#include <ba/bytearray.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/bitwise.hpp>
+
+// C++ STL
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ba {
+
+/**
+ * @brief Function for XOR of 2 memory blocks. Output
+ * may be equal to one of inputs.
+ */
+inline void xor_bytes(void* output, const void* lhs, const void* rhs, std::size_t size) {
+    detail::bitwise<detail::bitwise_xor>(static_cast<uint8_t*>(output), static_cast<const uint8_t*>(lhs),
+                                         static_cast<const uint8_t*>(rhs), size);
+}
+
+/**
+ * @brief Function for AND of 2 memory blocks.
+ */
+inline void and_bytes(void* output, const void* lhs, const void* rhs, std::size_t size) {
+    detail::bitwise<detail::bitwise_and>(static_cast<uint8_t*>(output), static_cast<const uint8_t*>(lhs),
+                                         static_cast<const uint8_t*>(rhs), size);
+}
+
+/**
+ * @brief Function for OR of 2 memory blocks.
+ */
+inline void or_bytes(void* output, const void* lhs, const void* rhs, std::size_t size) {
+    detail::bitwise<detail::bitwise_or>(static_cast<uint8_t*>(output), static_cast<const uint8_t*>(lhs),
+                                        static_cast<const uint8_t*>(rhs), size);
+}
+
+/**
+ * @brief Function for inverting bits of memory block.
+ */
+inline void invert_bytes(void* output, const void* input, std::size_t size) {
+    detail::bitwise_not(static_cast<uint8_t*>(output), static_cast<const uint8_t*>(input), size);
+}
+
+/**
+ * @brief Function for XOR of memory block with
+ * repeating key.
+ * @param keyOffset Index of key byte for first byte.
+ * @return Key offset for next byte.
+ */
+inline std::size_t xor_mask_bytes(void* output,
+                                  const void* input,
+                                  std::size_t size,
+                                  const void* key,
+                                  std::size_t keySize,
+                                  std::size_t keyOffset = 0) {
+    assert(keySize != 0 && "Key can't be empty.");
+
+    return detail::xor_mask(static_cast<uint8_t*>(output), static_cast<const uint8_t*>(input), size,
+                            static_cast<const uint8_t*>(key), keySize, keyOffset);
+}
+
+/**
+ * @brief Function for XOR of byte sequences with
+ * equal size.
+ * @return New byte array.
+ */
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bytearray<> bitwise_xor(const Lhs& lhs, const Rhs& rhs) {
+    assert(detail::byte_size(lhs) == detail::byte_size(rhs) && "Sizes have to be equal.");
+
+    bytearray<> result(detail::byte_size(lhs));
+
+    xor_bytes(result.data(), detail::byte_data(lhs), detail::byte_data(rhs), result.size());
+
+    return result;
+}
+
+/**
+ * @brief Function for AND of byte sequences with
+ * equal size.
+ */
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bytearray<> bitwise_and(const Lhs& lhs, const Rhs& rhs) {
+    assert(detail::byte_size(lhs) == detail::byte_size(rhs) && "Sizes have to be equal.");
+
+    bytearray<> result(detail::byte_size(lhs));
+
+    and_bytes(result.data(), detail::byte_data(lhs), detail::byte_data(rhs), result.size());
+
+    return result;
+}
+
+/**
+ * @brief Function for OR of byte sequences with
+ * equal size.
+ */
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bytearray<> bitwise_or(const Lhs& lhs, const Rhs& rhs) {
+    assert(detail::byte_size(lhs) == detail::byte_size(rhs) && "Sizes have to be equal.");
+
+    bytearray<> result(detail::byte_size(lhs));
+
+    or_bytes(result.data(), detail::byte_data(lhs), detail::byte_data(rhs), result.size());
+
+    return result;
+}
+
+/**
+ * @brief Function for inverting bits of byte sequence.
+ */
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bytearray<>>::type bitwise_not(const Sequence& sequence) {
+    bytearray<> result(detail::byte_size(sequence));
+
+    invert_bytes(result.data(), detail::byte_data(sequence), result.size());
+
+    return result;
+}
+
+/**
+ * @brief Function for XOR of byte sequence with
+ * repeating key.
+ * @return New byte array.
+ */
+template <typename Sequence, typename Key, typename = detail::enable_if_byte_sequences<Sequence, Key>>
+bytearray<> xor_masked(const Sequence& sequence, const Key& key, std::size_t keyOffset = 0) {
+    bytearray<> result(detail::byte_size(sequence));
+
+    xor_mask_bytes(result.data(), detail::byte_data(sequence), result.size(), detail::byte_data(key), detail::byte_size(key), keyOffset);
+
+    return result;
+}
+
+}  // namespace ba
@@ -0,0 +1,498 @@
+#pragma once
+
+// ba
+#include <ba/bytearray.hpp>
+#include <ba/compare.hpp>
+#include <ba/endianness.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <type_traits>
+
+namespace ba {
+
+/**
+ * @brief Class, that describes byte sequence, stored
+ * as chain of refcounted segments. Every segment may
+ * have free space before data (headroom) and after
+ * data (tailroom), so headers can be prepended and
+ * trailers appended without moving payload.
+ *
+ * Prepend and append are O(1): data is written into
+ * headroom/tailroom of edge segment if it's not shared
+ * with other chain, otherwise new segment is allocated.
+ * Split, trim and clone only adjust segment bounds and
+ * reference counts, data is not copied. `coalesce` makes
+ * data contiguous when it's required.
+ */
+class buffer_chain {
+    struct segment {
+        std::shared_ptr<std::byte[]> storage;
+        std::size_t capacity;
+        std::size_t begin;
+        std::size_t end;
+
+        std::byte* data() const { return storage.get() + begin; }
+
+        std::size_t size() const { return end - begin; }
+
+        bool unique() const { return storage.use_count() == 1; }
+    };
+
+public:
+    using size_type = std::size_t;
+
+    class cursor;
+
+    /**
+     * @brief Constructor.
+     * @param segmentCapacity Minimal capacity of allocated segments.
+     * @param headroom Space, that's reserved before data of first
+     * segment, when it's created by append.
+     */
+    explicit buffer_chain(size_type segmentCapacity = 4096, size_type headroom = 64)
+        : m_segmentCapacity(segmentCapacity)
+        , m_headroom(headroom)
+        , m_size(0) {}
+
+    /**
+     * @brief Method for getting size of data in bytes.
+     */
+    size_type size() const { return m_size; }
+
+    /**
+     * @brief Method for checking is chain empty.
+     */
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief Method for getting number of segments.
+     */
+    size_type segments() const { return m_segments.size(); }
+
+    /**
+     * @brief Method for getting free space before data.
+     * Space of shared segment is not available.
+     */
+    size_type headroom() const { return m_segments.empty() || !m_segments.front().unique() ? 0 : m_segments.front().begin; }
+
+    /**
+     * @brief Method for getting free space after data.
+     * Space of shared segment is not available.
+     */
+    size_type tailroom() const {
+        return m_segments.empty() || !m_segments.back().unique() ? 0 : m_segments.back().capacity - m_segments.back().end;
+    }
+
+    /**
+     * @brief Method for calling callback with every
+     * segment data.
+     * @param callback Callable with `(const std::byte*, size_type)` signature.
+     */
+    template <typename Callback>
+    void for_each_segment(Callback callback) const {
+        for (auto& segment : m_segments) {
+            callback(static_cast<const std::byte*>(segment.data()), segment.size());
+        }
+    }
+
+    /**
+     * @brief Method for prepending raw data.
+     * @param data Pointer to data.
+     * @param size Size in bytes.
+     */
+    void prepend(const void* data, size_type size) {
+        if (size == 0) {
+            return;
+        }
+
+        if (headroom() < size) {
+            auto capacity = std::max(size, m_segmentCapacity);
+
+            // Data is placed at the end, so next prepends fit into headroom
+            m_segments.push_front(allocate(capacity, capacity));
+        }
+
+        auto& front = m_segments.front();
+
+        front.begin -= size;
+        std::memcpy(front.data(), data, size);
+        m_size += size;
+    }
+
+    /**
+     * @brief Method for prepending byte array,
+     * it's reader, processor or view.
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type prepend(const Sequence& sequence) {
+        prepend(detail::byte_data(sequence), detail::byte_size(sequence));
+    }
+
+    /**
+     * @brief Method for prepending some trivially copyable
+     * type with defined endianness.
+     * @tparam T Type.
+     * @param value Value.
+     * @param order Endianness.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type push_front(T value, endianness order = endianness::big) {
+        order_bytes(value, order);
+        prepend(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Method for appending raw data.
+     * @param data Pointer to data.
+     * @param size Size in bytes.
+     */
+    void append(const void* data, size_type size) {
+        if (size == 0) {
+            return;
+        }
+
+        if (tailroom() < size) {
+            auto headroom = m_segments.empty() ? m_headroom : 0;
+
+            m_segments.push_back(allocate(std::max(size + headroom, m_segmentCapacity), headroom));
+        }
+
+        auto& back = m_segments.back();
+
+        std::memcpy(back.storage.get() + back.end, data, size);
+        back.end += size;
+        m_size += size;
+    }
+
+    /**
+     * @brief Method for appending byte array,
+     * it's reader, processor or view.
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type append(const Sequence& sequence) {
+        append(detail::byte_data(sequence), detail::byte_size(sequence));
+    }
+
+    /**
+     * @brief Method for appending some trivially copyable
+     * type with defined endianness.
+     * @tparam T Type.
+     * @param value Value.
+     * @param order Endianness.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type push_back(T value, endianness order = endianness::big) {
+        order_bytes(value, order);
+        append(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Method for moving segments of other chain
+     * to the end of this chain. Data is not copied.
+     * @param other Chain. Becomes empty.
+     */
+    void append(buffer_chain&& other) {
+        for (auto& segment : other.m_segments) {
+            m_segments.push_back(std::move(segment));
+        }
+
+        m_size += other.m_size;
+        other.clear();
+    }
+
+    /**
+     * @brief Method for moving segments of other chain
+     * to the beginning of this chain. Data is not copied.
+     * @param other Chain. Becomes empty.
+     */
+    void prepend(buffer_chain&& other) {
+        for (auto segment = other.m_segments.rbegin(); segment != other.m_segments.rend(); ++segment) {
+            m_segments.push_front(std::move(*segment));
+        }
+
+        m_size += other.m_size;
+        other.clear();
+    }
+
+    /**
+     * @brief Method for removing bytes from beginning.
+     * @param size Number of bytes. Can't be bigger, than `size()`.
+     */
+    void trim_front(size_type size) {
+        assert(size <= m_size && "Can't trim more, than chain size.");
+
+        m_size -= size;
+
+        while (size > 0) {
+            auto& front = m_segments.front();
+
+            if (size < front.size()) {
+                front.begin += size;
+                return;
+            }
+
+            size -= front.size();
+            m_segments.pop_front();
+        }
+    }
+
+    /**
+     * @brief Method for removing bytes from end.
+     * @param size Number of bytes. Can't be bigger, than `size()`.
+     */
+    void trim_back(size_type size) {
+        assert(size <= m_size && "Can't trim more, than chain size.");
+
+        m_size -= size;
+
+        while (size > 0) {
+            auto& back = m_segments.back();
+
+            if (size < back.size()) {
+                back.end -= size;
+                return;
+            }
+
+            size -= back.size();
+            m_segments.pop_back();
+        }
+    }
+
+    /**
+     * @brief Method for splitting chain. First `size`
+     * bytes are moved to result, segment at split point
+     * becomes shared by both chains.
+     * @param size Number of bytes. Can't be bigger, than `size()`.
+     * @return Chain with first `size` bytes.
+     */
+    buffer_chain split(size_type size) {
+        assert(size <= m_size && "Can't split more, than chain size.");
+
+        buffer_chain result(m_segmentCapacity, m_headroom);
+
+        result.m_size = size;
+        m_size -= size;
+
+        while (size > 0) {
+            auto& front = m_segments.front();
+
+            if (size < front.size()) {
+                segment head = front;
+
+                head.end = head.begin + size;
+                front.begin += size;
+
+                result.m_segments.push_back(std::move(head));
+                break;
+            }
+
+            size -= front.size();
+            result.m_segments.push_back(std::move(front));
+            m_segments.pop_front();
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Method for creating chain, that shares
+     * segments with this one. Data is not copied, both
+     * chains stop writing into headroom and tailroom
+     * of shared segments.
+     */
+    buffer_chain clone() const {
+        buffer_chain result(m_segmentCapacity, m_headroom);
+
+        result.m_segments = m_segments;
+        result.m_size = m_size;
+
+        return result;
+    }
+
+    /**
+     * @brief Method for making data contiguous.
+     * Does nothing if chain has single segment,
+     * otherwise all segments are copied into new one.
+     * Headroom of first segment is kept.
+     * @return Pointer to data.
+     */
+    const std::byte* coalesce() {
+        if (m_segments.empty()) {
+            return nullptr;
+        }
+
+        if (m_segments.size() > 1) {
+            auto headroom = m_segments.front().begin;
+            auto merged = allocate(headroom + m_size, headroom);
+
+            for (auto& segment : m_segments) {
+                std::memcpy(merged.storage.get() + merged.end, segment.data(), segment.size());
+                merged.end += segment.size();
+            }
+
+            m_segments.clear();
+            m_segments.push_back(std::move(merged));
+        }
+
+        return m_segments.front().data();
+    }
+
+    /**
+     * @brief Method for copying data into byte array.
+     */
+    bytearray<> to_bytearray() const {
+        bytearray<> result;
+
+        result.container().reserve(m_size);
+
+        for (auto& segment : m_segments) {
+            result.container().insert(result.container().end(), segment.data(), segment.data() + segment.size());
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Method for removing all data.
+     */
+    void clear() {
+        m_segments.clear();
+        m_size = 0;
+    }
+
+    /**
+     * @brief Method for creating cursor at
+     * beginning of chain.
+     */
+    cursor make_cursor() const;
+
+private:
+    static segment allocate(size_type capacity, size_type offset) {
+        return segment{std::shared_ptr<std::byte[]>(new std::byte[capacity]), capacity, offset, offset};
+    }
+
+    template <typename T>
+    static void order_bytes(T& value, endianness order) {
+        if (order != detail::system_endianness()) {
+            auto bytes = reinterpret_cast<std::byte*>(&value);
+
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+    }
+
+    std::deque<segment> m_segments;
+    size_type m_segmentCapacity;
+    size_type m_headroom;
+    size_type m_size;
+};
+
+/**
+ * @brief Class, that describes read position in
+ * chain. Values are read across segment boundaries.
+ * Chain must not be modified while cursor is used.
+ */
+class buffer_chain::cursor {
+public:
+    explicit cursor(const buffer_chain& chain)
+        : m_chain(&chain)
+        , m_segment(0)
+        , m_offset(0)
+        , m_position(0) {}
+
+    /**
+     * @brief Method for getting number of read bytes.
+     */
+    size_type position() const { return m_position; }
+
+    /**
+     * @brief Method for getting number of not read bytes.
+     */
+    size_type remaining() const { return m_chain->m_size - m_position; }
+
+    /**
+     * @brief Method for reading raw bytes.
+     * @param destination Pointer to destination.
+     * @param size Number of bytes. Can't be bigger, than `remaining()`.
+     */
+    void read(void* destination, size_type size) {
+        assert(size <= remaining() && "Can't read more, than remaining size.");
+
+        auto output = static_cast<std::byte*>(destination);
+
+        m_position += size;
+
+        while (size > 0) {
+            auto& segment = m_chain->m_segments[m_segment];
+            auto amount = std::min(size, segment.size() - m_offset);
+
+            std::memcpy(output, segment.data() + m_offset, amount);
+
+            output += amount;
+            size -= amount;
+            m_offset += amount;
+
+            if (m_offset == segment.size()) {
+                ++m_segment;
+                m_offset = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Method for reading some trivially
+     * copyable type with defined endianness.
+     * @tparam T Type.
+     * @param order Read order.
+     * @return Read value.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value, T>::type read(endianness order = endianness::big) {
+        T value;
+
+        read(&value, sizeof(T));
+        order_bytes(value, order);
+
+        return value;
+    }
+
+    /**
+     * @brief Method for skipping bytes.
+     * @param size Number of bytes. Can't be bigger, than `remaining()`.
+     */
+    void skip(size_type size) {
+        assert(size <= remaining() && "Can't skip more, than remaining size.");
+
+        m_position += size;
+
+        while (size > 0) {
+            auto amount = std::min(size, m_chain->m_segments[m_segment].size() - m_offset);
+
+            size -= amount;
+            m_offset += amount;
+
+            if (m_offset == m_chain->m_segments[m_segment].size()) {
+                ++m_segment;
+                m_offset = 0;
+            }
+        }
+    }
+
+private:
+    const buffer_chain* m_chain;
+    size_type m_segment;
+    size_type m_offset;
+    size_type m_position;
+};
+
+inline buffer_chain::cursor buffer_chain::make_cursor() const {
+    return cursor(*this);
+}
+
+}  // namespace ba
@@ -34,14 +34,18 @@ public:
      */
     bytearray(bytearray<Allocator>&& rhs) noexcept
         : processor(*static_cast<vector*>(this))
-        , vector(std::move(rhs.container())) {}
+        , vector(std::move(rhs.container())) {
+        this->m_head = rhs.m_head;
+        rhs.m_head = 0;
+    }
 
     /**
-     * @brief Default copy constructor.
+     * @brief Copy constructor. Consumed bytes
+     * are not copied.
      */
     bytearray(const bytearray<Allocator>& rhs)
         : processor(*static_cast<vector*>(this))
-        , vector(rhs.container()) {}
+        , vector(rhs.data(), rhs.data() + rhs.size()) {}
 
     /**
      * @brief Constructor with initial size.
@@ -61,7 +65,10 @@ public:
      * @brief Copy operator.
      */
     bytearray<Allocator>& operator=(const bytearray<Allocator>& rhs) {
-        vector::operator=(rhs.container());
+        if (this != &rhs) {
+            vector::assign(rhs.data(), rhs.data() + rhs.size());
+            this->m_head = 0;
+        }
 
         return (*this);
     }
@@ -72,26 +79,136 @@ public:
     bytearray<Allocator>& operator=(bytearray<Allocator>&& rhs) noexcept {
         vector::operator=(std::move(rhs.container()));
 
+        this->m_head = rhs.m_head;
+        rhs.m_head = 0;
+
         return (*this);
     }
 
-    using vector::operator[];
+    /**
+     * @brief Amount of consumed bytes, after which
+     * storage may be compacted.
+     */
+    static constexpr size_type compact_threshold = 4096;
+
+    /**
+     * @brief Method for removing bytes from front in O(1).
+     * Bytes are only skipped, storage is compacted lazily,
+     * when consumed space exceeds `compact_threshold` and
+     * size of rest data, so every byte is moved at most once
+     * on average. All positions (`read`, `set`, `operator[]`...)
+     * stay relative to first not consumed byte. Compaction
+     * invalidates views and iterators like reallocation does.
+     * Storage isn't compacted while mark is active, so
+     * `rollback` may return consumed bytes.
+     * @param amount Amount of bytes. Can't be bigger, than `size()`.
+     */
+    void consume(size_type amount) {
+        assert(amount <= this->size() && "Can't consume more, than byte array size.");
+
+        this->m_head += amount;
+
+        if (this->m_journaling) {
+            return;
+        }
+
+        if (this->m_head == vector::size()) {
+            // Everything is consumed, so nothing has to be moved
+            clear();
+        } else if (this->m_head > compact_threshold && this->m_head > this->size()) {
+            compact();
+        }
+    }
+
+    /**
+     * @brief Method for moving not consumed bytes
+     * to the beginning of storage. Capacity is kept.
+     */
+    void compact() {
+        assert(!this->m_journaling && "Storage can't be compacted while mark is active.");
+
+        vector::erase(vector::begin(), vector::begin() + this->m_head);
+        this->m_head = 0;
+    }
+
+    /**
+     * @brief Method for removing all bytes.
+     * Capacity is kept.
+     */
+    void clear() {
+        vector::clear();
+        this->m_head = 0;
+    }
+
+    /**
+     * @brief Method for checking is byte array empty.
+     */
+    bool empty() const { return this->size() == 0; }
+
+    /**
+     * @brief Method for getting element reference.
+     */
+    std::byte& operator[](size_type i) { return vector::operator[](this->m_head + i); }
+
+    /**
+     * @brief Method for getting element value.
+     */
+    std::byte operator[](size_type i) const { return vector::operator[](this->m_head + i); }
+
+    /**
+     * @brief Method for getting element reference
+     * with bounds checking.
+     */
+    std::byte& at(size_type i) {
+        if (i >= this->size()) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return (*this)[i];
+    }
+
+    /**
+     * @brief Method for getting element value
+     * with bounds checking.
+     */
+    std::byte at(size_type i) const {
+        if (i >= this->size()) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return (*this)[i];
+    }
+
+    iterator begin() { return vector::begin() + this->m_head; }
+
+    const_iterator begin() const { return vector::begin() + this->m_head; }
+
+    const_iterator cbegin() const { return vector::cbegin() + this->m_head; }
+
+    iterator end() { return vector::end(); }
+
+    const_iterator end() const { return vector::end(); }
+
+    const_iterator cend() const { return vector::cend(); }
+
+    reverse_iterator rbegin() { return vector::rbegin(); }
+
+    const_reverse_iterator rbegin() const { return vector::rbegin(); }
+
+    const_reverse_iterator crbegin() const { return vector::crbegin(); }
+
+    reverse_iterator rend() { return vector::rend() - this->m_head; }
+
+    const_reverse_iterator rend() const { return vector::rend() - this->m_head; }
+
+    const_reverse_iterator crend() const { return vector::crend() - this->m_head; }
+
+    using processor::data;
     using processor::insert;
     using processor::push_back;
-    using vector::at;
-    using vector::begin;
+    using processor::size;
     using vector::capacity;
-    using vector::cbegin;
-    using vector::cend;
-    using vector::clear;
-    using vector::crbegin;
-    using vector::crend;
-    using vector::empty;
-    using vector::end;
-    using vector::rbegin;
-    using vector::rend;
     using vector::reserve;
-    using vector::size;
 };
 }  // namespace ba
 
@@ -2,6 +2,8 @@
 
 // ba
 #include <ba/bytearray_reader.hpp>
+#include <ba/detail/bitwise.hpp>
+#include <ba/detail/byte_swap.hpp>
 #include <ba/endianness.hpp>
 
 // C++ STL
@@ -13,10 +15,39 @@
 #include <memory>
 #include <ostream>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 namespace ba {
 
+/**
+ * @brief Structure, that describes typed handle
+ * of region, reserved by `reserve_slot`.
+ * @tparam T Type of value, that will be patched.
+ */
+template <typename T>
+struct slot {
+    using value_type = T;
+
+    std::size_t position;
+
+    /**
+     * @brief Method for getting position right
+     * after reserved region.
+     */
+    std::size_t end() const { return position + sizeof(T); }
+};
+
+/**
+ * @brief Structure, that describes state of byte
+ * array, returned by `mark` and accepted by `rollback`.
+ */
+struct checkpoint {
+    std::size_t size;
+    std::size_t journal;
+    std::size_t head;
+};
+
 /**
  * @brief Class, that implements
  * operations with vector like with byte array.
@@ -47,19 +78,21 @@ private:
         // Changing fill character
         ostream.fill('0');
 
-        const std::vector<ValueType>& container = arr.container();
+        // Consumed bytes are not printed
+        const ValueType* data = arr.data();
+        const size_type length = arr.size();
 
         //
         size_type index = 0;
-        for (index = 0; index < container.size() + (16 - (container.size() % 16)); ++index) {
+        for (index = 0; index < length + (16 - (length % 16)); ++index) {
             if (!(index % 16)) {
                 if (index) {
                     ostream << "| ";
                 }
 
                 for (std::size_t asc = index - 16; asc < index; ++asc) {
-                    if (container[asc] >= ValueType(' ') && container[asc] <= ValueType('~')) {
-                        ostream << static_cast<char>(container[asc]);
+                    if (data[asc] >= ValueType(' ') && data[asc] <= ValueType('~')) {
+                        ostream << static_cast<char>(data[asc]);
                     } else {
                         ostream << '.';
                     }
@@ -74,9 +107,9 @@ private:
                 ostream << "| ";
             }
 
-            if (index < container.size()) {
+            if (index < length) {
                 ostream.width(2);
-                ostream << std::uppercase << std::hex << static_cast<int>(container[index]) << ' ';
+                ostream << std::uppercase << std::hex << static_cast<int>(data[index]) << ' ';
             } else {
                 ostream << "   ";
             }
@@ -87,9 +120,9 @@ private:
         }
 
         for (size_type asc = index - 16; asc < index; ++asc) {
-            if (asc < container.size()) {
-                if (container[asc] >= ValueType(' ') && container[asc] <= ValueType('~')) {
-                    ostream << static_cast<char>(container[asc]);
+            if (asc < length) {
+                if (data[asc] >= ValueType(' ') && data[asc] <= ValueType('~')) {
+                    ostream << static_cast<char>(data[asc]);
                 } else {
                     ostream << '.';
                 }
@@ -100,7 +133,7 @@ private:
 
         ostream << std::endl
                 << std::nouppercase << "               #-------------#-------------#-------------#-------------#" << std::endl
-                << "}, Length: " << std::dec << container.size() << ", Capacity: " << std::dec << container.capacity() << ')' << std::endl;
+                << "}, Length: " << std::dec << length << ", Capacity: " << std::dec << arr.container().capacity() << ')' << std::endl;
 
         ostream.flags(oldFlags);
         ostream.precision(oldPrec);
@@ -136,6 +169,20 @@ public:
      */
     const vector& container() const { return m_container; }
 
+    /**
+     * @brief Method for getting pointer to first byte.
+     * Bytes, consumed from front of owning byte array,
+     * are skipped.
+     * @return Pointer to data.
+     */
+    ValueType* data() { return m_container.data() + this->m_head; }
+
+    /**
+     * @brief Method for getting constant pointer to first byte.
+     * @return Pointer to data.
+     */
+    const ValueType* data() const { return m_container.data() + this->m_head; }
+
     /**
      * @brief Method for loading bytearray data from hex.
      * If bytearray already contains any data - it will be erased.
@@ -179,6 +226,7 @@ public:
 
         m_container.clear();
         m_container.reserve(count);
+        this->m_head = 0;
 
         bool isFirst = true;
         uint8_t firstValue = 0;
@@ -294,6 +342,98 @@ public:
         push_back_multiple(il.begin(), il.end(), order);
     }
 
+    /**
+     * @brief Method for pushing back array of values,
+     * stored with `Width` lowest bytes each (24 bit audio
+     * samples, 48 bit timestamps). Higher bytes are dropped.
+     * @tparam Width Width of stored value in bytes.
+     * @tparam T Unsigned value type, not smaller, than `Width`.
+     * @param values Pointer to values.
+     * @param count Amount of values.
+     * @param order Byte order.
+     */
+    template <std::size_t Width, typename T>
+    typename std::enable_if<std::is_unsigned<T>::value>::type pack_width(const T* values,
+                                                                         size_type count,
+                                                                         endianness order = endianness::big) {
+        auto offset = m_container.size();
+
+        m_container.resize(offset + Width * count);
+
+        detail::pack_width<Width>(values, count, reinterpret_cast<uint8_t*>(m_container.data() + offset), order);
+    }
+
+    /**
+     * @brief Method for pushing back vector of values,
+     * stored with `Width` lowest bytes each.
+     */
+    template <std::size_t Width, typename T, typename VectorAllocator>
+    typename std::enable_if<std::is_unsigned<T>::value>::type pack_width(const std::vector<T, VectorAllocator>& values,
+                                                                         endianness order = endianness::big) {
+        pack_width<Width>(values.data(), values.size(), order);
+    }
+
+    /**
+     * @brief Method for pushing back LEB128 encoded
+     * unsigned value (varint). Signed values have to
+     * be zigzag encoded first (`ba/varint.hpp`).
+     * @tparam T Unsigned type.
+     * @param value Value.
+     * @return Amount of written bytes.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_unsigned<T>::value, size_type>::type push_back_varint(T value) {
+        uint8_t buffer[detail::max_varint_size] = {};
+
+        auto size = detail::encode_varint(value, buffer);
+        auto first = reinterpret_cast<const ValueType*>(buffer);
+
+        m_container.insert(m_container.end(), first, first + size);
+
+        return size;
+    }
+
+    /**
+     * @brief Method for reserving zero filled region at
+     * the end for value, that's known only after following
+     * data is written (length prefix, checksum). Slots may
+     * be nested. Positions are not valid after `consume`.
+     * @tparam T Value type.
+     * @return Handle for `patch`.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value, slot<T>>::type reserve_slot() {
+        slot<T> result{this->size()};
+
+        m_container.resize(m_container.size() + sizeof(T));
+
+        return result;
+    }
+
+    /**
+     * @brief Method for writing value into reserved region.
+     * @tparam T Value type.
+     * @param handle Slot, returned by `reserve_slot`.
+     * @param value Value.
+     * @param order Byte order.
+     */
+    template <typename T>
+    void patch(const slot<T>& handle, typename slot<T>::value_type value, endianness order = endianness::big) {
+        set<T>(handle.position, value, order);
+    }
+
+    /**
+     * @brief Method for getting amount of bytes, written
+     * after slot. It's value of length prefix.
+     * @param handle Slot, returned by `reserve_slot`.
+     */
+    template <typename T>
+    size_type size_after(const slot<T>& handle) const {
+        assert(handle.end() <= this->size() && "Slot is out of bounds.");
+
+        return this->size() - handle.end();
+    }
+
     /**
      * @brief Method for insertion some trivially copyable type
      * with defined endianness.
@@ -306,14 +446,16 @@ public:
     typename std::enable_if<std::is_trivially_copyable<T>::value>::type insert(size_type position,
                                                                                T value,
                                                                                endianness order = endianness::big) {
-        assert(position <= m_container.size() && "Position is out of bounds.");
+        assert(position <= this->size() && "Position is out of bounds.");
 
-        if (order == get_system_endianness()) {
-            m_container.insert(m_container.begin() + position, ((ValueType*)&value), ((ValueType*)&value) + sizeof(value));
-        } else {
-            m_container.insert(m_container.begin() + position, std::reverse_iterator(((ValueType*)&value) + sizeof(value)),
-                               std::reverse_iterator((ValueType*)&value));
+        position += this->m_head;
+
+        // Bytes are reversed in place, range insert with reverse iterators gives false -Wstringop-overflow
+        if (order != get_system_endianness()) {
+            std::reverse(((ValueType*)&value), ((ValueType*)&value) + sizeof(value));
         }
+
+        m_container.insert(m_container.begin() + position, ((ValueType*)&value), ((ValueType*)&value) + sizeof(value));
     }
 
     /**
@@ -332,12 +474,13 @@ public:
                                                                                     endianness order = endianness::big) {
         assert(sizeof(T) >= size && "Can't insert size bigger, than type.");
 
-        if (order == get_system_endianness()) {
-            m_container.insert(m_container.begin() + position, ((ValueType*)&value), ((ValueType*)&value) + size);
-        } else {
-            m_container.insert(m_container.begin() + position, std::reverse_iterator(((ValueType*)&value) + size),
-                               std::reverse_iterator((ValueType*)&value));
+        position += this->m_head;
+
+        if (order != get_system_endianness()) {
+            std::reverse(((ValueType*)&value), ((ValueType*)&value) + size);
         }
+
+        m_container.insert(m_container.begin() + position, ((ValueType*)&value), ((ValueType*)&value) + size);
     }
 
     /**
@@ -355,7 +498,7 @@ public:
                                                                                         size_type amount,
                                                                                         endianness order = endianness::big) {
         // Moving everything
-        m_container.insert(m_container.begin() + position, sizeof(T) * amount, ValueType(0x00));
+        m_container.insert(m_container.begin() + this->m_head + position, sizeof(T) * amount, ValueType(0x00));
 
         for (size_type i = 0; i < amount; ++i) {
             set<T>(position + sizeof(T) * i, value, order);
@@ -379,7 +522,7 @@ public:
         auto count = std::distance(begin, last);
 
         // Moving everything
-        m_container.insert(m_container.begin() + position, sizeof(val) * count, ValueType(0x00));
+        m_container.insert(m_container.begin() + this->m_head + position, sizeof(val) * count, ValueType(0x00));
 
         size_type index = 0;
 
@@ -403,7 +546,14 @@ public:
     typename std::enable_if<std::is_trivially_copyable<T>::value>::type set(size_type position,
                                                                             T value,
                                                                             endianness order = endianness::big) {
-        assert(position + sizeof(value) <= m_container.size() && "Position + type size is out of bounds.");
+        assert(position + sizeof(value) <= this->size() && "Position + type size is out of bounds.");
+
+        position += this->m_head;
+
+        // Only bytes, that existed at last mark, have to be restored
+        if (m_journaling && position < m_journalFloor) {
+            journal(position, sizeof(T));
+        }
 
         if (order == get_system_endianness()) {
             for (std::size_t i = 0; i < sizeof(T); ++i) {
@@ -416,6 +566,162 @@ public:
         }
     }
 
+    /**
+     * @brief Method for XOR of bytes with byte sequence
+     * (in place, vectorized).
+     * @param other Byte array, reader or view.
+     * @param position Position of first changed byte.
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type xor_with(const Sequence& other, size_type position = 0) {
+        xor_with(detail::byte_data(other), detail::byte_size(other), position);
+    }
+
+    void xor_with(const void* other, size_type size, size_type position = 0) {
+        detail::bitwise<detail::bitwise_xor>(modify(position, size), bytes(position), static_cast<const uint8_t*>(other), size);
+    }
+
+    /**
+     * @brief Method for AND of bytes with byte sequence
+     * (in place, vectorized).
+     * @param other Byte array, reader or view.
+     * @param position Position of first changed byte.
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type and_with(const Sequence& other, size_type position = 0) {
+        and_with(detail::byte_data(other), detail::byte_size(other), position);
+    }
+
+    void and_with(const void* other, size_type size, size_type position = 0) {
+        detail::bitwise<detail::bitwise_and>(modify(position, size), bytes(position), static_cast<const uint8_t*>(other), size);
+    }
+
+    /**
+     * @brief Method for OR of bytes with byte sequence
+     * (in place, vectorized).
+     * @param other Byte array, reader or view.
+     * @param position Position of first changed byte.
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type or_with(const Sequence& other, size_type position = 0) {
+        or_with(detail::byte_data(other), detail::byte_size(other), position);
+    }
+
+    void or_with(const void* other, size_type size, size_type position = 0) {
+        detail::bitwise<detail::bitwise_or>(modify(position, size), bytes(position), static_cast<const uint8_t*>(other), size);
+    }
+
+    /**
+     * @brief Method for inverting all bits of byte array.
+     */
+    void invert() { invert(0, this->size()); }
+
+    /**
+     * @brief Method for inverting bits of region.
+     * @param position Region position.
+     * @param size Region size.
+     */
+    void invert(size_type position, size_type size) { detail::bitwise_not(modify(position, size), bytes(position), size); }
+
+    /**
+     * @brief Method for XOR of all bytes with repeating
+     * key (WebSocket masking for example).
+     * @param key Key (byte array, reader or view). Can't be empty.
+     * @param keyOffset Index of key byte for first byte.
+     * @return Key offset for next byte, so data, that
+     * comes in chunks, can be masked chunk by chunk.
+     */
+    template <typename Key>
+    typename std::enable_if<detail::is_byte_sequence<Key>::value, std::size_t>::type xor_mask(const Key& key, std::size_t keyOffset = 0) {
+        return xor_mask(detail::byte_data(key), detail::byte_size(key), keyOffset, 0, this->size());
+    }
+
+    /**
+     * @brief Method for XOR of region with repeating key.
+     * @param key Pointer to key.
+     * @param keySize Key size. Can't be 0.
+     * @param keyOffset Index of key byte for first byte of region.
+     * @param position Region position.
+     * @param size Region size.
+     * @return Key offset for next byte.
+     */
+    std::size_t xor_mask(const void* key, std::size_t keySize, std::size_t keyOffset, size_type position, size_type size) {
+        assert(keySize != 0 && "Key can't be empty.");
+
+        return detail::xor_mask(modify(position, size), bytes(position), size, static_cast<const uint8_t*>(key), keySize, keyOffset);
+    }
+
+    /**
+     * @brief Method for reversing byte order of array
+     * of values in place (big endian words to host order
+     * for example). Values may be unaligned, conversion
+     * is vectorized.
+     * @tparam T Trivially copyable type of size 1, 2, 4 or 8.
+     * @param position Position of first value.
+     * @param count Amount of values.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type swap_endianness(size_type position, size_type count) {
+        detail::swap_bytes<sizeof(T)>(modify(position, count * sizeof(T)), count);
+    }
+
+    /**
+     * @brief Maximum amount of journaled writes (`set`
+     * calls and in place operations), that can be undone
+     * by `rollback`.
+     */
+    static constexpr std::size_t journal_limit = 256;
+
+    /**
+     * @brief Method for remembering current state for
+     * speculative writing. Marks may be nested. While
+     * any mark is active, `set` writes and in place
+     * operations over existing data are journaled.
+     * Appended data is undone by truncation,
+     * consumed bytes are returned (storage isn't compacted
+     * while marks are active). `insert` before end is not undone.
+     * @return Checkpoint for `rollback`.
+     */
+    checkpoint mark() {
+        m_journaling = true;
+        m_journalFloor = m_container.size();
+
+        return checkpoint{this->size(), m_journal.size(), this->m_head};
+    }
+
+    /**
+     * @brief Method for returning to marked state.
+     * Size is truncated without freeing capacity, journaled
+     * `set` writes are restored. Mark stays valid and inner
+     * marks become invalid.
+     * @param point Checkpoint, returned by `mark`.
+     * @return `false` if journal overflowed, so some
+     * `set` writes were not restored.
+     */
+    bool rollback(const checkpoint& point) {
+        assert(point.head + point.size <= m_container.size() && "Checkpoint is out of bounds.");
+
+        auto restored = restore(point.journal);
+
+        this->m_head = point.head;
+        m_container.resize(point.head + point.size);
+        m_journalFloor = m_container.size();
+
+        return restored;
+    }
+
+    /**
+     * @brief Method for accepting all changes since
+     * first active mark. All marks become invalid.
+     */
+    void commit() {
+        m_journal.clear();
+        m_journalData.clear();
+        m_journaling = false;
+        m_journalOverflow = false;
+        m_journalFloor = 0;
+    }
+
     /**
      * @brief Method for performing translation of
      * byte array to some trivially copyable type.
@@ -427,7 +733,9 @@ public:
     template <typename T>
     typename std::enable_if<std::is_trivially_copyable<T>::value, T>::type read(size_type position,
                                                                                 endianness order = endianness::big) const {
-        assert(position + sizeof(T) <= m_container.size() && "Position + type size is out of bounds.");
+        assert(position + sizeof(T) <= this->size() && "Position + type size is out of bounds.");
+
+        position += this->m_head;
 
         T value;
 
@@ -457,7 +765,9 @@ public:
                                                                                      size_type size,
                                                                                      endianness order = endianness::big) const {
         assert(size <= sizeof(T) && "Size if bigger, than types size");
-        assert(position + size <= m_container.size() && "Position + size is out of bounds.");
+        assert(position + size <= this->size() && "Position + size is out of bounds.");
+
+        position += this->m_head;
 
         T value;
         std::memset(&value, 0, sizeof(T));
@@ -489,7 +799,85 @@ private:
         return example.c[0] == 1 ? endianness::big : endianness::little;
     }
 
+    template <typename, typename>
+    friend class bytearray_view;
+
+    template <typename>
+    friend class bytearray;
+
+    /**
+     * @brief Structure, that describes overwritten bytes.
+     * Bytes are stored in journal data from `offset`.
+     */
+    struct journal_entry {
+        size_type position;
+        size_type size;
+        std::size_t offset;
+    };
+
+    const uint8_t* bytes(size_type position) const { return reinterpret_cast<const uint8_t*>(this->data()) + position; }
+
+    /**
+     * @brief Method for preparing region for in place
+     * modification: bounds are checked and bytes are journaled
+     * like `set` writes.
+     * @return Pointer to first byte of region.
+     */
+    uint8_t* modify(size_type position, size_type size) {
+        assert(position + size <= this->size() && "Position + size is out of bounds.");
+
+        position += this->m_head;
+
+        if (m_journaling && position < m_journalFloor) {
+            journal(position, std::min(size, m_journalFloor - position));
+        }
+
+        return reinterpret_cast<uint8_t*>(m_container.data()) + position;
+    }
+
+    /**
+     * @brief Method for saving bytes before overwriting.
+     * Whole region is saved as one entry. Positions are
+     * physical (consumed bytes included), so `consume`
+     * doesn't move journaled regions.
+     * @param position Position in container.
+     * @param size Amount of bytes.
+     */
+    void journal(size_type position, size_type size) {
+        if (m_journal.size() == journal_limit) {
+            m_journalOverflow = true;
+            return;
+        }
+
+        m_journal.push_back(journal_entry{position, size, m_journalData.size()});
+        m_journalData.insert(m_journalData.end(), m_container.begin() + position, m_container.begin() + position + size);
+    }
+
+    /**
+     * @brief Method for restoring journaled bytes
+     * in reverse order.
+     * @param journalSize Journal size at checkpoint.
+     * @return `false` if journal overflowed.
+     */
+    bool restore(std::size_t journalSize) {
+        while (m_journal.size() > journalSize) {
+            auto& entry = m_journal.back();
+
+            std::memcpy(m_container.data() + entry.position, m_journalData.data() + entry.offset, entry.size);
+
+            m_journalData.resize(entry.offset);
+            m_journal.pop_back();
+        }
+
+        return !m_journalOverflow;
+    }
+
     vector& m_container;
+    std::vector<journal_entry> m_journal;
+    std::vector<ValueType> m_journalData;
+    size_type m_journalFloor = 0;
+    bool m_journaling = false;
+    bool m_journalOverflow = false;
 };
 }  // namespace ba
 
@@ -499,8 +887,8 @@ template <typename ValueType, typename Allocator>
 std::string to_string(const ba::bytearray_processor<ValueType, Allocator>& processor) {
     std::stringstream ss;
 
-    for (auto&& b : processor.container()) {
-        ss << std::uppercase << std::setfill('0') << std::setw(2) << std::hex << int(b);
+    for (auto b = processor.data(); b != processor.data() + processor.size(); ++b) {
+        ss << std::uppercase << std::setfill('0') << std::setw(2) << std::hex << int(*b);
     }
 
     return ss.str();
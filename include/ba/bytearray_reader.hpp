@@ -1,6 +1,9 @@
 #pragma once
 
 // ba
+#include <ba/compare.hpp>
+#include <ba/detail/packed.hpp>
+#include <ba/detail/varint.hpp>
 #include <ba/endianness.hpp>
 
 // C++ STL
@@ -9,9 +12,11 @@
 #include <cstddef>
 #include <cstring>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 namespace ba {
@@ -46,19 +51,21 @@ private:
         // Changing fill character
         ostream.fill('0');
 
-        const std::vector<ValueType>& container = arr.container();
+        // Consumed bytes are not printed
+        const ValueType* data = arr.data();
+        const size_type length = arr.size();
 
         //
         size_type index = 0;
-        for (index = 0; index < container.size() + (16 - (container.size() % 16)); ++index) {
+        for (index = 0; index < length + (16 - (length % 16)); ++index) {
             if (!(index % 16)) {
                 if (index) {
                     ostream << "| ";
                 }
 
                 for (std::size_t asc = index - 16; asc < index; ++asc) {
-                    if (container[asc] >= ValueType(' ') && container[asc] <= ValueType('~')) {
-                        ostream << static_cast<char>(container[asc]);
+                    if (data[asc] >= ValueType(' ') && data[asc] <= ValueType('~')) {
+                        ostream << static_cast<char>(data[asc]);
                     } else {
                         ostream << '.';
                     }
@@ -73,9 +80,9 @@ private:
                 ostream << "| ";
             }
 
-            if (index < container.size()) {
+            if (index < length) {
                 ostream.width(2);
-                ostream << std::uppercase << std::hex << static_cast<int>(container[index]) << ' ';
+                ostream << std::uppercase << std::hex << static_cast<int>(data[index]) << ' ';
             } else {
                 ostream << "   ";
             }
@@ -86,9 +93,9 @@ private:
         }
 
         for (size_type asc = index - 16; asc < index; ++asc) {
-            if (asc < container.size()) {
-                if (container[asc] >= ValueType(' ') && container[asc] <= ValueType('~')) {
-                    ostream << static_cast<char>(container[asc]);
+            if (asc < length) {
+                if (data[asc] >= ValueType(' ') && data[asc] <= ValueType('~')) {
+                    ostream << static_cast<char>(data[asc]);
                 } else {
                     ostream << '.';
                 }
@@ -99,7 +106,7 @@ private:
 
         ostream << std::endl
                 << std::nouppercase << "               #-------------#-------------#-------------#-------------#" << std::endl
-                << "}, Length: " << std::dec << container.size() << ", Capacity: " << std::dec << container.capacity() << ')' << std::endl;
+                << "}, Length: " << std::dec << length << ", Capacity: " << std::dec << arr.container().capacity() << ')' << std::endl;
 
         ostream.flags(oldFlags);
         ostream.precision(oldPrec);
@@ -128,6 +135,20 @@ public:
      */
     const vector& container() const { return m_container; }
 
+    /**
+     * @brief Method for getting pointer to first byte.
+     * Bytes, consumed from front of owning byte array,
+     * are skipped.
+     * @return Pointer to data.
+     */
+    const ValueType* data() const { return m_container.data() + m_head; }
+
+    /**
+     * @brief Method for getting size of data.
+     * @return Size in bytes.
+     */
+    size_type size() const { return m_container.size() - m_head; }
+
     /**
      * @brief Method for performing translation of
      * byte array to some trivially copyable type.
@@ -139,7 +160,9 @@ public:
     template <typename T>
     typename std::enable_if<std::is_trivially_copyable<T>::value, T>::type read(size_type position,
                                                                                 endianness order = endianness::big) const {
-        assert(position + sizeof(T) <= m_container.size() && "Position + type size is out of bounds.");
+        assert(position + sizeof(T) <= size() && "Position + type size is out of bounds.");
+
+        position += m_head;
 
         T value;
 
@@ -169,7 +192,9 @@ public:
                                                                                      size_type size,
                                                                                      endianness order = endianness::big) const {
         assert(size <= sizeof(T) && "Size if bigger, than types size");
-        assert(position + size <= m_container.size() && "Position + size is out of bounds.");
+        assert(position + size <= this->size() && "Position + size is out of bounds.");
+
+        position += m_head;
 
         T value;
         std::memset(&value, 0, sizeof(T));
@@ -187,6 +212,52 @@ public:
         return value;
     }
 
+    /**
+     * @brief Method for reading LEB128 encoded
+     * unsigned value (varint).
+     * @tparam T Unsigned type.
+     * @param position Value position.
+     * @return Value and amount of read bytes. Amount is 0 if
+     * value is truncated or doesn't fit into type.
+     */
+    template <typename T = uint64_t>
+    typename std::enable_if<std::is_unsigned<T>::value, std::pair<T, size_type>>::type read_varint(size_type position) const {
+        assert(position <= size() && "Position is out of bounds.");
+
+        uint64_t value = 0;
+        auto length = detail::decode_varint(reinterpret_cast<const uint8_t*>(data()) + position, size() - position, value);
+
+        if (length == 0 || value > std::numeric_limits<T>::max()) {
+            return {T(0), 0};
+        }
+
+        return {T(value), length};
+    }
+
+    /**
+     * @brief Method for reading array of values, that
+     * are stored with `Width` bytes each (24 bit audio
+     * samples, 48 bit timestamps).
+     * @tparam Width Width of stored value in bytes.
+     * @tparam T Unsigned output type, not smaller, than `Width`.
+     * @param position Position of first value.
+     * @param output Pointer to output values.
+     * @param count Amount of values.
+     * @param order Byte order.
+     * @return Amount of read bytes.
+     */
+    template <std::size_t Width, typename T>
+    typename std::enable_if<std::is_unsigned<T>::value, size_type>::type unpack_width(size_type position,
+                                                                                      T* output,
+                                                                                      size_type count,
+                                                                                      endianness order = endianness::big) const {
+        assert(position + Width * count <= size() && "Position + values size is out of bounds.");
+
+        detail::unpack_width<Width>(reinterpret_cast<const uint8_t*>(data()) + position, count, output, order);
+
+        return Width * count;
+    }
+
 private:
     /**
      * @brief Constexpr function for checking system endianness.
@@ -202,6 +273,13 @@ private:
     }
 
     const vector& m_container;
+
+protected:
+    /**
+     * @brief Offset of logical start in container.
+     * Only owning byte array moves it.
+     */
+    size_type m_head = 0;
 };
 }  // namespace ba
 
@@ -211,8 +289,8 @@ template <typename ValueType, typename Allocator>
 std::string to_string(const ba::bytearray_reader<ValueType, Allocator>& processor) {
     std::stringstream ss;
 
-    for (auto&& b : processor.container()) {
-        ss << std::uppercase << std::setfill('0') << std::setw(2) << std::hex << int(b);
+    for (auto b = processor.data(); b != processor.data() + processor.size(); ++b) {
+        ss << std::uppercase << std::setfill('0') << std::setw(2) << std::hex << int(*b);
     }
 
     return ss.str();
@@ -1,6 +1,12 @@
 #pragma once
 
 #include <ba/bytearray.hpp>
+#include <ba/detail/utf8.hpp>
+
+// C++ STL
+#include <limits>
+#include <optional>
+#include <string_view>
 
 namespace ba {
 /**
@@ -102,7 +108,7 @@ public:
     explicit bytearray_view(container& bytearray)
         : m_byteArray(bytearray)
         , m_start(0)
-        , m_size(m_byteArray.container().size()) {}
+        , m_size(m_byteArray.size()) {}
 
     /**
      * @brief Constructor with boundaries.
@@ -114,8 +120,8 @@ public:
         : m_byteArray(bytearray)
         , m_start(start)
         , m_size(size) {
-        assert(start <= m_byteArray.container().size());
-        assert(start + size <= m_byteArray.container().size());
+        assert(start <= m_byteArray.size());
+        assert(start + size <= m_byteArray.size());
     }
 
     /**
@@ -134,7 +140,7 @@ public:
      * @brief Method for getting begin of this
      * view.
      */
-    typename container::vector::iterator begin() { return m_byteArray.container().begin() + m_start; }
+    typename container::vector::iterator begin() { return m_byteArray.container().begin() + physical_start(); }
 
     /**
      * @brief Method for getting begin of this
@@ -145,7 +151,7 @@ public:
     /**
      * @brief Method for getting end of this view.
      */
-    typename container::vector::iterator end() { return m_byteArray.container().begin() + (m_start + m_size); }
+    typename container::vector::iterator end() { return m_byteArray.container().begin() + (physical_start() + m_size); }
 
     /**
      * @brief Method for getting end of this view.
@@ -156,41 +162,41 @@ public:
      * @brief Method for getting constant begin of this
      * view.
      */
-    typename container::vector::const_iterator cbegin() const { return m_byteArray.container().cbegin() + m_start; }
+    typename container::vector::const_iterator cbegin() const { return m_byteArray.container().cbegin() + physical_start(); }
 
     /**
      * @brief Method for getting constant end of this
      * view.
      */
-    typename container::vector::const_iterator cend() const { return m_byteArray.container().cbegin() + (m_start + m_size); }
+    typename container::vector::const_iterator cend() const { return m_byteArray.container().cbegin() + (physical_start() + m_size); }
 
     /**
      * @brief Method for getting reverse begin of this
      * view.
      */
     typename container::vector::reverse_iterator rbegin() {
-        return m_byteArray.container().rbegin() + (m_byteArray.container().size() - (m_start + m_size));
+        return m_byteArray.container().rbegin() + (m_byteArray.size() - (m_start + m_size));
     }
 
     /**
      * @brief Method for getting reverse end of this view.
      */
     typename container::vector::reverse_iterator rend() {
-        return m_byteArray.container().rbegin() + (m_byteArray.container().size() - m_start);
+        return m_byteArray.container().rbegin() + (m_byteArray.size() - m_start);
     }
 
     /**
      * @brief Method for getting constant reverse begin of this view.
      */
     typename container::vector::const_reverse_iterator crbegin() const {
-        return m_byteArray.container().crbegin() + (m_byteArray.container().size() - (m_start + m_size));
+        return m_byteArray.container().crbegin() + (m_byteArray.size() - (m_start + m_size));
     }
 
     /**
      * @brief Method for getting constant reverse end of this view.
      */
     typename container::vector::const_reverse_iterator crend() const {
-        return m_byteArray.container().crbegin() + (m_byteArray.container().size() - m_start);
+        return m_byteArray.container().crbegin() + (m_byteArray.size() - m_start);
     }
 
     /**
@@ -204,13 +210,13 @@ public:
      * @param i Index.
      * @return Reference to value.
      */
-    typename container::value_type& operator[](size_type i) { return m_byteArray.container()[m_start + i]; }
+    typename container::value_type& operator[](size_type i) { return m_byteArray.data()[m_start + i]; }
 
     /**
      * @brief Method for const access to specified element.
      * @param i Index.
      */
-    typename container::value_type operator[](size_type i) const { return m_byteArray.container()[m_start + i]; }
+    typename container::value_type operator[](size_type i) const { return m_byteArray.data()[m_start + i]; }
 
     /**
      * @brief Method for access to specified element with
@@ -284,6 +290,121 @@ public:
         m_size += amount * sizeof(T);
     }
 
+    /**
+     * @brief Method for pushing back LEB128 encoded
+     * unsigned value (varint).
+     * @tparam T Unsigned type.
+     * @param value Value.
+     * @return Amount of written bytes.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_unsigned<T>::value, size_type>::type push_back_varint(T value) {
+        uint8_t buffer[detail::max_varint_size] = {};
+
+        auto size = detail::encode_varint(value, buffer);
+
+        m_byteArray.insert_multiple(m_start + m_size, buffer, buffer + size);
+        m_size += size;
+
+        return size;
+    }
+
+    /**
+     * @brief Method for reading LEB128 encoded
+     * unsigned value (varint).
+     * @tparam T Unsigned type.
+     * @param position Value position.
+     * @return Value and amount of read bytes. Amount is 0 if
+     * value is truncated or doesn't fit into type.
+     */
+    template <typename T = uint64_t>
+    typename std::enable_if<std::is_unsigned<T>::value, std::pair<T, size_type>>::type read_varint(size_type position) const {
+        assert(position <= m_size && "Position is out of bounds.");
+
+        uint64_t value = 0;
+        auto length = detail::decode_varint(reinterpret_cast<const uint8_t*>(data()) + position, m_size - position, value);
+
+        if (length == 0 || value > std::numeric_limits<T>::max()) {
+            return {T(0), 0};
+        }
+
+        return {T(value), length};
+    }
+
+    /**
+     * @brief Method for reserving zero filled region at
+     * the end of view for value, that's known only after
+     * following data is written. Slots may be nested.
+     * @tparam T Value type.
+     * @return Handle for `patch` with position relative to view.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value, slot<T>>::type reserve_slot() {
+        slot<T> result{m_size};
+
+        push_back_multiple<uint8_t>(0x00, sizeof(T));
+
+        return result;
+    }
+
+    /**
+     * @brief Method for writing value into reserved region.
+     * @tparam T Value type.
+     * @param handle Slot, returned by `reserve_slot`.
+     * @param value Value.
+     * @param order Byte order.
+     */
+    template <typename T>
+    void patch(const slot<T>& handle, typename slot<T>::value_type value, endianness order = endianness::big) {
+        set<T>(handle.position, value, order);
+    }
+
+    /**
+     * @brief Method for remembering current state of view
+     * for speculative writing. See `bytearray_processor::mark`.
+     * @return Checkpoint for `rollback`.
+     */
+    checkpoint mark() { return checkpoint{m_size, m_byteArray.mark().journal, 0}; }
+
+    /**
+     * @brief Method for returning to marked state. Bytes,
+     * appended to view, are removed (it's O(1) if view ends
+     * at the end of byte array) and journaled `set` writes
+     * are restored.
+     * @param point Checkpoint, returned by `mark`.
+     * @return `false` if journal overflowed, so some
+     * `set` writes were not restored.
+     */
+    bool rollback(const checkpoint& point) {
+        assert(point.size <= m_size && "Checkpoint is out of bounds.");
+
+        auto restored = m_byteArray.restore(point.journal);
+        auto first = m_byteArray.container().begin() + (physical_start() + point.size);
+
+        m_byteArray.container().erase(first, first + (m_size - point.size));
+        m_size = point.size;
+
+        return restored;
+    }
+
+    /**
+     * @brief Method for accepting all changes since
+     * first active mark of byte array.
+     */
+    void commit() { m_byteArray.commit(); }
+
+    /**
+     * @brief Method for getting amount of bytes, written
+     * after slot. It's value of length prefix.
+     * @param handle Slot, returned by `reserve_slot`.
+     */
+    template <typename T>
+    size_type size_after(const slot<T>& handle) const {
+        assert(handle.end() <= m_size && "Slot is out of bounds.");
+
+        return m_size - handle.end();
+    }
+
     /**
      * @brief Method for insertion some trivially copyable type
      * with defined endianness.
@@ -379,6 +500,95 @@ public:
         m_byteArray.template set<T>(m_start + position, value, order);
     }
 
+    /**
+     * @brief Method for XOR of bytes with byte sequence
+     * (in place, vectorized).
+     * @param other Byte array, reader or view.
+     * @param position Position of first changed byte.
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type xor_with(const Sequence& other, size_type position = 0) {
+        xor_with(detail::byte_data(other), detail::byte_size(other), position);
+    }
+
+    void xor_with(const void* other, size_type size, size_type position = 0) {
+        assert(position + size <= this->size() && "Position + size is out of bounds.");
+
+        m_byteArray.xor_with(other, size, m_start + position);
+    }
+
+    /**
+     * @brief Method for AND of bytes with byte sequence
+     * (in place, vectorized).
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type and_with(const Sequence& other, size_type position = 0) {
+        and_with(detail::byte_data(other), detail::byte_size(other), position);
+    }
+
+    void and_with(const void* other, size_type size, size_type position = 0) {
+        assert(position + size <= this->size() && "Position + size is out of bounds.");
+
+        m_byteArray.and_with(other, size, m_start + position);
+    }
+
+    /**
+     * @brief Method for OR of bytes with byte sequence
+     * (in place, vectorized).
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type or_with(const Sequence& other, size_type position = 0) {
+        or_with(detail::byte_data(other), detail::byte_size(other), position);
+    }
+
+    void or_with(const void* other, size_type size, size_type position = 0) {
+        assert(position + size <= this->size() && "Position + size is out of bounds.");
+
+        m_byteArray.or_with(other, size, m_start + position);
+    }
+
+    /**
+     * @brief Method for inverting all bits of view.
+     */
+    void invert() { invert(0, size()); }
+
+    void invert(size_type position, size_type size) {
+        assert(position + size <= this->size() && "Position + size is out of bounds.");
+
+        m_byteArray.invert(m_start + position, size);
+    }
+
+    /**
+     * @brief Method for XOR of all bytes with repeating key.
+     * @param key Key (byte array, reader or view). Can't be empty.
+     * @param keyOffset Index of key byte for first byte.
+     * @return Key offset for next byte.
+     */
+    template <typename Key>
+    typename std::enable_if<detail::is_byte_sequence<Key>::value, std::size_t>::type xor_mask(const Key& key, std::size_t keyOffset = 0) {
+        return xor_mask(detail::byte_data(key), detail::byte_size(key), keyOffset, 0, size());
+    }
+
+    std::size_t xor_mask(const void* key, std::size_t keySize, std::size_t keyOffset, size_type position, size_type size) {
+        assert(position + size <= this->size() && "Position + size is out of bounds.");
+
+        return m_byteArray.xor_mask(key, keySize, keyOffset, m_start + position, size);
+    }
+
+    /**
+     * @brief Method for reversing byte order of array
+     * of values in place.
+     * @tparam T Trivially copyable type of size 1, 2, 4 or 8.
+     * @param position Position of first value.
+     * @param count Amount of values.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_trivially_copyable<T>::value>::type swap_endianness(size_type position, size_type count) {
+        assert(position + count * sizeof(T) <= size() && "Position + count is out of bounds.");
+
+        m_byteArray.template swap_endianness<T>(m_start + position, count);
+    }
+
     /**
      * @brief Method for performing translation of
      * byte array to some trivially copyable type.
@@ -418,29 +628,47 @@ public:
      */
     bool empty() const { return m_size == 0; }
 
-    const ValueType* data() const { return m_byteArray.container().data() + m_start; }
+    const ValueType* data() const { return m_byteArray.data() + m_start; }
 
-    ValueType* data() { return m_byteArray.container().data() + m_start; }
+    ValueType* data() { return m_byteArray.data() + m_start; }
 
     /**
-     * @brief Method for comparison of different views.
+     * @brief Method for getting view bytes as string
+     * without copying. Bytes are validated as UTF-8 first.
+     * String refers to byte array storage, so it's valid
+     * until byte array is modified.
+     * @return String or `std::nullopt` if bytes are not
+     * valid UTF-8.
      */
-    template <typename RhsAllocator>
-    bool operator==(const bytearray_view<value_type, RhsAllocator>& rhs) {
-        if (size() != rhs.size()) {
-            return false;
-        }
+    std::optional<std::string_view> as_string_view() const {
+        auto bytes = reinterpret_cast<const char*>(data());
 
-        for (size_type i = 0; i < size(); ++i) {
-            if (operator[](i) != rhs[i]) {
-                return false;
-            }
+        if (!detail::validate_utf8_bytes(reinterpret_cast<const uint8_t*>(bytes), m_size)) {
+            return std::nullopt;
         }
 
-        return true;
+        return std::string_view(bytes, m_size);
+    }
+
+    /**
+     * @brief Method for getting view of some part
+     * of this view.
+     * @param position Start position.
+     * @param size Size.
+     */
+    bytearray_view subview(size_type position, size_type size) {
+        assert(position + size <= m_size && "Position + size is out of bounds.");
+
+        return bytearray_view(m_byteArray, m_start + position, size);
     }
 
 private:
+    /**
+     * @brief Method for getting view start in container,
+     * including bytes, consumed from front of byte array.
+     */
+    size_type physical_start() const { return m_byteArray.container().size() - m_byteArray.size() + m_start; }
+
     container& m_byteArray;
     size_type m_start;
     size_type m_size;
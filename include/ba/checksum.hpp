@@ -0,0 +1,563 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_view.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ba {
+
+namespace detail {
+
+/**
+ * @brief Constexpr function for building slicing-by-8
+ * tables for reflected CRC32 polynomial.
+ * @param polynomial Reflected polynomial.
+ */
+constexpr std::array<std::array<uint32_t, 256>, 8> make_crc32_tables(uint32_t polynomial) {
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+        }
+
+        tables[0][i] = crc;
+    }
+
+    for (uint32_t i = 0; i < 256; ++i) {
+        for (std::size_t slice = 1; slice < 8; ++slice) {
+            tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xFF];
+        }
+    }
+
+    return tables;
+}
+
+constexpr uint32_t crc32c_polynomial = 0x82F63B78;
+constexpr uint32_t crc32_polynomial = 0xEDB88320;
+
+inline constexpr auto crc32c_tables = make_crc32_tables(crc32c_polynomial);
+inline constexpr auto crc32_tables = make_crc32_tables(crc32_polynomial);
+
+/**
+ * @brief Portable slicing-by-8 CRC32 update.
+ * Works with inverted (raw register) crc value.
+ * @param tables Tables for polynomial.
+ * @param crc Raw crc register.
+ * @param data Data.
+ * @param size Size in bytes.
+ */
+inline uint32_t crc32_slicing_by_8(const std::array<std::array<uint32_t, 256>, 8>& tables,
+                                   uint32_t crc,
+                                   const uint8_t* data,
+                                   std::size_t size) {
+    while (size >= 8) {
+        uint32_t low = (uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24)) ^ crc;
+        uint32_t high = uint32_t(data[4]) | (uint32_t(data[5]) << 8) | (uint32_t(data[6]) << 16) | (uint32_t(data[7]) << 24);
+
+        crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24] ^
+              tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+
+        data += 8;
+        size -= 8;
+    }
+
+    while (size--) {
+        crc = (crc >> 8) ^ tables[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Multiplication of two polynomials modulo
+ * reflected CRC32 polynomial.
+ */
+inline uint32_t crc32_multiply_mod(uint32_t a, uint32_t b, uint32_t polynomial) {
+    uint32_t mask = uint32_t(1) << 31;
+    uint32_t product = 0;
+
+    for (;;) {
+        if (a & mask) {
+            product ^= b;
+
+            if ((a & (mask - 1)) == 0) {
+                break;
+            }
+        }
+
+        mask >>= 1;
+        b = (b & 1) ? (b >> 1) ^ polynomial : b >> 1;
+    }
+
+    return product;
+}
+
+/**
+ * @brief Calculation of x^(8 * size) modulo
+ * reflected CRC32 polynomial.
+ */
+inline uint32_t crc32_shift_bytes(std::size_t size, uint32_t polynomial) {
+    // x^(2^k) for k = 3 (one byte) and up
+    uint32_t power = crc32_multiply_mod(uint32_t(1) << 30, uint32_t(1) << 30, polynomial);
+    power = crc32_multiply_mod(power, power, polynomial);
+    power = crc32_multiply_mod(power, power, polynomial);
+
+    uint32_t result = uint32_t(1) << 31;
+
+    while (size) {
+        if (size & 1) {
+            result = crc32_multiply_mod(power, result, polynomial);
+        }
+
+        size >>= 1;
+        power = crc32_multiply_mod(power, power, polynomial);
+    }
+
+    return result;
+}
+
+#if defined(BA_SIMD_SSE42)
+/**
+ * @brief CRC32C update with SSE4.2 `crc32` instruction.
+ * Works with inverted (raw register) crc value.
+ */
+inline uint32_t crc32c_hardware(uint32_t crc, const uint8_t* data, std::size_t size) {
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t crc64 = crc;
+
+    // Three independent streams hide instruction latency
+    // and are merged with polynomial shift.
+    constexpr std::size_t stream = 4096;
+
+    while (size >= stream * 3) {
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+
+        for (std::size_t i = 0; i < stream; i += 8) {
+            crc64 = _mm_crc32_u64(crc64, load<uint64_t>(data + i));
+            crc1 = _mm_crc32_u64(crc1, load<uint64_t>(data + stream + i));
+            crc2 = _mm_crc32_u64(crc2, load<uint64_t>(data + stream * 2 + i));
+        }
+
+        static const uint32_t shift = crc32_shift_bytes(stream, crc32c_polynomial);
+
+        crc64 = crc32_multiply_mod(shift, uint32_t(crc64), crc32c_polynomial) ^ crc1;
+        crc64 = crc32_multiply_mod(shift, uint32_t(crc64), crc32c_polynomial) ^ crc2;
+
+        data += stream * 3;
+        size -= stream * 3;
+    }
+
+    while (size >= 8) {
+        crc64 = _mm_crc32_u64(crc64, load<uint64_t>(data));
+        data += 8;
+        size -= 8;
+    }
+
+    crc = uint32_t(crc64);
+#endif
+
+    while (size >= 4) {
+        crc = _mm_crc32_u32(crc, load<uint32_t>(data));
+        data += 4;
+        size -= 4;
+    }
+
+    while (size--) {
+        crc = _mm_crc32_u8(crc, *data++);
+    }
+
+    return crc;
+}
+#endif
+
+#if defined(BA_SIMD_PCLMUL) && defined(BA_SIMD_SSE41)
+/**
+ * @brief CRC32 (IEEE) update with PCLMULQDQ folding.
+ * Works with inverted (raw register) crc value.
+ * Size has to be at least 64 bytes and multiple of 16.
+ */
+inline uint32_t crc32_folding(uint32_t crc, const uint8_t* data, std::size_t size) {
+    // Bit-reflected folding and Barrett constants for
+    // polynomial 0x104C11DB7.
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163cd6124);
+    const __m128i barrett = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+    __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+    __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+    __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(int(crc)));
+
+    data += 64;
+    size -= 64;
+
+    // Folding by 4 blocks
+    while (size >= 64) {
+        __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+
+        data += 64;
+        size -= 64;
+    }
+
+    // Folding into single block
+    auto fold = [&k3k4](__m128i accumulator, __m128i next) {
+        __m128i low = _mm_clmulepi64_si128(accumulator, k3k4, 0x00);
+        __m128i high = _mm_clmulepi64_si128(accumulator, k3k4, 0x11);
+        return _mm_xor_si128(_mm_xor_si128(high, next), low);
+    };
+
+    x1 = fold(x1, x2);
+    x1 = fold(x1, x3);
+    x1 = fold(x1, x4);
+
+    while (size >= 16) {
+        x1 = fold(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+
+        data += 16;
+        size -= 16;
+    }
+
+    // 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, barrett, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, barrett, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return uint32_t(_mm_extract_epi32(x1, 1));
+}
+#endif
+
+constexpr uint32_t adler32_base = 65521;
+
+// Maximal amount of bytes before 32 bit sums overflow
+constexpr std::size_t adler32_nmax = 5552;
+
+/**
+ * @brief Portable Adler-32 update.
+ */
+inline uint32_t adler32_portable(uint32_t adler, const uint8_t* data, std::size_t size) {
+    uint32_t s1 = adler & 0xFFFF;
+    uint32_t s2 = adler >> 16;
+
+    while (size) {
+        std::size_t block = size < adler32_nmax ? size : adler32_nmax;
+        size -= block;
+
+        while (block >= 8) {
+            s1 += data[0];
+            s2 += s1;
+            s1 += data[1];
+            s2 += s1;
+            s1 += data[2];
+            s2 += s1;
+            s1 += data[3];
+            s2 += s1;
+            s1 += data[4];
+            s2 += s1;
+            s1 += data[5];
+            s2 += s1;
+            s1 += data[6];
+            s2 += s1;
+            s1 += data[7];
+            s2 += s1;
+
+            data += 8;
+            block -= 8;
+        }
+
+        while (block--) {
+            s1 += *data++;
+            s2 += s1;
+        }
+
+        s1 %= adler32_base;
+        s2 %= adler32_base;
+    }
+
+    return s1 | (s2 << 16);
+}
+
+#if defined(BA_SIMD_SSSE3)
+/**
+ * @brief Adler-32 update with SSSE3 multiply-add
+ * over 32 byte blocks.
+ */
+inline uint32_t adler32_simd(uint32_t adler, const uint8_t* data, std::size_t size) {
+    constexpr std::size_t block_size = 32;
+
+    uint32_t s1 = adler & 0xFFFF;
+    uint32_t s2 = adler >> 16;
+
+    std::size_t blocks = size / block_size;
+    size -= blocks * block_size;
+
+    const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+    const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+
+    while (blocks) {
+        std::size_t n = adler32_nmax / block_size;
+
+        if (n > blocks) {
+            n = blocks;
+        }
+
+        blocks -= n;
+
+        __m128i prefix = _mm_set_epi32(0, 0, 0, int(s1 * n));
+        __m128i v_s2 = _mm_set_epi32(0, 0, 0, int(s2));
+        __m128i v_s1 = _mm_setzero_si128();
+
+        do {
+            const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+
+            prefix = _mm_add_epi32(prefix, v_s1);
+
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes1, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+
+            v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(bytes2, zero));
+            v_s2 = _mm_add_epi32(v_s2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+
+            data += block_size;
+        } while (--n);
+
+        v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(prefix, 5));
+
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, _MM_SHUFFLE(1, 0, 3, 2)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(2, 3, 0, 1)));
+        v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, _MM_SHUFFLE(1, 0, 3, 2)));
+
+        s1 = (s1 + uint32_t(_mm_cvtsi128_si32(v_s1))) % adler32_base;
+        s2 = uint32_t(_mm_cvtsi128_si32(v_s2)) % adler32_base;
+    }
+
+    return adler32_portable(s1 | (s2 << 16), data, size);
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief Function for calculating CRC32C (Castagnoli)
+ * checksum. Uses SSE4.2 `crc32` instruction if available.
+ * @param data Pointer to data.
+ * @param size Size in bytes.
+ * @param crc Checksum of previous data for incremental
+ * calculation.
+ * @return Checksum.
+ */
+inline uint32_t crc32c(const void* data, std::size_t size, uint32_t crc = 0) {
+    auto bytes = static_cast<const uint8_t*>(data);
+
+#if defined(BA_SIMD_SSE42)
+    return ~detail::crc32c_hardware(~crc, bytes, size);
+#else
+    return ~detail::crc32_slicing_by_8(detail::crc32c_tables, ~crc, bytes, size);
+#endif
+}
+
+/**
+ * @brief Function for calculating CRC32 (IEEE 802.3)
+ * checksum. Uses PCLMULQDQ folding if available.
+ * @param data Pointer to data.
+ * @param size Size in bytes.
+ * @param crc Checksum of previous data for incremental
+ * calculation.
+ * @return Checksum.
+ */
+inline uint32_t crc32(const void* data, std::size_t size, uint32_t crc = 0) {
+    auto bytes = static_cast<const uint8_t*>(data);
+
+    crc = ~crc;
+
+#if defined(BA_SIMD_PCLMUL) && defined(BA_SIMD_SSE41)
+    if (size >= 64) {
+        std::size_t folded = size & ~std::size_t(15);
+
+        crc = detail::crc32_folding(crc, bytes, folded);
+
+        bytes += folded;
+        size -= folded;
+    }
+#endif
+
+    return ~detail::crc32_slicing_by_8(detail::crc32_tables, crc, bytes, size);
+}
+
+/**
+ * @brief Function for calculating Adler-32 checksum.
+ * Uses SSSE3 if available.
+ * @param data Pointer to data.
+ * @param size Size in bytes.
+ * @param adler Checksum of previous data for incremental
+ * calculation.
+ * @return Checksum.
+ */
+inline uint32_t adler32(const void* data, std::size_t size, uint32_t adler = 1) {
+    auto bytes = static_cast<const uint8_t*>(data);
+
+#if defined(BA_SIMD_SSSE3)
+    return detail::adler32_simd(adler, bytes, size);
+#else
+    return detail::adler32_portable(adler, bytes, size);
+#endif
+}
+
+/**
+ * @brief Function for combining CRC32C checksums of two
+ * consecutive chunks.
+ * @param crc1 Checksum of first chunk.
+ * @param crc2 Checksum of second chunk.
+ * @param size2 Size of second chunk in bytes.
+ * @return Checksum of both chunks.
+ */
+inline uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, std::size_t size2) {
+    return detail::crc32_multiply_mod(detail::crc32_shift_bytes(size2, detail::crc32c_polynomial), crc1, detail::crc32c_polynomial) ^
+           crc2;
+}
+
+/**
+ * @brief Function for combining CRC32 checksums of two
+ * consecutive chunks.
+ * @param crc1 Checksum of first chunk.
+ * @param crc2 Checksum of second chunk.
+ * @param size2 Size of second chunk in bytes.
+ * @return Checksum of both chunks.
+ */
+inline uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, std::size_t size2) {
+    return detail::crc32_multiply_mod(detail::crc32_shift_bytes(size2, detail::crc32_polynomial), crc1, detail::crc32_polynomial) ^
+           crc2;
+}
+
+/**
+ * @brief Function for combining Adler-32 checksums of two
+ * consecutive chunks.
+ * @param adler1 Checksum of first chunk.
+ * @param adler2 Checksum of second chunk.
+ * @param size2 Size of second chunk in bytes.
+ * @return Checksum of both chunks.
+ */
+inline uint32_t adler32_combine(uint32_t adler1, uint32_t adler2, std::size_t size2) {
+    constexpr uint32_t base = detail::adler32_base;
+
+    auto remainder = uint32_t(size2 % base);
+    uint32_t sum1 = adler1 & 0xFFFF;
+    uint32_t sum2 = uint32_t((uint64_t(remainder) * sum1) % base);
+
+    sum1 += (adler2 & 0xFFFF) + base - 1;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + base - remainder;
+
+    if (sum1 >= base) {
+        sum1 -= base;
+    }
+
+    if (sum1 >= base) {
+        sum1 -= base;
+    }
+
+    if (sum2 >= base * 2) {
+        sum2 -= base * 2;
+    }
+
+    if (sum2 >= base) {
+        sum2 -= base;
+    }
+
+    return sum1 | (sum2 << 16);
+}
+
+/**
+ * @brief Function for calculating CRC32C checksum
+ * of byte array.
+ */
+template <typename ValueType, typename Allocator>
+uint32_t crc32c(const bytearray_reader<ValueType, Allocator>& reader, uint32_t crc = 0) {
+    return crc32c(reader.data(), reader.size(), crc);
+}
+
+/**
+ * @brief Function for calculating CRC32C checksum
+ * of byte array view.
+ */
+template <typename ValueType, typename Allocator>
+uint32_t crc32c(const bytearray_view<ValueType, Allocator>& view, uint32_t crc = 0) {
+    return crc32c(view.data(), view.size(), crc);
+}
+
+/**
+ * @brief Function for calculating CRC32 checksum
+ * of byte array.
+ */
+template <typename ValueType, typename Allocator>
+uint32_t crc32(const bytearray_reader<ValueType, Allocator>& reader, uint32_t crc = 0) {
+    return crc32(reader.data(), reader.size(), crc);
+}
+
+/**
+ * @brief Function for calculating CRC32 checksum
+ * of byte array view.
+ */
+template <typename ValueType, typename Allocator>
+uint32_t crc32(const bytearray_view<ValueType, Allocator>& view, uint32_t crc = 0) {
+    return crc32(view.data(), view.size(), crc);
+}
+
+/**
+ * @brief Function for calculating Adler-32 checksum
+ * of byte array.
+ */
+template <typename ValueType, typename Allocator>
+uint32_t adler32(const bytearray_reader<ValueType, Allocator>& reader, uint32_t adler = 1) {
+    return adler32(reader.data(), reader.size(), adler);
+}
+
+/**
+ * @brief Function for calculating Adler-32 checksum
+ * of byte array view.
+ */
+template <typename ValueType, typename Allocator>
+uint32_t adler32(const bytearray_view<ValueType, Allocator>& view, uint32_t adler = 1) {
+    return adler32(view.data(), view.size(), adler);
+}
+
+}  // namespace ba
@@ -0,0 +1,439 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_view.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace ba {
+
+namespace detail {
+
+/**
+ * @brief Function for building Gear hash table
+ * (splitmix64 sequence, so chunk boundaries are the same
+ * in all builds).
+ */
+constexpr std::array<uint64_t, 256> make_gear_table() {
+    std::array<uint64_t, 256> result{};
+    uint64_t state = 0x4245415247454152ULL;
+
+    for (auto& value : result) {
+        state += 0x9E3779B97F4A7C15ULL;
+
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+        value = z ^ (z >> 31);
+    }
+
+    return result;
+}
+
+inline constexpr auto gear_table = make_gear_table();
+
+}  // namespace detail
+
+/**
+ * @brief Class, that implements content defined
+ * chunking (FastCDC). Gear hash `h = (h << 1) + gear[byte]`
+ * depends on last 64 bytes only, first `min` bytes of
+ * chunk are skipped, before `avg` harder mask is used,
+ * after it - easier one (normalized chunking), so chunk
+ * sizes are concentrated around `avg`. Masks use high
+ * hash bits, that depend on the whole window.
+ */
+class chunker {
+public:
+    static constexpr std::size_t default_min_size = 2048;
+    static constexpr std::size_t default_avg_size = 8192;
+    static constexpr std::size_t default_max_size = 65536;
+
+    /**
+     * @brief Class, that implements chunking of input,
+     * split into several blocks. Hash and size of current
+     * chunk are carried across blocks, so boundaries are
+     * the same, as for contiguous input. Offsets are
+     * counted from stream start.
+     */
+    class stream {
+    public:
+        /**
+         * @brief Constructor.
+         * @param chunker Chunker. Has to outlive stream.
+         */
+        explicit stream(const chunker& chunker)
+            : m_chunker(&chunker)
+            , m_hash(0)
+            , m_length(0)
+            , m_offset(0) {}
+
+        /**
+         * @brief Method for processing next block.
+         * @param data Pointer to block.
+         * @param size Block size.
+         * @param callback Callable with `(offset, size)` arguments,
+         * that is called for every finished chunk.
+         */
+        template <typename Callback>
+        void feed(const void* data, std::size_t size, Callback&& callback) {
+            auto input = static_cast<const uint8_t*>(data);
+
+            while (size != 0) {
+                auto start = m_offset - m_length;
+                auto used = m_chunker->find(input, size, m_length, m_hash);
+
+                input += used;
+                size -= used;
+                m_offset += used;
+
+                if (m_length == 0) {
+                    callback(start, m_offset - start);
+                }
+            }
+        }
+
+        /**
+         * @brief Method for processing next block, that is
+         * byte array or view.
+         */
+        template <typename Block, typename Callback, typename = detail::enable_if_byte_sequences<Block, Block>>
+        void feed(const Block& block, Callback&& callback) {
+            feed(detail::byte_data(block), detail::byte_size(block), callback);
+        }
+
+        /**
+         * @brief Method for finishing input. Last not
+         * finished chunk is reported, if it's not empty.
+         */
+        template <typename Callback>
+        void finish(Callback&& callback) {
+            if (m_length != 0) {
+                callback(m_offset - m_length, m_length);
+            }
+
+            m_length = 0;
+            m_hash = 0;
+        }
+
+        /**
+         * @brief Method for getting amount of processed bytes.
+         */
+        std::size_t offset() const { return m_offset; }
+
+        /**
+         * @brief Method for resetting stream to initial state.
+         */
+        void reset() {
+            m_hash = 0;
+            m_length = 0;
+            m_offset = 0;
+        }
+
+    private:
+        const chunker* m_chunker;
+        uint64_t m_hash;
+        std::size_t m_length;
+        std::size_t m_offset;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param minSize Minimal chunk size.
+     * @param avgSize Average (normal) chunk size.
+     * @param maxSize Maximal chunk size.
+     * @param normalization Normalization level: amount of
+     * bits, added to (removed from) mask before (after) `avgSize`.
+     */
+    explicit chunker(std::size_t minSize = default_min_size,
+                     std::size_t avgSize = default_avg_size,
+                     std::size_t maxSize = default_max_size,
+                     unsigned normalization = 2)
+        : m_min(minSize)
+        , m_avg(avgSize)
+        , m_max(maxSize)
+        , m_maskSmall(0)
+        , m_maskLarge(0) {
+        assert(minSize <= avgSize && avgSize <= maxSize && maxSize > 0 && "Sizes have to be ordered.");
+
+        auto bits = avgSize == 0 ? 0u : detail::highest_bit(avgSize);
+
+        assert(bits + normalization < 64 && bits >= normalization && "Wrong normalization level.");
+
+        m_maskSmall = mask(bits + normalization);
+        m_maskLarge = mask(bits - normalization);
+    }
+
+    std::size_t min_size() const { return m_min; }
+
+    std::size_t avg_size() const { return m_avg; }
+
+    std::size_t max_size() const { return m_max; }
+
+    /**
+     * @brief Method for getting size of first chunk.
+     * @param data Pointer to data.
+     * @param size Size of data.
+     * @return Chunk size, `size` if cut point wasn't found.
+     */
+    std::size_t cut(const void* data, std::size_t size) const {
+        uint64_t hash = 0;
+        std::size_t length = 0;
+
+        return find(static_cast<const uint8_t*>(data), size, length, hash);
+    }
+
+    /**
+     * @brief Method for splitting memory block (mapped
+     * file for example) to chunks.
+     * @param callback Callable with `(offset, size)` arguments.
+     */
+    template <typename Callback>
+    void split(const void* data, std::size_t size, Callback&& callback) const {
+        auto input = static_cast<const uint8_t*>(data);
+
+        for (std::size_t offset = 0; offset < size;) {
+            auto chunk = cut(input + offset, size - offset);
+
+            callback(offset, chunk);
+
+            offset += chunk;
+        }
+    }
+
+    /**
+     * @brief Method for creating stream chunker.
+     */
+    stream make_stream() const { return stream(*this); }
+
+private:
+    friend class stream;
+
+    static uint64_t mask(unsigned bits) { return bits == 0 ? 0 : ~uint64_t(0) << (64 - bits); }
+
+    /**
+     * @brief Method for searching cut point.
+     * @param data Pointer to data.
+     * @param size Size of data.
+     * @param length Size of current chunk before data,
+     * it's set to 0 if cut point is found.
+     * @param hash Hash state of current chunk.
+     * @return Amount of consumed bytes.
+     */
+    std::size_t find(const uint8_t* data, std::size_t size, std::size_t& length, uint64_t& hash) const {
+        auto base = length;
+        std::size_t position = 0;
+
+        // Cut point can't be before minimal size
+        if (base < m_min) {
+            position = std::min(m_min - base, size);
+        }
+
+        auto normal = std::max(position, std::min(size, m_avg > base ? m_avg - base : 0));
+        auto limit = std::min(size, m_max - base);
+
+        auto found = scan(data, position, normal, hash, m_maskSmall) || scan(data, position, limit, hash, m_maskLarge) ||
+                     base + position == m_max;
+
+        if (found) {
+            length = 0;
+            hash = 0;
+        } else {
+            length = base + position;
+        }
+
+        return position;
+    }
+
+    /**
+     * @brief Method for Gear hash scan.
+     * @param position Start position, it's set to position
+     * after cut point or to `end`.
+     * @return Is cut point found.
+     */
+    static bool scan(const uint8_t* data, std::size_t& position, std::size_t end, uint64_t& hash, uint64_t mask) {
+        auto value = hash;
+        auto current = position;
+
+        // 4 bytes per branch, exact cut point is found below
+        for (; current + 4 <= end; current += 4) {
+            auto first = (value << 1) + detail::gear_table[data[current]];
+            auto second = (first << 1) + detail::gear_table[data[current + 1]];
+            auto third = (second << 1) + detail::gear_table[data[current + 2]];
+            auto fourth = (third << 1) + detail::gear_table[data[current + 3]];
+
+            if (((first & mask) == 0) | ((second & mask) == 0) | ((third & mask) == 0) | ((fourth & mask) == 0)) {
+                break;
+            }
+
+            value = fourth;
+        }
+
+        while (current < end) {
+            value = (value << 1) + detail::gear_table[data[current++]];
+
+            if ((value & mask) == 0) {
+                hash = value;
+                position = current;
+                return true;
+            }
+        }
+
+        hash = value;
+        position = std::max(position, end);
+
+        return false;
+    }
+
+    std::size_t m_min;
+    std::size_t m_avg;
+    std::size_t m_max;
+    uint64_t m_maskSmall;
+    uint64_t m_maskLarge;
+};
+
+/**
+ * @brief Class, that describes lazy range of content
+ * defined chunks of byte array. Every chunk is
+ * `bytearray_view` over original storage. Empty input
+ * gives no chunks. Byte array must not be modified and
+ * chunker has to outlive range.
+ */
+template <typename ValueType, typename Allocator>
+class chunk_range {
+    using processor = bytearray_processor<ValueType, Allocator>;
+
+public:
+    using size_type = typename processor::size_type;
+    using view = bytearray_view<ValueType, Allocator>;
+
+    /**
+     * @brief Input iterator over chunks.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = view;
+
+        iterator()
+            : m_range(nullptr)
+            , m_start(0)
+            , m_end(0) {}
+
+        /**
+         * @brief Method for getting current chunk.
+         */
+        view operator*() const { return view(*m_range->m_processor, m_range->m_offset + m_start, m_end - m_start); }
+
+        /**
+         * @brief Method for getting offset of current chunk
+         * from range start.
+         */
+        size_type offset() const { return m_start; }
+
+        iterator& operator++() {
+            m_start = m_end;
+
+            if (m_start == m_range->m_size) {
+                m_range = nullptr;
+                m_start = 0;
+                m_end = 0;
+            } else {
+                m_end = m_start + m_range->cut(m_start);
+            }
+
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const iterator& rhs) const { return m_range == rhs.m_range && m_start == rhs.m_start; }
+
+        bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+    private:
+        friend class chunk_range;
+
+        explicit iterator(const chunk_range* range)
+            : m_range(range->m_size == 0 ? nullptr : range)
+            , m_start(0)
+            , m_end(range->m_size == 0 ? 0 : range->cut(0)) {}
+
+        const chunk_range* m_range;
+        size_type m_start;
+        size_type m_end;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param processor Byte array.
+     * @param offset Start of chunked region.
+     * @param size Size of chunked region.
+     * @param chunker Chunker.
+     */
+    chunk_range(processor& processor, size_type offset, size_type size, const chunker& chunker)
+        : m_processor(&processor)
+        , m_offset(offset)
+        , m_size(size)
+        , m_chunker(&chunker) {}
+
+    iterator begin() const { return iterator(this); }
+
+    iterator end() const { return iterator(); }
+
+private:
+    size_type cut(size_type position) const {
+        auto data = reinterpret_cast<const uint8_t*>(m_processor->data()) + m_offset + position;
+
+        return m_chunker->cut(data, m_size - position);
+    }
+
+    processor* m_processor;
+    size_type m_offset;
+    size_type m_size;
+    const chunker* m_chunker;
+};
+
+/**
+ * @brief Function for splitting byte array to content
+ * defined chunks.
+ * @param array Byte array.
+ * @param chunker Chunker.
+ * @return Lazy range of views.
+ */
+template <typename ValueType, typename Allocator>
+chunk_range<ValueType, Allocator> chunks(bytearray_processor<ValueType, Allocator>& array, const chunker& chunker) {
+    return chunk_range<ValueType, Allocator>(array, 0, array.size(), chunker);
+}
+
+/**
+ * @brief Function for splitting byte array view to
+ * content defined chunks.
+ * @param view Byte array view.
+ * @param chunker Chunker.
+ * @return Lazy range of subviews.
+ */
+template <typename ValueType, typename Allocator>
+chunk_range<ValueType, Allocator> chunks(bytearray_view<ValueType, Allocator>& view, const chunker& chunker) {
+    auto offset = std::size_t(view.data() - view.bytearray().data());
+
+    return chunk_range<ValueType, Allocator>(view.bytearray(), offset, view.size(), chunker);
+}
+
+}  // namespace ba
@@ -0,0 +1,239 @@
+#pragma once
+
+// ba
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if __cplusplus > 201703L && __has_include(<compare>)
+#include <compare>
+#endif
+
+namespace ba {
+
+template <typename ValueType, typename Allocator>
+class bytearray_reader;
+
+template <typename ValueType, typename Allocator>
+class bytearray_processor;
+
+template <typename ValueType, typename Allocator>
+class bytearray_view;
+
+template <typename Allocator>
+class bytearray;
+
+namespace detail {
+
+/**
+ * @brief Trait for types, that describe contiguous
+ * byte sequence (byte array, it's processor, reader or view).
+ */
+template <typename T>
+struct is_byte_sequence : std::false_type {};
+
+template <typename ValueType, typename Allocator>
+struct is_byte_sequence<bytearray_reader<ValueType, Allocator>> : std::true_type {};
+
+template <typename ValueType, typename Allocator>
+struct is_byte_sequence<bytearray_processor<ValueType, Allocator>> : std::true_type {};
+
+template <typename ValueType, typename Allocator>
+struct is_byte_sequence<bytearray_view<ValueType, Allocator>> : std::true_type {};
+
+template <typename Allocator>
+struct is_byte_sequence<bytearray<Allocator>> : std::true_type {};
+
+template <typename Lhs, typename Rhs>
+using enable_if_byte_sequences = typename std::enable_if<is_byte_sequence<Lhs>::value && is_byte_sequence<Rhs>::value>::type;
+
+/**
+ * @brief Function for getting pointer to first byte of sequence.
+ */
+template <typename ValueType, typename Allocator>
+const uint8_t* byte_data(const bytearray_reader<ValueType, Allocator>& reader) {
+    return reinterpret_cast<const uint8_t*>(reader.data());
+}
+
+template <typename ValueType, typename Allocator>
+const uint8_t* byte_data(const bytearray_view<ValueType, Allocator>& view) {
+    return reinterpret_cast<const uint8_t*>(view.data());
+}
+
+/**
+ * @brief Function for getting size of sequence in bytes.
+ */
+template <typename ValueType, typename Allocator>
+std::size_t byte_size(const bytearray_reader<ValueType, Allocator>& reader) {
+    return reader.size();
+}
+
+template <typename ValueType, typename Allocator>
+std::size_t byte_size(const bytearray_view<ValueType, Allocator>& view) {
+    return view.size();
+}
+
+/**
+ * @brief Function for searching first differing byte
+ * of two memory blocks.
+ * @return Offset of first difference or `size`.
+ */
+inline std::size_t mismatch_bytes(const uint8_t* lhs, const uint8_t* rhs, std::size_t size) {
+    std::size_t offset = 0;
+
+#if defined(BA_SIMD_AVX2)
+    for (; offset + 32 <= size; offset += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + offset));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + offset));
+        auto mask = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+
+        if (mask != 0xFFFFFFFF) {
+            return offset + count_trailing_zeros(~mask);
+        }
+    }
+#endif
+
+#if defined(BA_SIMD_SSE2)
+    for (; offset + 16 <= size; offset += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + offset));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + offset));
+        auto mask = uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+
+        if (mask != 0xFFFF) {
+            return offset + count_trailing_zeros(~mask & 0xFFFF);
+        }
+    }
+#endif
+
+    for (; offset + 8 <= size; offset += 8) {
+        if (load<uint64_t>(lhs + offset) != load<uint64_t>(rhs + offset)) {
+            break;
+        }
+    }
+
+    for (; offset < size; ++offset) {
+        if (lhs[offset] != rhs[offset]) {
+            break;
+        }
+    }
+
+    return offset;
+}
+
+/**
+ * @brief Lexicographical comparison of two memory blocks.
+ * @return Negative, zero or positive value.
+ */
+inline int compare_bytes(const uint8_t* lhs, std::size_t lhsSize, const uint8_t* rhs, std::size_t rhsSize) {
+    std::size_t common = lhsSize < rhsSize ? lhsSize : rhsSize;
+
+    if (common) {
+        int result = std::memcmp(lhs, rhs, common);
+
+        if (result) {
+            return result;
+        }
+    }
+
+    return lhsSize < rhsSize ? -1 : (lhsSize > rhsSize ? 1 : 0);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for searching first differing byte of
+ * two memory blocks.
+ * @param lhs First block.
+ * @param rhs Second block.
+ * @param size Size of both blocks.
+ * @return Offset of first difference or `size` if blocks are equal.
+ */
+inline std::size_t mismatch(const void* lhs, const void* rhs, std::size_t size) {
+    return detail::mismatch_bytes(static_cast<const uint8_t*>(lhs), static_cast<const uint8_t*>(rhs), size);
+}
+
+/**
+ * @brief Function for searching first differing byte of
+ * two byte sequences (byte arrays, readers or views).
+ * @return Offset of first difference. If one sequence is
+ * prefix of another - size of shorter one.
+ */
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+std::size_t mismatch(const Lhs& lhs, const Rhs& rhs) {
+    auto lhsSize = detail::byte_size(lhs);
+    auto rhsSize = detail::byte_size(rhs);
+
+    return detail::mismatch_bytes(detail::byte_data(lhs), detail::byte_data(rhs), lhsSize < rhsSize ? lhsSize : rhsSize);
+}
+
+/**
+ * @brief Function for lexicographical comparison of
+ * two memory blocks.
+ * @return Negative value if `lhs` is less, zero if blocks
+ * are equal and positive value otherwise.
+ */
+inline int compare(const void* lhs, std::size_t lhsSize, const void* rhs, std::size_t rhsSize) {
+    return detail::compare_bytes(static_cast<const uint8_t*>(lhs), lhsSize, static_cast<const uint8_t*>(rhs), rhsSize);
+}
+
+/**
+ * @brief Function for lexicographical comparison of
+ * two byte sequences (byte arrays, readers or views).
+ * @return Negative value if `lhs` is less, zero if sequences
+ * are equal and positive value otherwise.
+ */
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+int compare(const Lhs& lhs, const Rhs& rhs) {
+    return detail::compare_bytes(detail::byte_data(lhs), detail::byte_size(lhs), detail::byte_data(rhs), detail::byte_size(rhs));
+}
+
+/**
+ * @brief Equality of byte sequences.
+ */
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bool operator==(const Lhs& lhs, const Rhs& rhs) {
+    auto size = detail::byte_size(lhs);
+
+    return size == detail::byte_size(rhs) && (size == 0 || std::memcmp(detail::byte_data(lhs), detail::byte_data(rhs), size) == 0);
+}
+
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bool operator!=(const Lhs& lhs, const Rhs& rhs) {
+    return !(lhs == rhs);
+}
+
+#if defined(__cpp_lib_three_way_comparison)
+/**
+ * @brief Three-way comparison of byte sequences.
+ */
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+std::strong_ordering operator<=>(const Lhs& lhs, const Rhs& rhs) {
+    return compare(lhs, rhs) <=> 0;
+}
+#else
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bool operator<(const Lhs& lhs, const Rhs& rhs) {
+    return compare(lhs, rhs) < 0;
+}
+
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bool operator<=(const Lhs& lhs, const Rhs& rhs) {
+    return compare(lhs, rhs) <= 0;
+}
+
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bool operator>(const Lhs& lhs, const Rhs& rhs) {
+    return compare(lhs, rhs) > 0;
+}
+
+template <typename Lhs, typename Rhs, typename = detail::enable_if_byte_sequences<Lhs, Rhs>>
+bool operator>=(const Lhs& lhs, const Rhs& rhs) {
+    return compare(lhs, rhs) >= 0;
+}
+#endif
+
+}  // namespace ba
@@ -0,0 +1,195 @@
+#pragma once
+
+// ba
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ba {
+namespace detail {
+
+#if defined(BA_SIMD_AVX2)
+using bitwise_vector = __m256i;
+
+constexpr std::size_t bitwise_width = 32;
+
+inline bitwise_vector bitwise_load(const uint8_t* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+inline void bitwise_store(uint8_t* data, bitwise_vector value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value); }
+#elif defined(BA_SIMD_SSE2)
+using bitwise_vector = __m128i;
+
+constexpr std::size_t bitwise_width = 16;
+
+inline bitwise_vector bitwise_load(const uint8_t* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+inline void bitwise_store(uint8_t* data, bitwise_vector value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value); }
+#else
+constexpr std::size_t bitwise_width = 8;
+#endif
+
+struct bitwise_xor {
+    static uint64_t apply(uint64_t lhs, uint64_t rhs) { return lhs ^ rhs; }
+#if defined(BA_SIMD_AVX2)
+    static __m256i apply(__m256i lhs, __m256i rhs) { return _mm256_xor_si256(lhs, rhs); }
+#elif defined(BA_SIMD_SSE2)
+    static __m128i apply(__m128i lhs, __m128i rhs) { return _mm_xor_si128(lhs, rhs); }
+#endif
+};
+
+struct bitwise_and {
+    static uint64_t apply(uint64_t lhs, uint64_t rhs) { return lhs & rhs; }
+#if defined(BA_SIMD_AVX2)
+    static __m256i apply(__m256i lhs, __m256i rhs) { return _mm256_and_si256(lhs, rhs); }
+#elif defined(BA_SIMD_SSE2)
+    static __m128i apply(__m128i lhs, __m128i rhs) { return _mm_and_si128(lhs, rhs); }
+#endif
+};
+
+struct bitwise_or {
+    static uint64_t apply(uint64_t lhs, uint64_t rhs) { return lhs | rhs; }
+#if defined(BA_SIMD_AVX2)
+    static __m256i apply(__m256i lhs, __m256i rhs) { return _mm256_or_si256(lhs, rhs); }
+#elif defined(BA_SIMD_SSE2)
+    static __m128i apply(__m128i lhs, __m128i rhs) { return _mm_or_si128(lhs, rhs); }
+#endif
+};
+
+/**
+ * @brief Function for applying bitwise operation to
+ * 2 memory blocks. Output may be equal to `lhs` or `rhs`
+ * (in place), but must not partially overlap them.
+ * Pointers may have any alignment.
+ */
+template <typename Operation>
+void bitwise(uint8_t* output, const uint8_t* lhs, const uint8_t* rhs, std::size_t size) {
+    std::size_t offset = 0;
+
+#if defined(BA_SIMD_AVX2) || defined(BA_SIMD_SSE2)
+    for (; offset + 4 * bitwise_width <= size; offset += 4 * bitwise_width) {
+        for (std::size_t i = 0; i < 4 * bitwise_width; i += bitwise_width) {
+            bitwise_store(output + offset + i, Operation::apply(bitwise_load(lhs + offset + i), bitwise_load(rhs + offset + i)));
+        }
+    }
+
+    for (; offset + bitwise_width <= size; offset += bitwise_width) {
+        bitwise_store(output + offset, Operation::apply(bitwise_load(lhs + offset), bitwise_load(rhs + offset)));
+    }
+#endif
+
+    for (; offset + 8 <= size; offset += 8) {
+        store<uint64_t>(output + offset, Operation::apply(load<uint64_t>(lhs + offset), load<uint64_t>(rhs + offset)));
+    }
+
+    for (; offset < size; ++offset) {
+        output[offset] = uint8_t(Operation::apply(lhs[offset], rhs[offset]));
+    }
+}
+
+/**
+ * @brief Function for inverting of all bits.
+ */
+inline void bitwise_not(uint8_t* output, const uint8_t* input, std::size_t size) {
+    std::size_t offset = 0;
+
+#if defined(BA_SIMD_AVX2)
+    auto ones = _mm256_set1_epi8(-1);
+
+    for (; offset + bitwise_width <= size; offset += bitwise_width) {
+        bitwise_store(output + offset, _mm256_xor_si256(bitwise_load(input + offset), ones));
+    }
+#elif defined(BA_SIMD_SSE2)
+    auto ones = _mm_set1_epi8(-1);
+
+    for (; offset + bitwise_width <= size; offset += bitwise_width) {
+        bitwise_store(output + offset, _mm_xor_si128(bitwise_load(input + offset), ones));
+    }
+#endif
+
+    for (; offset + 8 <= size; offset += 8) {
+        store<uint64_t>(output + offset, ~load<uint64_t>(input + offset));
+    }
+
+    for (; offset < size; ++offset) {
+        output[offset] = uint8_t(~input[offset]);
+    }
+}
+
+/**
+ * @brief Function for XOR with repeating key.
+ * Key is expanded, so every vector is XORed with
+ * unaligned load from expanded key at current phase.
+ * If key size divides vector size, phase doesn't change
+ * and pattern is loaded once.
+ * @param keyOffset Index of key byte for first input byte.
+ * @return Key offset for next byte after input.
+ */
+inline std::size_t xor_mask(uint8_t* output, const uint8_t* input, std::size_t size, const uint8_t* key, std::size_t keySize,
+                            std::size_t keyOffset) {
+    auto phase = keyOffset % keySize;
+
+    // Key, repeated to cover vector at any phase
+    uint8_t inlineKey[2 * bitwise_width + 64];
+    std::vector<uint8_t> longKey;
+
+    auto expanded = inlineKey;
+
+    if (keySize + bitwise_width > sizeof(inlineKey)) {
+        longKey.resize(keySize + bitwise_width);
+        expanded = longKey.data();
+    }
+
+    for (std::size_t i = 0; i < keySize + bitwise_width; ++i) {
+        expanded[i] = key[i % keySize];
+    }
+
+    std::size_t offset = 0;
+
+    if (bitwise_width % keySize == 0) {
+#if defined(BA_SIMD_AVX2) || defined(BA_SIMD_SSE2)
+        auto pattern = bitwise_load(expanded + phase);
+
+        for (; offset + 4 * bitwise_width <= size; offset += 4 * bitwise_width) {
+            for (std::size_t i = 0; i < 4 * bitwise_width; i += bitwise_width) {
+                bitwise_store(output + offset + i, bitwise_xor::apply(bitwise_load(input + offset + i), pattern));
+            }
+        }
+
+        for (; offset + bitwise_width <= size; offset += bitwise_width) {
+            bitwise_store(output + offset, bitwise_xor::apply(bitwise_load(input + offset), pattern));
+        }
+#else
+        auto pattern = load<uint64_t>(expanded + phase);
+
+        for (; offset + bitwise_width <= size; offset += bitwise_width) {
+            store<uint64_t>(output + offset, load<uint64_t>(input + offset) ^ pattern);
+        }
+#endif
+    } else {
+        auto step = bitwise_width % keySize;
+
+        for (; offset + bitwise_width <= size; offset += bitwise_width) {
+#if defined(BA_SIMD_AVX2) || defined(BA_SIMD_SSE2)
+            bitwise_store(output + offset, bitwise_xor::apply(bitwise_load(input + offset), bitwise_load(expanded + phase)));
+#else
+            store<uint64_t>(output + offset, load<uint64_t>(input + offset) ^ load<uint64_t>(expanded + phase));
+#endif
+            phase += step;
+
+            if (phase >= keySize) {
+                phase -= keySize;
+            }
+        }
+    }
+
+    // Phase is the same for vector and byte offsets here
+    for (std::size_t i = 0; offset < size; ++offset, ++i) {
+        output[offset] = uint8_t(input[offset] ^ expanded[phase + i]);
+    }
+
+    return (keyOffset + size) % keySize;
+}
+
+}  // namespace detail
+}  // namespace ba
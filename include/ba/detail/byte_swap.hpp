@@ -0,0 +1,81 @@
+#pragma once
+
+// ba
+#include <ba/detail/simd.hpp>
+#include <ba/endianness.hpp>
+
+// C++ STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ba {
+namespace detail {
+
+template <std::size_t Size>
+using swap_word = typename std::conditional<Size == 2, uint16_t, typename std::conditional<Size == 4, uint32_t, uint64_t>::type>::type;
+
+/**
+ * @brief Function for building shuffle, that reverses
+ * bytes of every `Size` byte element of 16 byte vector.
+ */
+template <std::size_t Size>
+constexpr std::array<uint8_t, 16> swap_shuffle() {
+    std::array<uint8_t, 16> result{};
+
+    for (std::size_t i = 0; i < 16; ++i) {
+        result[i] = uint8_t(i / Size * Size + Size - 1 - i % Size);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for reversing byte order of every
+ * `Size` byte element in place. Elements may have
+ * any alignment. 2 vectors per iteration are shuffled
+ * (AVX2/SSSE3), the rest is swapped one by one.
+ * @param data Pointer to first element.
+ * @param count Amount of elements.
+ */
+template <std::size_t Size>
+void swap_bytes(uint8_t* data, std::size_t count) {
+    static_assert(Size == 1 || Size == 2 || Size == 4 || Size == 8, "Element size has to be 1, 2, 4 or 8");
+
+    if constexpr (Size != 1) {
+        auto size = count * Size;
+        std::size_t offset = 0;
+
+#if defined(BA_SIMD_SSSE3)
+        static constexpr auto shuffleBytes = swap_shuffle<Size>();
+
+        auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffleBytes.data()));
+
+#if defined(BA_SIMD_AVX2)
+        auto wideShuffle = _mm256_broadcastsi128_si256(shuffle);
+
+        for (; offset + 64 <= size; offset += 64) {
+            auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+            auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + 32));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + offset), _mm256_shuffle_epi8(first, wideShuffle));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + offset + 32), _mm256_shuffle_epi8(second, wideShuffle));
+        }
+#endif
+
+        for (; offset + 16 <= size; offset += 16) {
+            auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + offset), _mm_shuffle_epi8(bytes, shuffle));
+        }
+#endif
+
+        for (; offset < size; offset += Size) {
+            store<swap_word<Size>>(data + offset, byte_swap(load<swap_word<Size>>(data + offset)));
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace ba
@@ -0,0 +1,149 @@
+#pragma once
+
+// ba
+#include <ba/detail/simd.hpp>
+#include <ba/endianness.hpp>
+
+// C++ STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ba {
+namespace detail {
+
+/**
+ * @brief Function for building shuffle, that takes
+ * lowest `Width` bytes of every `Lane` byte element
+ * (pack) or spreads `Width` byte values to `Lane`
+ * byte elements with zero filling (unpack).
+ */
+template <std::size_t Width, std::size_t Lane>
+constexpr std::array<uint8_t, 16> packed_shuffle(bool pack, bool bigEndian) {
+    std::array<uint8_t, 16> result{};
+
+    for (std::size_t i = 0; i < 16; ++i) {
+        result[i] = 0x80;
+    }
+
+    for (std::size_t lane = 0; lane < 16 / Lane; ++lane) {
+        for (std::size_t byte = 0; byte < Width; ++byte) {
+            // Packed bytes go from the highest one for big endian
+            auto packed = lane * Width + (bigEndian ? Width - 1 - byte : byte);
+            auto wide = lane * Lane + byte;
+
+            if (pack) {
+                result[packed] = uint8_t(wide);
+            } else {
+                result[wide] = uint8_t(packed);
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for writing `Width` lowest bytes
+ * of every value.
+ * @param values Values.
+ * @param count Amount of values.
+ * @param output Output with `Width * count` bytes.
+ * @param order Byte order.
+ */
+template <std::size_t Width, typename T>
+void pack_width(const T* values, std::size_t count, uint8_t* output, endianness order) {
+    static_assert(Width >= 1 && Width <= sizeof(T), "Width has to be in [1, sizeof(T)]");
+
+    bool bigEndian = order == endianness::big;
+    bool nativeLittle = system_endianness() == endianness::little;
+    std::size_t i = 0;
+
+#if defined(BA_SIMD_SSSE3)
+    constexpr std::size_t lanes = 16 / sizeof(T);
+    static constexpr auto littleShuffle = packed_shuffle<Width, sizeof(T)>(true, false);
+    static constexpr auto bigShuffle = packed_shuffle<Width, sizeof(T)>(true, true);
+
+    auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bigEndian ? bigShuffle.data() : littleShuffle.data()));
+
+    // 16 byte store has to stay inside of output
+    for (; i + lanes <= count && (count - i) * Width >= 16; i += lanes) {
+        auto wide = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * Width), _mm_shuffle_epi8(wide, shuffle));
+    }
+#endif
+
+    // Overlapping 8 byte stores, next value overwrites extra bytes
+    for (; nativeLittle && i < count && (count - i) * Width >= 8; ++i) {
+        uint64_t word = bigEndian ? byte_swap(uint64_t(values[i]) << (64 - 8 * Width)) : uint64_t(values[i]);
+
+        std::memcpy(output + i * Width, &word, sizeof(word));
+    }
+
+    for (; i < count; ++i) {
+        uint64_t value = values[i];
+
+        for (std::size_t byte = 0; byte < Width; ++byte) {
+            auto shift = 8 * (bigEndian ? Width - 1 - byte : byte);
+
+            output[i * Width + byte] = uint8_t(value >> shift);
+        }
+    }
+}
+
+/**
+ * @brief Function for reading `Width` byte values.
+ * @param input Input with `Width * count` bytes.
+ * @param count Amount of values.
+ * @param output Values.
+ * @param order Byte order.
+ */
+template <std::size_t Width, typename T>
+void unpack_width(const uint8_t* input, std::size_t count, T* output, endianness order) {
+    static_assert(Width >= 1 && Width <= sizeof(T), "Width has to be in [1, sizeof(T)]");
+
+    bool bigEndian = order == endianness::big;
+    bool nativeLittle = system_endianness() == endianness::little;
+    std::size_t i = 0;
+
+#if defined(BA_SIMD_SSSE3)
+    constexpr std::size_t lanes = 16 / sizeof(T);
+    static constexpr auto littleShuffle = packed_shuffle<Width, sizeof(T)>(false, false);
+    static constexpr auto bigShuffle = packed_shuffle<Width, sizeof(T)>(false, true);
+
+    auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bigEndian ? bigShuffle.data() : littleShuffle.data()));
+
+    // 16 byte load has to stay inside of input
+    for (; i + lanes <= count && (count - i) * Width >= 16; i += lanes) {
+        auto packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * Width));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_shuffle_epi8(packed, shuffle));
+    }
+#endif
+
+    // Overlapping 8 byte loads
+    for (; nativeLittle && i < count && (count - i) * Width >= 8; ++i) {
+        uint64_t word;
+
+        std::memcpy(&word, input + i * Width, sizeof(word));
+
+        output[i] = T(bigEndian ? byte_swap(word) >> (64 - 8 * Width) : word & (~uint64_t(0) >> (64 - 8 * Width)));
+    }
+
+    for (; i < count; ++i) {
+        uint64_t value = 0;
+
+        for (std::size_t byte = 0; byte < Width; ++byte) {
+            auto shift = 8 * (bigEndian ? Width - 1 - byte : byte);
+
+            value |= uint64_t(input[i * Width + byte]) << shift;
+        }
+
+        output[i] = T(value);
+    }
+}
+
+}  // namespace detail
+}  // namespace ba
@@ -0,0 +1,108 @@
+#pragma once
+
+// C++ STL
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Compile time instruction set detection. Kernels are
+ * selected by the flags the including translation unit is
+ * built with (e.g. `-msse4.2`, `-mavx2` or `-march=native`),
+ * every kernel has a portable fallback. Define `BA_NO_SIMD`
+ * to force portable implementations.
+ */
+#if !defined(BA_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BA_SIMD_SSE2 1
+#endif
+#if defined(__SSSE3__)
+#define BA_SIMD_SSSE3 1
+#endif
+#if defined(__SSE4_1__)
+#define BA_SIMD_SSE41 1
+#endif
+#if defined(__SSE4_2__)
+#define BA_SIMD_SSE42 1
+#endif
+#if defined(__PCLMUL__)
+#define BA_SIMD_PCLMUL 1
+#endif
+#if defined(__AVX2__)
+#define BA_SIMD_AVX2 1
+#endif
+#endif
+
+#if defined(BA_SIMD_SSE2)
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__)
+#define BA_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BA_NOINLINE __declspec(noinline)
+#else
+#define BA_NOINLINE
+#endif
+
+namespace ba::detail {
+
+/**
+ * @brief Unaligned load of trivially copyable value
+ * in host byte order.
+ * @tparam T Value type.
+ * @param data Pointer to first byte.
+ */
+template <typename T>
+inline T load(const void* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+/**
+ * @brief Unaligned store of trivially copyable value
+ * in host byte order.
+ * @tparam T Value type.
+ * @param data Pointer to first byte.
+ * @param value Value.
+ */
+template <typename T>
+inline void store(void* data, T value) {
+    std::memcpy(data, &value, sizeof(T));
+}
+
+/**
+ * @brief Function for getting index of lowest set bit.
+ * @param value Non zero value.
+ */
+inline unsigned count_trailing_zeros(uint64_t value) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#else
+    unsigned result = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        ++result;
+    }
+    return result;
+#endif
+}
+
+/**
+ * @brief Function for getting index of highest set bit.
+ * @param value Non zero value.
+ */
+inline unsigned highest_bit(uint64_t value) {
+#if defined(__GNUC__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+}  // namespace ba::detail
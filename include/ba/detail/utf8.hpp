@@ -0,0 +1,433 @@
+#pragma once
+
+// ba
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ba {
+namespace detail {
+
+/**
+ * @brief Function for scalar UTF-8 validation
+ * (shortest form, no surrogates, at most U+10FFFF).
+ */
+inline bool validate_utf8_scalar(const uint8_t* data, std::size_t size) {
+    std::size_t position = 0;
+
+    while (position < size) {
+        if (position + 8 <= size && (load<uint64_t>(data + position) & 0x8080808080808080ULL) == 0) {
+            position += 8;
+            continue;
+        }
+
+        auto lead = data[position];
+
+        if (lead < 0x80) {
+            ++position;
+            continue;
+        }
+
+        std::size_t length;
+
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 3;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+        } else {
+            return false;
+        }
+
+        if (size - position < length) {
+            return false;
+        }
+
+        for (std::size_t i = 1; i < length; ++i) {
+            if ((data[position + i] & 0xC0) != 0x80) {
+                return false;
+            }
+        }
+
+        auto second = data[position + 1];
+
+        // Overlong forms, surrogates and values after U+10FFFF
+        if ((lead == 0xE0 && second < 0xA0) || (lead == 0xED && second > 0x9F) || (lead == 0xF0 && second < 0x90) ||
+            (lead == 0xF4 && second > 0x8F)) {
+            return false;
+        }
+
+        position += length;
+    }
+
+    return true;
+}
+
+#if defined(BA_SIMD_SSSE3)
+// Error classes of 2 byte sequences (lookup algorithm)
+constexpr uint8_t utf8_too_short = 1 << 0;
+constexpr uint8_t utf8_too_long = 1 << 1;
+constexpr uint8_t utf8_overlong_3 = 1 << 2;
+constexpr uint8_t utf8_too_large = 1 << 3;
+constexpr uint8_t utf8_surrogate = 1 << 4;
+constexpr uint8_t utf8_overlong_2 = 1 << 5;
+constexpr uint8_t utf8_too_large_1000 = 1 << 6;
+constexpr uint8_t utf8_overlong_4 = 1 << 6;
+constexpr uint8_t utf8_two_continuations = 1 << 7;
+constexpr uint8_t utf8_carry = utf8_too_short | utf8_too_long | utf8_two_continuations;
+
+// Classes by high nibble of first byte
+constexpr uint8_t utf8_first_high[16] = {
+    utf8_too_long,
+    utf8_too_long,
+    utf8_too_long,
+    utf8_too_long,
+    utf8_too_long,
+    utf8_too_long,
+    utf8_too_long,
+    utf8_too_long,
+    utf8_two_continuations,
+    utf8_two_continuations,
+    utf8_two_continuations,
+    utf8_two_continuations,
+    utf8_too_short | utf8_overlong_2,
+    utf8_too_short,
+    utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+    utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4,
+};
+
+// Classes by low nibble of first byte
+constexpr uint8_t utf8_first_low[16] = {
+    utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4,
+    utf8_carry | utf8_overlong_2,
+    utf8_carry,
+    utf8_carry,
+    utf8_carry | utf8_too_large,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+};
+
+// Classes by high nibble of second byte
+constexpr uint8_t utf8_second_high[16] = {
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_long | utf8_overlong_2 | utf8_two_continuations | utf8_overlong_3 | utf8_too_large_1000 | utf8_overlong_4,
+    utf8_too_long | utf8_overlong_2 | utf8_two_continuations | utf8_overlong_3 | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_continuations | utf8_surrogate | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_continuations | utf8_surrogate | utf8_too_large,
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_short,
+    utf8_too_short,
+};
+
+// Last bytes, that can't end input (start of longer sequence)
+constexpr uint8_t utf8_incomplete[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+/**
+ * @brief Operations on 16 byte vectors for UTF-8 validation.
+ */
+struct utf8_sse {
+    using vector = __m128i;
+
+    static constexpr std::size_t width = 16;
+
+    static vector load(const uint8_t* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+
+    static vector table(const uint8_t* values) { return load(values); }
+
+    static vector lookup(vector table, vector index) { return _mm_shuffle_epi8(table, index); }
+
+    static vector high_nibble(vector value) { return _mm_and_si128(_mm_srli_epi16(value, 4), _mm_set1_epi8(0x0F)); }
+
+    static vector low_nibble(vector value) { return _mm_and_si128(value, _mm_set1_epi8(0x0F)); }
+
+    template <int N>
+    static vector previous(vector input, vector previous) {
+        return _mm_alignr_epi8(input, previous, 16 - N);
+    }
+
+    static vector saturating_sub(vector lhs, uint8_t rhs) { return _mm_subs_epu8(lhs, _mm_set1_epi8(char(rhs))); }
+
+    static vector subtract(vector lhs, vector rhs) { return _mm_subs_epu8(lhs, rhs); }
+
+    static vector bit_and(vector lhs, vector rhs) { return _mm_and_si128(lhs, rhs); }
+
+    static vector bit_or(vector lhs, vector rhs) { return _mm_or_si128(lhs, rhs); }
+
+    static vector bit_xor(vector lhs, vector rhs) { return _mm_xor_si128(lhs, rhs); }
+
+    static vector high_bits() { return _mm_set1_epi8(char(0x80)); }
+
+    static vector zero() { return _mm_setzero_si128(); }
+
+    static bool is_ascii(vector value) { return _mm_movemask_epi8(value) == 0; }
+
+    static bool is_zero(vector value) { return _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) == 0xFFFF; }
+};
+
+#if defined(BA_SIMD_AVX2)
+/**
+ * @brief Operations on 32 byte vectors for UTF-8 validation.
+ * Tables are repeated in both lanes.
+ */
+struct utf8_avx2 {
+    using vector = __m256i;
+
+    static constexpr std::size_t width = 32;
+
+    static vector load(const uint8_t* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+
+    static vector table(const uint8_t* values) {
+        return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values)));
+    }
+
+    static vector lookup(vector table, vector index) { return _mm256_shuffle_epi8(table, index); }
+
+    static vector high_nibble(vector value) { return _mm256_and_si256(_mm256_srli_epi16(value, 4), _mm256_set1_epi8(0x0F)); }
+
+    static vector low_nibble(vector value) { return _mm256_and_si256(value, _mm256_set1_epi8(0x0F)); }
+
+    template <int N>
+    static vector previous(vector input, vector previous) {
+        return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+    }
+
+    static vector saturating_sub(vector lhs, uint8_t rhs) { return _mm256_subs_epu8(lhs, _mm256_set1_epi8(char(rhs))); }
+
+    static vector subtract(vector lhs, vector rhs) { return _mm256_subs_epu8(lhs, rhs); }
+
+    static vector bit_and(vector lhs, vector rhs) { return _mm256_and_si256(lhs, rhs); }
+
+    static vector bit_or(vector lhs, vector rhs) { return _mm256_or_si256(lhs, rhs); }
+
+    static vector bit_xor(vector lhs, vector rhs) { return _mm256_xor_si256(lhs, rhs); }
+
+    static vector high_bits() { return _mm256_set1_epi8(char(0x80)); }
+
+    static vector zero() { return _mm256_setzero_si256(); }
+
+    static bool is_ascii(vector value) { return _mm256_movemask_epi8(value) == 0; }
+
+    static bool is_zero(vector value) { return _mm256_testz_si256(value, value) != 0; }
+};
+#endif
+
+/**
+ * @brief Function for vectorized UTF-8 validation
+ * (lookup algorithm of simdjson). Error class of every
+ * byte pair is AND of 3 nibble lookups, 3 and 4 byte
+ * sequences are checked by comparison of expected and
+ * found continuations. Errors are accumulated and checked
+ * once at the end, ASCII blocks only check, that previous
+ * block doesn't end with unfinished sequence.
+ */
+template <typename Simd>
+bool validate_utf8_simd(const uint8_t* data, std::size_t size) {
+    auto firstHigh = Simd::table(utf8_first_high);
+    auto firstLow = Simd::table(utf8_first_low);
+    auto secondHigh = Simd::table(utf8_second_high);
+    auto incomplete = Simd::load(utf8_incomplete + 32 - Simd::width);
+
+    auto zero = Simd::zero();
+    auto error = zero;
+    auto previousInput = zero;
+    auto previousIncomplete = zero;
+
+    auto check = [&](typename Simd::vector input) {
+        auto ascii = Simd::is_ascii(input);
+
+        if (ascii) {
+            error = Simd::bit_or(error, previousIncomplete);
+        } else {
+            auto first = Simd::template previous<1>(input, previousInput);
+            auto classes = Simd::bit_and(Simd::bit_and(Simd::lookup(firstHigh, Simd::high_nibble(first)),
+                                                       Simd::lookup(firstLow, Simd::low_nibble(first))),
+                                         Simd::lookup(secondHigh, Simd::high_nibble(input)));
+
+            // Only 111xxxxx (1111xxxx) bytes give high bit, then
+            // continuation is expected 2 (3) bytes later
+            auto third = Simd::saturating_sub(Simd::template previous<2>(input, previousInput), 0xE0 - 0x80);
+            auto fourth = Simd::saturating_sub(Simd::template previous<3>(input, previousInput), 0xF0 - 0x80);
+            auto expected = Simd::bit_and(Simd::bit_or(third, fourth), Simd::high_bits());
+
+            error = Simd::bit_or(error, Simd::bit_xor(classes, expected));
+        }
+
+        previousIncomplete = ascii ? zero : Simd::subtract(input, incomplete);
+        previousInput = input;
+    };
+
+    std::size_t position = 0;
+
+    // 2 vectors of ASCII are skipped with single branch
+    for (; position + 2 * Simd::width <= size; position += 2 * Simd::width) {
+        auto first = Simd::load(data + position);
+        auto second = Simd::load(data + position + Simd::width);
+
+        if (Simd::is_ascii(Simd::bit_or(first, second))) {
+            error = Simd::bit_or(error, previousIncomplete);
+            previousIncomplete = zero;
+            previousInput = second;
+        } else {
+            check(first);
+            check(second);
+        }
+    }
+
+    for (; position + Simd::width <= size; position += Simd::width) {
+        check(Simd::load(data + position));
+    }
+
+    // Tail is padded with zeros, so unfinished sequence is an error
+    uint8_t tail[Simd::width] = {};
+
+    if (position < size) {
+        std::memcpy(tail, data + position, size - position);
+    }
+
+    check(Simd::load(tail));
+
+    return Simd::is_zero(error);
+}
+#endif
+
+/**
+ * @brief Function for UTF-8 validation with widest
+ * available kernel.
+ */
+inline bool validate_utf8_bytes(const uint8_t* data, std::size_t size) {
+#if defined(BA_SIMD_AVX2)
+    return validate_utf8_simd<utf8_avx2>(data, size);
+#elif defined(BA_SIMD_SSSE3)
+    return validate_utf8_simd<utf8_sse>(data, size);
+#else
+    return validate_utf8_scalar(data, size);
+#endif
+}
+
+/**
+ * @brief Function for checking, that all bytes are
+ * less, than 0x80. 64 bytes are checked per branch.
+ */
+inline bool is_ascii_bytes(const uint8_t* data, std::size_t size) {
+    std::size_t position = 0;
+
+#if defined(BA_SIMD_AVX2)
+    for (; position + 64 <= size; position += 64) {
+        auto first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+        auto second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position + 32));
+
+        if (_mm256_movemask_epi8(_mm256_or_si256(first, second)) != 0) {
+            return false;
+        }
+    }
+#elif defined(BA_SIMD_SSE2)
+    for (; position + 64 <= size; position += 64) {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+
+        for (std::size_t i = 16; i < 64; i += 16) {
+            bytes = _mm_or_si128(bytes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + i)));
+        }
+
+        if (_mm_movemask_epi8(bytes) != 0) {
+            return false;
+        }
+    }
+#endif
+
+    uint64_t bits = 0;
+
+    for (; position + 8 <= size; position += 8) {
+        bits |= load<uint64_t>(data + position);
+    }
+
+    for (; position < size; ++position) {
+        bits |= data[position];
+    }
+
+    return (bits & 0x8080808080808080ULL) == 0;
+}
+
+/**
+ * @brief Function for counting printable ASCII
+ * bytes (`' '` - `'~'`). Range check is single signed
+ * comparison after shift of range to [-128, -34],
+ * matches are summed in byte counters, that are
+ * flushed every 255 vectors.
+ */
+inline std::size_t count_printable_bytes(const uint8_t* data, std::size_t size) {
+    std::size_t position = 0;
+    std::size_t result = 0;
+
+#if defined(BA_SIMD_AVX2)
+    auto shift = _mm256_set1_epi8(0x60);
+    auto limit = _mm256_set1_epi8(-33);
+
+    while (position + 32 <= size) {
+        auto counters = _mm256_setzero_si256();
+        auto blocks = std::min<std::size_t>((size - position) / 32, 255);
+
+        for (std::size_t i = 0; i < blocks; ++i, position += 32) {
+            auto bytes = _mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position)), shift);
+
+            counters = _mm256_sub_epi8(counters, _mm256_cmpgt_epi8(limit, bytes));
+        }
+
+        auto sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+        auto half = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+
+        result += std::size_t(_mm_cvtsi128_si32(half)) + std::size_t(_mm_extract_epi16(half, 4));
+    }
+#elif defined(BA_SIMD_SSE2)
+    auto shift = _mm_set1_epi8(0x60);
+    auto limit = _mm_set1_epi8(-33);
+
+    while (position + 16 <= size) {
+        auto counters = _mm_setzero_si128();
+        auto blocks = std::min<std::size_t>((size - position) / 16, 255);
+
+        for (std::size_t i = 0; i < blocks; ++i, position += 16) {
+            auto bytes = _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position)), shift);
+
+            counters = _mm_sub_epi8(counters, _mm_cmplt_epi8(bytes, limit));
+        }
+
+        auto sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+
+        result += std::size_t(_mm_cvtsi128_si32(sums)) + std::size_t(_mm_extract_epi16(sums, 4));
+    }
+#endif
+
+    for (; position < size; ++position) {
+        result += data[position] >= ' ' && data[position] <= '~';
+    }
+
+    return result;
+}
+
+}  // namespace detail
+}  // namespace ba
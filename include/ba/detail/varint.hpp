@@ -0,0 +1,78 @@
+#pragma once
+
+// C++ STL
+#include <cstddef>
+#include <cstdint>
+
+namespace ba {
+namespace detail {
+
+/**
+ * @brief Maximum size of LEB128 encoded 64 bit value.
+ */
+constexpr std::size_t max_varint_size = 10;
+
+/**
+ * @brief Function for getting size of LEB128
+ * encoded value.
+ */
+inline std::size_t varint_size(uint64_t value) {
+    std::size_t size = 1;
+
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+
+    return size;
+}
+
+/**
+ * @brief Function for LEB128 encoding.
+ * @param value Value.
+ * @param output Output buffer with at least `max_varint_size` bytes.
+ * @return Amount of written bytes.
+ */
+inline std::size_t encode_varint(uint64_t value, uint8_t* output) {
+    std::size_t size = 0;
+
+    while (value >= 0x80) {
+        output[size++] = uint8_t(value | 0x80);
+        value >>= 7;
+    }
+
+    output[size++] = uint8_t(value);
+
+    return size;
+}
+
+/**
+ * @brief Function for LEB128 decoding.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param value Decoded value.
+ * @return Amount of read bytes or 0 if value is
+ * truncated or longer, than 64 bits.
+ */
+inline std::size_t decode_varint(const uint8_t* data, std::size_t size, uint64_t& value) {
+    uint64_t result = 0;
+
+    for (std::size_t i = 0; i < size && i < max_varint_size; ++i) {
+        result |= uint64_t(data[i] & 0x7F) << (7 * i);
+
+        if (data[i] < 0x80) {
+            // 10th byte may hold only the highest bit
+            if (i == max_varint_size - 1 && data[i] > 0x01) {
+                return 0;
+            }
+
+            value = result;
+            return i + 1;
+        }
+    }
+
+    return 0;
+}
+
+}  // namespace detail
+}  // namespace ba
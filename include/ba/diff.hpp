@@ -0,0 +1,487 @@
+#pragma once
+
+// ba
+#include <ba/bytearray.hpp>
+#include <ba/checksum.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/varint.hpp>
+#include <ba/varint.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace ba {
+
+namespace detail {
+
+constexpr std::size_t diff_min_block = 16;
+constexpr std::size_t diff_max_blocks = std::size_t(1) << 21;
+constexpr std::size_t diff_min_continuation = 8;
+constexpr uint64_t diff_hash_base = 0x100000001B3ULL;
+
+/**
+ * @brief Function for polynomial hash of block (size
+ * is multiple of 4). 4 independent sums of every 4th
+ * byte are combined at the end to break multiplication
+ * dependency chain.
+ */
+inline uint64_t diff_hash(const uint8_t* data, std::size_t size) {
+    constexpr uint64_t base2 = diff_hash_base * diff_hash_base;
+    constexpr uint64_t base3 = base2 * diff_hash_base;
+    constexpr uint64_t base4 = base2 * base2;
+
+    uint64_t sums[4] = {};
+
+    for (std::size_t i = 0; i < size; i += 4) {
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            sums[lane] = sums[lane] * base4 + data[i + lane];
+        }
+    }
+
+    return sums[0] * base3 + sums[1] * base2 + sums[2] * diff_hash_base + sums[3];
+}
+
+/**
+ * @brief Index of source blocks by rolling hash.
+ * Source is split to not overlapping blocks, block size
+ * grows, until amount of blocks fits limit, so memory
+ * usage doesn't depend on source size. Table is direct
+ * mapped, entries keep high half of hash to skip
+ * most of false candidates without reading source.
+ */
+class diff_index {
+public:
+    diff_index(const uint8_t* data, std::size_t size, std::size_t maxBlocks) : m_block(diff_min_block), m_shift(63), m_power(1) {
+        while (size / m_block > maxBlocks) {
+            m_block *= 2;
+        }
+
+        auto blocks = size / m_block;
+        std::size_t bits = 1;
+
+        while ((std::size_t(1) << bits) < blocks * 2) {
+            ++bits;
+        }
+
+        m_shift = 64 - bits;
+
+        for (std::size_t i = 1; i < m_block; ++i) {
+            m_power *= diff_hash_base;
+        }
+
+        if (blocks == 0) {
+            return;
+        }
+
+        m_table.resize(std::size_t(1) << bits);
+
+        for (std::size_t block = 0; block < blocks; ++block) {
+            auto hash = diff_hash(data + block * m_block, m_block);
+
+            m_table[slot(hash)] = (hash & 0xFFFFFFFF00000000ULL) | uint64_t(block + 1);
+        }
+    }
+
+    std::size_t block_size() const { return m_block; }
+
+    /**
+     * @brief Method for getting source offset of
+     * block with given hash.
+     * @return Offset or `size_t(-1)`.
+     */
+    std::size_t find(uint64_t hash) const {
+        if (m_table.empty()) {
+            return std::size_t(-1);
+        }
+
+        auto entry = m_table[slot(hash)];
+
+        // Tag is checked first, empty slots are unpredictable
+        if ((entry ^ hash) >> 32 != 0 || uint32_t(entry) == 0) {
+            return std::size_t(-1);
+        }
+
+        return std::size_t(uint32_t(entry) - 1) * m_block;
+    }
+
+    /**
+     * @brief Method for moving hash window 1 byte forward.
+     */
+    uint64_t roll(uint64_t hash, uint8_t removed, uint8_t added) const { return (hash - removed * m_power) * diff_hash_base + added; }
+
+private:
+    std::size_t slot(uint64_t hash) const { return std::size_t((hash * 0x9E3779B97F4A7C15ULL) >> m_shift); }
+
+    std::size_t m_block;
+    std::size_t m_shift;
+    uint64_t m_power;
+    std::vector<uint64_t> m_table;
+};
+
+/**
+ * @brief Function for checking patch before output is
+ * allocated: source size has to match and lengths of
+ * instructions have to sum up to target size, so size
+ * in header can't be larger, than patch describes.
+ * @param targetSize Target size from header.
+ * @return Is patch valid (bounds of copies and checksum
+ * are checked while patch is applied).
+ */
+inline bool check_diff(const uint8_t* patch, std::size_t patchSize, std::size_t sourceSize, uint64_t& targetSize) {
+    uint64_t expectedSource;
+
+    auto position = decode_varint(patch, patchSize, expectedSource);
+
+    if (position == 0 || expectedSource != sourceSize) {
+        return false;
+    }
+
+    auto second = decode_varint(patch + position, patchSize - position, targetSize);
+
+    position += second;
+
+    if (second == 0 || patchSize - position < sizeof(uint32_t)) {
+        return false;
+    }
+
+    position += sizeof(uint32_t);
+
+    uint64_t total = 0;
+
+    while (position < patchSize) {
+        uint64_t instruction;
+
+        auto used = decode_varint(patch + position, patchSize - position, instruction);
+
+        position += used;
+
+        auto length = instruction >> 1;
+
+        if (used == 0 || length == 0 || length > targetSize - total) {
+            return false;
+        }
+
+        if (instruction & 1) {
+            uint64_t delta;
+
+            used = decode_varint(patch + position, patchSize - position, delta);
+
+            if (used == 0) {
+                return false;
+            }
+
+            position += used;
+        } else {
+            if (length > patchSize - position) {
+                return false;
+            }
+
+            position += std::size_t(length);
+        }
+
+        total += length;
+    }
+
+    return total == targetSize;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for creating patch, that turns
+ * `source` into `data`. Source blocks are found with
+ * rolling hash and extended with SIMD mismatch search,
+ * continuation of previous copy is tried first, so
+ * single byte changes cost few bytes. Patch holds
+ * sizes, CRC32C of result and instructions:
+ * varint `length << 1 | copy`, then zigzag varint of
+ * source offset relative to end of previous copy or
+ * `length` literal bytes.
+ * @param source Pointer to old data.
+ * @param sourceSize Size of old data.
+ * @param data Pointer to new data.
+ * @param size Size of new data.
+ * @param target Byte array or processor, patch is appended to.
+ * @param maxBlocks Maximum amount of indexed source
+ * blocks (index uses `16 * maxBlocks` bytes at most).
+ * @return Amount of written bytes.
+ */
+template <typename ValueType, typename Allocator>
+std::size_t diff(const void* source,
+                 std::size_t sourceSize,
+                 const void* data,
+                 std::size_t size,
+                 bytearray_processor<ValueType, Allocator>& target,
+                 std::size_t maxBlocks = detail::diff_max_blocks) {
+    auto old = static_cast<const uint8_t*>(source);
+    auto input = static_cast<const uint8_t*>(data);
+    auto start = target.container().size();
+
+    target.push_back_varint(uint64_t(sourceSize));
+    target.push_back_varint(uint64_t(size));
+    target.template push_back<uint32_t>(crc32c(data, size), endianness::little);
+
+    detail::diff_index index(old, sourceSize, maxBlocks);
+
+    auto block = index.block_size();
+
+    std::size_t literals = 0;
+    std::size_t copyEnd = 0;
+    std::size_t sourceEnd = 0;
+    bool copied = false;
+
+    auto literal = [&](std::size_t end) {
+        auto first = reinterpret_cast<const ValueType*>(input);
+
+        target.push_back_varint(uint64_t(end - literals) << 1);
+        target.container().insert(target.container().end(), first + literals, first + end);
+    };
+
+    auto emit = [&](std::size_t position, std::size_t offset, std::size_t length) {
+        if (literals < position) {
+            literal(position);
+        }
+
+        target.push_back_varint((uint64_t(length) << 1) | 1);
+        target.push_back_varint(zigzag_encode(int64_t(offset) - int64_t(sourceEnd)));
+
+        literals = position + length;
+        copyEnd = literals;
+        sourceEnd = offset + length;
+        copied = true;
+    };
+
+    uint64_t hash = 0;
+    bool hashed = false;
+
+    for (std::size_t position = 0; position + block <= size;) {
+        // Continuation of previous copy after changed bytes
+        auto expected = sourceEnd + (position - copyEnd);
+
+        if (copied && expected < sourceSize) {
+            auto length =
+                detail::mismatch_bytes(old + expected, input + position, std::min(sourceSize - expected, size - position));
+
+            if (length >= detail::diff_min_continuation) {
+                emit(position, expected, length);
+                position += length;
+                hashed = false;
+                continue;
+            }
+        }
+
+        if (!hashed) {
+            hash = detail::diff_hash(input + position, block);
+            hashed = true;
+        }
+
+        auto offset = index.find(hash);
+
+        if (offset != std::size_t(-1)) {
+            auto length = detail::mismatch_bytes(old + offset, input + position, std::min(sourceSize - offset, size - position));
+
+            if (length >= block) {
+                // Bytes before match may be taken from literals
+                while (position > literals && offset > 0 && old[offset - 1] == input[position - 1]) {
+                    --position;
+                    --offset;
+                    ++length;
+                }
+
+                emit(position, offset, length);
+                position += length;
+                hashed = false;
+                continue;
+            }
+        }
+
+        if (position + block < size) {
+            hash = index.roll(hash, input[position], input[position + block]);
+        }
+
+        ++position;
+    }
+
+    if (literals < size) {
+        literal(size);
+    }
+
+    return target.container().size() - start;
+}
+
+/**
+ * @brief Function for creating patch between byte
+ * arrays, readers or views.
+ */
+template <typename Source, typename Data>
+typename std::enable_if<detail::is_byte_sequence<Source>::value && detail::is_byte_sequence<Data>::value, bytearray<>>::type diff(
+    const Source& source, const Data& data) {
+    bytearray<> result;
+
+    diff(detail::byte_data(source), detail::byte_size(source), detail::byte_data(data), detail::byte_size(data), result);
+
+    return result;
+}
+
+/**
+ * @brief Function for getting size of data, that
+ * is created by patch, to preallocate storage.
+ * @return Size or 0 if header is invalid.
+ */
+inline std::size_t diff_target_size(const void* patch, std::size_t size) {
+    auto input = static_cast<const uint8_t*>(patch);
+
+    uint64_t sourceSize;
+    uint64_t targetSize;
+
+    auto first = detail::decode_varint(input, size, sourceSize);
+
+    if (first == 0 || detail::decode_varint(input + first, size - first, targetSize) == 0) {
+        return 0;
+    }
+
+    return std::size_t(targetSize);
+}
+
+template <typename Patch>
+typename std::enable_if<detail::is_byte_sequence<Patch>::value, std::size_t>::type diff_target_size(const Patch& patch) {
+    return diff_target_size(detail::byte_data(patch), detail::byte_size(patch));
+}
+
+/**
+ * @brief Function for applying patch, created by
+ * `diff`, to source. Source size, bounds of every
+ * instruction and CRC32C of result are checked.
+ * Output must not overlap source.
+ * @param source Pointer to old data.
+ * @param sourceSize Size of old data.
+ * @param patch Pointer to patch.
+ * @param patchSize Size of patch.
+ * @param output Preallocated output (see `diff_target_size`).
+ * @param outputSize Capacity of output, it's replaced
+ * with size of result.
+ * @return Is patch valid for this source.
+ */
+inline bool apply_diff(const void* source,
+                       std::size_t sourceSize,
+                       const void* patch,
+                       std::size_t patchSize,
+                       void* output,
+                       std::size_t& outputSize) {
+    auto old = static_cast<const uint8_t*>(source);
+    auto input = static_cast<const uint8_t*>(patch);
+    auto out = static_cast<uint8_t*>(output);
+
+    uint64_t expectedSource;
+    uint64_t targetSize;
+
+    auto position = detail::decode_varint(input, patchSize, expectedSource);
+
+    if (position == 0 || expectedSource != sourceSize) {
+        return false;
+    }
+
+    auto second = detail::decode_varint(input + position, patchSize - position, targetSize);
+
+    position += second;
+
+    if (second == 0 || targetSize > outputSize || patchSize - position < sizeof(uint32_t)) {
+        return false;
+    }
+
+    uint32_t checksum = uint32_t(input[position]) | uint32_t(input[position + 1]) << 8 | uint32_t(input[position + 2]) << 16 |
+                        uint32_t(input[position + 3]) << 24;
+
+    position += sizeof(uint32_t);
+
+    std::size_t written = 0;
+    uint64_t sourceEnd = 0;
+
+    while (position < patchSize) {
+        uint64_t instruction;
+
+        auto used = detail::decode_varint(input + position, patchSize - position, instruction);
+
+        position += used;
+
+        auto length = instruction >> 1;
+
+        if (used == 0 || length == 0 || length > targetSize - written) {
+            return false;
+        }
+
+        if (instruction & 1) {
+            uint64_t delta;
+
+            used = detail::decode_varint(input + position, patchSize - position, delta);
+            position += used;
+
+            auto offset = sourceEnd + uint64_t(zigzag_decode(delta));
+
+            if (used == 0 || offset > sourceSize || length > sourceSize - offset) {
+                return false;
+            }
+
+            std::memcpy(out + written, old + offset, std::size_t(length));
+            sourceEnd = offset + length;
+        } else {
+            if (length > patchSize - position) {
+                return false;
+            }
+
+            std::memcpy(out + written, input + position, std::size_t(length));
+            position += std::size_t(length);
+        }
+
+        written += std::size_t(length);
+    }
+
+    if (written != targetSize || crc32c(out, written) != checksum) {
+        return false;
+    }
+
+    outputSize = written;
+
+    return true;
+}
+
+/**
+ * @brief Function for applying patch to byte array,
+ * reader or view. Result is appended to target, it's
+ * resized only after patch structure is checked.
+ * @return Is patch valid (target is not changed otherwise).
+ */
+template <typename Source, typename Patch, typename ValueType, typename Allocator>
+typename std::enable_if<detail::is_byte_sequence<Source>::value && detail::is_byte_sequence<Patch>::value, bool>::type apply_diff(
+    const Source& source, const Patch& patch, bytearray_processor<ValueType, Allocator>& target) {
+    uint64_t targetSize;
+
+    if (!detail::check_diff(detail::byte_data(patch), detail::byte_size(patch), detail::byte_size(source), targetSize)) {
+        return false;
+    }
+
+    auto size = std::size_t(targetSize);
+    auto& container = target.container();
+    auto offset = container.size();
+
+    container.resize(offset + size);
+
+    if (!apply_diff(detail::byte_data(source),
+                    detail::byte_size(source),
+                    detail::byte_data(patch),
+                    detail::byte_size(patch),
+                    container.data() + offset,
+                    size)) {
+        container.resize(offset);
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace ba
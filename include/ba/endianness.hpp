@@ -1,5 +1,52 @@
 #pragma once
 
+// C++ STL
+#include <cstdint>
+#include <cstring>
+
 namespace ba {
 enum class endianness { little, big };
+
+namespace detail {
+
+/**
+ * @brief Function for checking system endianness.
+ * @return Endianness value.
+ */
+inline endianness system_endianness() {
+    uint16_t value = 0x0102;
+    uint8_t first;
+
+    std::memcpy(&first, &value, 1);
+
+    return first == 0x01 ? endianness::big : endianness::little;
+}
+
+/**
+ * @brief Functions for reversing byte order.
+ */
+inline uint16_t byte_swap(uint16_t value) {
+    return uint16_t((value << 8) | (value >> 8));
+}
+
+inline uint32_t byte_swap(uint32_t value) {
+#if defined(__GNUC__)
+    return __builtin_bswap32(value);
+#else
+    value = ((value & 0x0000FFFFu) << 16) | ((value & 0xFFFF0000u) >> 16);
+    return ((value & 0x00FF00FFu) << 8) | ((value & 0xFF00FF00u) >> 8);
+#endif
 }
+
+inline uint64_t byte_swap(uint64_t value) {
+#if defined(__GNUC__)
+    return __builtin_bswap64(value);
+#else
+    value = ((value & 0x00000000FFFFFFFFULL) << 32) | ((value & 0xFFFFFFFF00000000ULL) >> 32);
+    value = ((value & 0x0000FFFF0000FFFFULL) << 16) | ((value & 0xFFFF0000FFFF0000ULL) >> 16);
+    return ((value & 0x00FF00FF00FF00FFULL) << 8) | ((value & 0xFF00FF00FF00FF00ULL) >> 8);
+#endif
+}
+
+}  // namespace detail
+}  // namespace ba
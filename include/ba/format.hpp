@@ -0,0 +1,390 @@
+#pragma once
+
+// ba
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/compare.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+#if defined(BA_WITH_FMT)
+#include <fmt/format.h>
+#endif
+
+// Byte arrays are ranges, range formatters are disabled for them
+#if defined(FMT_VERSION)
+#include <fmt/ranges.h>
+#endif
+
+namespace ba {
+namespace detail {
+
+/**
+ * @brief Function for building table of 2 hex digits
+ * of every byte value.
+ */
+constexpr std::array<char, 512> make_hex_table(const char* digits) {
+    std::array<char, 512> result{};
+
+    for (std::size_t i = 0; i < 256; ++i) {
+        result[2 * i] = digits[i >> 4];
+        result[2 * i + 1] = digits[i & 0xF];
+    }
+
+    return result;
+}
+
+inline constexpr auto hex_upper_table = make_hex_table("0123456789ABCDEF");
+inline constexpr auto hex_lower_table = make_hex_table("0123456789abcdef");
+
+// Characters, that are collected on stack before write to output
+constexpr std::size_t format_buffer_size = 256;
+
+/**
+ * @brief Structure, that describes parsed format
+ * specification of byte sequence.
+ */
+struct byte_format_spec {
+    char type = 'X';
+    char separator = ' ';
+    std::size_t limit = std::size_t(-1);
+};
+
+/**
+ * @brief Function for parsing `[.limit][type[separator]]`
+ * format specification.
+ * @tparam Error Exception type of format library.
+ * @return Iterator to `}` or to end.
+ */
+template <typename Error, typename Iterator>
+constexpr Iterator parse_byte_format(Iterator begin, Iterator end, byte_format_spec& spec) {
+    auto it = begin;
+
+    if (it != end && *it == '.') {
+        ++it;
+
+        if (it == end || *it < '0' || *it > '9') {
+            throw Error("Precision of byte array format has to be a number");
+        }
+
+        std::size_t limit = 0;
+
+        for (; it != end && *it >= '0' && *it <= '9'; ++it) {
+            limit = limit * 10 + std::size_t(*it - '0');
+        }
+
+        spec.limit = limit;
+    }
+
+    if (it != end && *it != '}') {
+        if (*it != 'x' && *it != 'X' && *it != 's' && *it != 'd') {
+            throw Error("Unknown byte array format type");
+        }
+
+        spec.type = *it++;
+
+        if (spec.type == 's' && it != end && *it != '}') {
+            spec.separator = *it++;
+        }
+    }
+
+    if (it != end && *it != '}') {
+        throw Error("Wrong byte array format specification");
+    }
+
+    return it;
+}
+
+/**
+ * @brief Function for writing bytes as hex digits.
+ * Digits are collected on stack and every block is
+ * written with `Library::write`.
+ * @param table Hex table (upper or lower case).
+ * @param separator Character between bytes, `0` if
+ * bytes aren't separated.
+ */
+template <typename Library, typename OutputIt>
+OutputIt write_hex(const uint8_t* data, std::size_t size, const char* table, char separator, OutputIt out) {
+    char buffer[format_buffer_size];
+    std::size_t position = 0;
+
+    if (separator == 0) {
+        while (position < size) {
+            auto count = std::min(size - position, sizeof(buffer) / 2);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                std::memcpy(buffer + 2 * i, table + 2 * data[position + i], 2);
+            }
+
+            out = Library::write(out, buffer, 2 * count);
+            position += count;
+        }
+
+        return out;
+    }
+
+    while (position < size) {
+        auto count = std::min(size - position, sizeof(buffer) / 3);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            buffer[3 * i] = separator;
+            std::memcpy(buffer + 3 * i + 1, table + 2 * data[position + i], 2);
+        }
+
+        // There is no separator before first byte
+        std::size_t skip = position == 0 ? 1 : 0;
+
+        out = Library::write(out, buffer + skip, 3 * count - skip);
+        position += count;
+    }
+
+    return out;
+}
+
+/**
+ * @brief Function for writing hexdump, that has the same
+ * rows as `operator<<`: offset, 16 bytes in 4 groups
+ * and printable characters. Rows are separated with new
+ * line, there is no new line after last one.
+ */
+template <typename Library, typename OutputIt>
+OutputIt write_hexdump(const uint8_t* data, std::size_t size, OutputIt out) {
+    static constexpr char digits[] = "0123456789ABCDEF";
+
+    // New line, prefix, offset, 4 groups, ASCII column
+    constexpr std::size_t rowSize = 1 + 6 + 16 + 1 + 4 * 14 + 2 + 16;
+
+    // 16 rows are written at once
+    char buffer[16 * rowSize];
+    auto current = buffer;
+
+    for (std::size_t offset = 0; offset < size; offset += 16) {
+        if (current + rowSize > buffer + sizeof(buffer)) {
+            out = Library::write(out, buffer, std::size_t(current - buffer));
+            current = buffer;
+        }
+
+        if (offset != 0) {
+            *current++ = '\n';
+        }
+
+        std::memcpy(current, "    0x", 6);
+        current += 6;
+
+        // At least 8 digits, more for offsets after 4 GiB
+        unsigned width = 8;
+
+        while (width < 16 && (uint64_t(offset) >> (4 * width)) != 0) {
+            ++width;
+        }
+
+        for (auto shift = 4 * width; shift != 0; shift -= 4) {
+            *current++ = digits[(uint64_t(offset) >> (shift - 4)) & 0xF];
+        }
+
+        *current++ = ' ';
+
+        auto count = std::min<std::size_t>(16, size - offset);
+
+        for (std::size_t i = 0; i < 16; ++i) {
+            if (i % 4 == 0) {
+                std::memcpy(current, "| ", 2);
+                current += 2;
+            }
+
+            if (i < count) {
+                std::memcpy(current, hex_upper_table.data() + 2 * data[offset + i], 2);
+            } else {
+                std::memcpy(current, "  ", 2);
+            }
+
+            current[2] = ' ';
+            current += 3;
+        }
+
+        std::memcpy(current, "| ", 2);
+        current += 2;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto value = data[offset + i];
+
+            *current++ = value >= ' ' && value <= '~' ? char(value) : '.';
+        }
+    }
+
+    return Library::write(out, buffer, std::size_t(current - buffer));
+}
+
+/**
+ * @brief Class, that implements formatter of byte
+ * sequences for `std::format` and `fmt::format`.
+ * Specification is `[.limit][type[separator]]`:
+ * - `X` (default) / `x` - upper / lower case hex digits;
+ * - `s` - upper case hex digits of bytes, separated with
+ * space or with character after `s` (`{:s:}`);
+ * - `d` - hexdump rows.
+ * Only first `limit` bytes are written, `...` is added
+ * if sequence is longer.
+ * @tparam Library Format library traits: `error` exception
+ * type and `write(out, data, size)` function.
+ */
+template <typename Library>
+class byte_formatter {
+public:
+    template <typename ParseContext>
+    constexpr auto parse(ParseContext& context) {
+        return parse_byte_format<typename Library::error>(context.begin(), context.end(), m_spec);
+    }
+
+    template <typename Sequence, typename FormatContext>
+    auto format(const Sequence& sequence, FormatContext& context) const {
+        auto data = byte_data(sequence);
+        auto size = byte_size(sequence);
+        auto truncated = size > m_spec.limit;
+
+        if (truncated) {
+            size = m_spec.limit;
+        }
+
+        auto out = context.out();
+
+        switch (m_spec.type) {
+            case 'x':
+                out = write_hex<Library>(data, size, hex_lower_table.data(), 0, out);
+                break;
+            case 's':
+                out = write_hex<Library>(data, size, hex_upper_table.data(), m_spec.separator, out);
+                break;
+            case 'd':
+                out = write_hexdump<Library>(data, size, out);
+                break;
+            default:
+                out = write_hex<Library>(data, size, hex_upper_table.data(), 0, out);
+                break;
+        }
+
+        if (truncated) {
+            // Hexdump continues on next row
+            if (m_spec.type == 'd' && size != 0) {
+                out = Library::write(out, "\n...", 4);
+            } else {
+                out = Library::write(out, "...", 3);
+            }
+        }
+
+        return out;
+    }
+
+private:
+    byte_format_spec m_spec;
+};
+
+}  // namespace detail
+}  // namespace ba
+
+#if defined(__cpp_lib_format)
+namespace ba {
+namespace detail {
+
+struct std_format_library {
+    using error = std::format_error;
+
+    template <typename OutputIt>
+    static OutputIt write(OutputIt out, const char* data, std::size_t size) {
+        return std::copy_n(data, size, out);
+    }
+};
+
+}  // namespace detail
+}  // namespace ba
+
+namespace std {
+template <typename ValueType, typename Allocator>
+struct formatter<ba::bytearray_reader<ValueType, Allocator>, char> : ba::detail::byte_formatter<ba::detail::std_format_library> {};
+
+template <typename ValueType, typename Allocator>
+struct formatter<ba::bytearray_processor<ValueType, Allocator>, char> : ba::detail::byte_formatter<ba::detail::std_format_library> {};
+
+template <typename Allocator>
+struct formatter<ba::bytearray<Allocator>, char> : ba::detail::byte_formatter<ba::detail::std_format_library> {};
+
+template <typename ValueType, typename Allocator>
+struct formatter<ba::bytearray_view<ValueType, Allocator>, char> : ba::detail::byte_formatter<ba::detail::std_format_library> {};
+}  // namespace std
+#endif
+
+// fmt formatters are defined if fmt is included before or BA_WITH_FMT is defined
+#if defined(FMT_VERSION)
+namespace ba {
+namespace detail {
+
+struct fmt_format_library {
+    using error = fmt::format_error;
+
+    template <typename OutputIt>
+    static OutputIt write(OutputIt out, const char* data, std::size_t size) {
+        return std::copy_n(data, size, out);
+    }
+};
+
+}  // namespace detail
+}  // namespace ba
+
+namespace fmt {
+template <typename ValueType, typename Allocator>
+struct formatter<ba::bytearray_reader<ValueType, Allocator>, char> : ba::detail::byte_formatter<ba::detail::fmt_format_library> {};
+
+template <typename ValueType, typename Allocator>
+struct formatter<ba::bytearray_processor<ValueType, Allocator>, char> : ba::detail::byte_formatter<ba::detail::fmt_format_library> {};
+
+template <typename Allocator>
+struct formatter<ba::bytearray<Allocator>, char> : ba::detail::byte_formatter<ba::detail::fmt_format_library> {};
+
+template <typename ValueType, typename Allocator>
+struct formatter<ba::bytearray_view<ValueType, Allocator>, char> : ba::detail::byte_formatter<ba::detail::fmt_format_library> {};
+
+template <typename ValueType, typename Allocator>
+struct is_range<ba::bytearray_reader<ValueType, Allocator>, char> : std::false_type {};
+
+template <typename ValueType, typename Allocator>
+struct is_range<ba::bytearray_processor<ValueType, Allocator>, char> : std::false_type {};
+
+template <typename Allocator>
+struct is_range<ba::bytearray<Allocator>, char> : std::false_type {};
+
+template <typename ValueType, typename Allocator>
+struct is_range<ba::bytearray_view<ValueType, Allocator>, char> : std::false_type {};
+
+#if FMT_VERSION >= 90100
+template <typename ValueType, typename Allocator>
+struct range_format_kind<ba::bytearray_reader<ValueType, Allocator>, char>
+    : std::integral_constant<range_format, range_format::disabled> {};
+
+template <typename ValueType, typename Allocator>
+struct range_format_kind<ba::bytearray_processor<ValueType, Allocator>, char>
+    : std::integral_constant<range_format, range_format::disabled> {};
+
+template <typename Allocator>
+struct range_format_kind<ba::bytearray<Allocator>, char> : std::integral_constant<range_format, range_format::disabled> {};
+
+template <typename ValueType, typename Allocator>
+struct range_format_kind<ba::bytearray_view<ValueType, Allocator>, char>
+    : std::integral_constant<range_format, range_format::disabled> {};
+#endif
+}  // namespace fmt
+#endif
@@ -0,0 +1,337 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_view.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+namespace ba {
+
+namespace detail {
+
+/**
+ * @brief Full 64x64 -> 128 bit multiplication.
+ * Low half is stored to `a` and high half to `b`.
+ */
+inline void multiply_128(uint64_t& a, uint64_t& b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 result = a;
+    result *= b;
+    a = uint64_t(result);
+    b = uint64_t(result >> 64);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32, la = uint32_t(a), lb = uint32_t(b);
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/**
+ * @brief Multiplication with folding of both halves.
+ */
+inline uint64_t hash_mix(uint64_t a, uint64_t b) {
+    multiply_128(a, b);
+    return a ^ b;
+}
+
+/**
+ * @brief Constexpr splitmix64 step, used to generate
+ * long input secret.
+ */
+constexpr uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+constexpr std::array<uint64_t, 32> make_hash_secret() {
+    std::array<uint64_t, 32> secret{};
+    uint64_t state = 0x62612D6861736821ull;
+
+    for (auto& word : secret) {
+        word = splitmix64(state);
+    }
+
+    return secret;
+}
+
+// Short input secret
+constexpr uint64_t hash_keys[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+// Long input secret. 16 stripe keys (+7 lanes) and 8 scramble keys.
+alignas(64) inline constexpr std::array<uint64_t, 32> hash_secret = make_hash_secret();
+
+constexpr std::size_t hash_stripe = 64;
+constexpr std::size_t hash_block_stripes = 16;
+constexpr std::size_t hash_block = hash_stripe * hash_block_stripes;
+constexpr std::size_t hash_long_threshold = 512;
+constexpr uint64_t hash_prime32 = 0x9E3779B1;
+
+/**
+ * @brief Accumulation of single 64 byte stripe into
+ * 8 lane accumulator. Every lane adds its neighbour data
+ * and 32x32 product of keyed data, which maps to
+ * `pmuludq` of SSE2 / AVX2.
+ */
+inline void hash_accumulate(uint64_t* acc, const uint8_t* data, const uint64_t* secret) {
+#if defined(BA_SIMD_AVX2)
+    for (std::size_t i = 0; i < 8; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + i));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 8));
+        __m256i k = _mm256_xor_si256(d, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret + i)));
+        __m256i product = _mm256_mul_epu32(k, _mm256_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m256i swapped = _mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+
+        a = _mm256_add_epi64(a, _mm256_add_epi64(product, swapped));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i), a);
+    }
+#elif defined(BA_SIMD_SSE2)
+    for (std::size_t i = 0; i < 8; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 8));
+        __m128i k = _mm_xor_si128(d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + i)));
+        __m128i product = _mm_mul_epu32(k, _mm_shuffle_epi32(k, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+
+        a = _mm_add_epi64(a, _mm_add_epi64(product, swapped));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), a);
+    }
+#else
+    for (std::size_t i = 0; i < 8; ++i) {
+        uint64_t d = load<uint64_t>(data + i * 8);
+        uint64_t k = d ^ secret[i];
+
+        acc[i ^ 1] += d;
+        acc[i] += (k & 0xFFFFFFFF) * (k >> 32);
+    }
+#endif
+}
+
+/**
+ * @brief Scrambling of accumulator after every block.
+ */
+inline void hash_scramble(uint64_t* acc, const uint64_t* secret) {
+#if defined(BA_SIMD_SSE2)
+    const __m128i prime = _mm_set1_epi32(int(hash_prime32));
+
+    for (std::size_t i = 0; i < 8; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i));
+
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret + i)));
+
+        __m128i low = _mm_mul_epu32(a, prime);
+        __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+    }
+#else
+    for (std::size_t i = 0; i < 8; ++i) {
+        uint64_t a = acc[i];
+
+        a ^= a >> 47;
+        a ^= secret[i];
+        acc[i] = a * hash_prime32;
+    }
+#endif
+}
+
+/**
+ * @brief Final avalanche of 64 bit value.
+ */
+inline uint64_t hash_avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ull;
+    h ^= h >> 32;
+    return h;
+}
+
+/**
+ * @brief Long input hash. Data is processed with 8 lane
+ * accumulator in 1 KiB blocks, last stripe overlaps
+ * previous data. Kept out of line, so short keys
+ * hashing stays small enough for inlining.
+ */
+BA_NOINLINE inline uint64_t hash_long(const uint8_t* data, std::size_t size, uint64_t seed) {
+    alignas(32) uint64_t acc[8] = {hash_prime32,           0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+                                   0x85EBCA77C2B2AE63ull, 0x85EBCA77,            0x27D4EB2F165667C5ull, 0xC2B2AE3D};
+
+    const uint64_t* secret = hash_secret.data();
+    std::size_t blocks = (size - 1) / hash_block;
+
+    for (std::size_t block = 0; block < blocks; ++block) {
+        for (std::size_t stripe = 0; stripe < hash_block_stripes; ++stripe) {
+            hash_accumulate(acc, data + block * hash_block + stripe * hash_stripe, secret + stripe);
+        }
+
+        hash_scramble(acc, secret + 24);
+    }
+
+    const uint8_t* tail = data + blocks * hash_block;
+    std::size_t stripes = (size - blocks * hash_block - 1) / hash_stripe;
+
+    for (std::size_t stripe = 0; stripe < stripes; ++stripe) {
+        hash_accumulate(acc, tail + stripe * hash_stripe, secret + stripe);
+    }
+
+    hash_accumulate(acc, data + size - hash_stripe, secret + 13);
+
+    uint64_t result = size * 0x9E3779B185EBCA87ull + seed;
+
+    for (std::size_t i = 0; i < 8; i += 2) {
+        result += hash_mix(acc[i] ^ secret[i + 16], acc[i + 1] ^ secret[i + 17]);
+    }
+
+    return hash_avalanche(result);
+}
+
+inline uint64_t read_small(const uint8_t* data, std::size_t size) {
+    return (uint64_t(data[0]) << 16) | (uint64_t(data[size >> 1]) << 8) | data[size - 1];
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for calculating fast non cryptographic
+ * 64 bit hash. Inputs up to 512 bytes are processed with
+ * wyhash-like multiply-mix, longer inputs with SIMD friendly
+ * 8 lane accumulator.
+ * Result does not depend on available instruction set.
+ * @param data Pointer to data.
+ * @param size Size in bytes.
+ * @param seed Seed.
+ * @return Hash value.
+ */
+inline uint64_t hash64(const void* data, std::size_t size, uint64_t seed = 0) {
+    using detail::hash_keys;
+    using detail::hash_mix;
+    using detail::load;
+
+    auto p = static_cast<const uint8_t*>(data);
+
+    if (size >= detail::hash_long_threshold) {
+        return detail::hash_long(p, size, seed);
+    }
+
+    seed ^= hash_mix(seed ^ hash_keys[0], hash_keys[1]);
+
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    if (size <= 16) {
+        if (size >= 4) {
+            a = (uint64_t(load<uint32_t>(p)) << 32) | load<uint32_t>(p + ((size >> 3) << 2));
+            b = (uint64_t(load<uint32_t>(p + size - 4)) << 32) | load<uint32_t>(p + size - 4 - ((size >> 3) << 2));
+        } else if (size > 0) {
+            a = detail::read_small(p, size);
+        }
+    } else {
+        std::size_t i = size;
+
+        if (i > 48) {
+            uint64_t see1 = seed;
+            uint64_t see2 = seed;
+
+            do {
+                seed = hash_mix(load<uint64_t>(p) ^ hash_keys[1], load<uint64_t>(p + 8) ^ seed);
+                see1 = hash_mix(load<uint64_t>(p + 16) ^ hash_keys[2], load<uint64_t>(p + 24) ^ see1);
+                see2 = hash_mix(load<uint64_t>(p + 32) ^ hash_keys[3], load<uint64_t>(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+
+            seed ^= see1 ^ see2;
+        }
+
+        while (i > 16) {
+            seed = hash_mix(load<uint64_t>(p) ^ hash_keys[1], load<uint64_t>(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+
+        a = load<uint64_t>(p + i - 16);
+        b = load<uint64_t>(p + i - 8);
+    }
+
+    a ^= hash_keys[1];
+    b ^= seed;
+    detail::multiply_128(a, b);
+
+    return hash_mix(a ^ hash_keys[0] ^ size, b ^ hash_keys[1]);
+}
+
+/**
+ * @brief Function for calculating hash of byte array.
+ */
+template <typename ValueType, typename Allocator>
+uint64_t hash64(const bytearray_reader<ValueType, Allocator>& reader, uint64_t seed = 0) {
+    return hash64(reader.data(), reader.size(), seed);
+}
+
+/**
+ * @brief Function for calculating hash of byte array view.
+ */
+template <typename ValueType, typename Allocator>
+uint64_t hash64(const bytearray_view<ValueType, Allocator>& view, uint64_t seed = 0) {
+    return hash64(view.data(), view.size(), seed);
+}
+
+/**
+ * @brief Transparent hasher for `bytearray` and `bytearray_view`.
+ * Both types produce equal hashes for equal content, so
+ * view can be used for heterogeneous lookup in containers,
+ * keyed by owning arrays (with `bytearray_equal`).
+ */
+struct bytearray_hash {
+    using is_transparent = void;
+
+    template <typename ValueType, typename Allocator>
+    std::size_t operator()(const bytearray_reader<ValueType, Allocator>& reader) const {
+        return std::size_t(hash64(reader));
+    }
+
+    template <typename ValueType, typename Allocator>
+    std::size_t operator()(const bytearray_view<ValueType, Allocator>& view) const {
+        return std::size_t(hash64(view));
+    }
+};
+
+/**
+ * @brief Transparent equality for `bytearray` and
+ * `bytearray_view` in any combination.
+ */
+struct bytearray_equal {
+    using is_transparent = void;
+
+    template <typename Lhs, typename Rhs>
+    bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+        return lhs == rhs;
+    }
+};
+
+}  // namespace ba
+
+// Allowed
+namespace std {
+template <typename Allocator>
+struct hash<ba::bytearray<Allocator>> {
+    std::size_t operator()(const ba::bytearray<Allocator>& array) const { return std::size_t(ba::hash64(array)); }
+};
+
+template <typename ValueType, typename Allocator>
+struct hash<ba::bytearray_view<ValueType, Allocator>> {
+    std::size_t operator()(const ba::bytearray_view<ValueType, Allocator>& view) const { return std::size_t(ba::hash64(view)); }
+};
+}  // namespace std
@@ -0,0 +1,194 @@
+#pragma once
+
+// ba
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ba {
+
+/**
+ * @brief Amount of every byte value.
+ */
+using byte_histogram = std::array<uint64_t, 256>;
+
+namespace detail {
+
+// Smallest part of input, that is worth a thread
+constexpr std::size_t histogram_min_partition = std::size_t(1) << 20;
+
+// Bytes, counted by 32 bit counters before flush
+constexpr std::size_t histogram_flush = std::size_t(1) << 31;
+
+/**
+ * @brief Function for adding amounts of bytes to
+ * histogram. Every byte of 8 byte word goes to its own
+ * table, so runs of equal bytes don't wait for store of
+ * previous increment of the same counter.
+ */
+inline void histogram_bytes(const uint8_t* data, std::size_t size, uint64_t* counts) {
+    while (size != 0) {
+        auto part = std::min(size, histogram_flush);
+
+        uint32_t tables[8][256] = {};
+        std::size_t position = 0;
+
+        for (; position + 8 <= part; position += 8) {
+            auto word = load<uint64_t>(data + position);
+
+            ++tables[0][word & 0xFF];
+            ++tables[1][(word >> 8) & 0xFF];
+            ++tables[2][(word >> 16) & 0xFF];
+            ++tables[3][(word >> 24) & 0xFF];
+            ++tables[4][(word >> 32) & 0xFF];
+            ++tables[5][(word >> 40) & 0xFF];
+            ++tables[6][(word >> 48) & 0xFF];
+            ++tables[7][word >> 56];
+        }
+
+        for (; position < part; ++position) {
+            ++tables[0][data[position]];
+        }
+
+        for (std::size_t value = 0; value < 256; ++value) {
+            uint64_t sum = 0;
+
+            for (auto& table : tables) {
+                sum += table[value];
+            }
+
+            counts[value] += sum;
+        }
+
+        data += part;
+        size -= part;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for counting every byte value.
+ * Large input may be split to equal parts, that are
+ * counted by separate threads and merged.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param threads Maximum amount of threads (including
+ * calling one), 0 - hardware concurrency. Every thread
+ * gets at least 1 MiB.
+ * @return Histogram.
+ */
+inline byte_histogram histogram(const void* data, std::size_t size, unsigned threads = 1) {
+    auto input = static_cast<const uint8_t*>(data);
+    byte_histogram result{};
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto parts = std::min<std::size_t>(threads, std::max<std::size_t>(1, size / detail::histogram_min_partition));
+
+    if (parts == 1) {
+        detail::histogram_bytes(input, size, result.data());
+        return result;
+    }
+
+    auto part = size / parts;
+
+    std::vector<byte_histogram> partial(parts - 1);
+    std::vector<std::thread> workers;
+
+    workers.reserve(parts - 1);
+
+    try {
+        for (std::size_t i = 1; i < parts; ++i) {
+            auto length = i + 1 == parts ? size - i * part : part;
+
+            workers.emplace_back([input, i, part, length, &partial] { detail::histogram_bytes(input + i * part, length, partial[i - 1].data()); });
+        }
+    } catch (...) {
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        throw;
+    }
+
+    detail::histogram_bytes(input, part, result.data());
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (auto& counts : partial) {
+        for (std::size_t value = 0; value < 256; ++value) {
+            result[value] += counts[value];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for counting every byte value
+ * of byte array, reader or view.
+ */
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, byte_histogram>::type histogram(const Sequence& sequence,
+                                                                                                   unsigned threads = 1) {
+    return histogram(detail::byte_data(sequence), detail::byte_size(sequence), threads);
+}
+
+/**
+ * @brief Function for calculating Shannon entropy
+ * of byte distribution.
+ * @return Bits per byte: 0 - single value, 8 - uniform
+ * distribution (compressed or encrypted data).
+ */
+inline double entropy(const byte_histogram& histogram) {
+    uint64_t total = 0;
+
+    for (auto count : histogram) {
+        total += count;
+    }
+
+    if (total == 0) {
+        return 0.0;
+    }
+
+    double result = 0.0;
+
+    for (auto count : histogram) {
+        if (count != 0) {
+            auto probability = double(count) / double(total);
+
+            result -= probability * std::log2(probability);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for calculating Shannon entropy
+ * of memory block in bits per byte.
+ */
+inline double entropy(const void* data, std::size_t size, unsigned threads = 1) {
+    return entropy(histogram(data, size, threads));
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, double>::type entropy(const Sequence& sequence, unsigned threads = 1) {
+    return entropy(histogram(sequence, threads));
+}
+
+}  // namespace ba
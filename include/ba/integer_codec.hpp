@@ -0,0 +1,664 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_processor.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+#include <ba/detail/varint.hpp>
+#include <ba/endianness.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ba {
+
+/**
+ * @brief Transform, that's applied to integers
+ * before bit packing.
+ * `frame_of_reference` - values are stored as
+ * difference with minimal value of block.
+ * `delta` - values are stored as difference with
+ * value, that's 4 (2 for 64 bit values) positions
+ * before. Sorted columns (ids, timestamps) give
+ * small differences.
+ */
+enum class integer_encoding : uint8_t { frame_of_reference = 0, delta = 1 };
+
+namespace detail {
+
+/**
+ * @brief Amount of values in bit packed block.
+ */
+constexpr std::size_t integer_block_size = 128;
+
+template <typename T>
+inline T load_little(const uint8_t* data) {
+    auto value = load<T>(data);
+    return system_endianness() == endianness::little ? value : byte_swap(value);
+}
+
+template <typename T>
+inline void store_little(uint8_t* data, T value) {
+    store<T>(data, system_endianness() == endianness::little ? value : byte_swap(value));
+}
+
+template <typename T>
+inline T integer_mask(unsigned bits) {
+    return bits >= 8 * sizeof(T) ? std::numeric_limits<T>::max() : T((T(1) << bits) - 1);
+}
+
+#if defined(BA_SIMD_SSE2)
+/**
+ * @brief SSE2 lane operations for 32 and 64 bit values.
+ */
+template <typename T>
+struct integer_lanes;
+
+template <>
+struct integer_lanes<uint32_t> {
+    static __m128i set1(uint32_t value) { return _mm_set1_epi32(int(value)); }
+    static __m128i add(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+    static __m128i shift_left(__m128i a, unsigned count) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(int(count))); }
+    static __m128i shift_right(__m128i a, unsigned count) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(int(count))); }
+};
+
+template <>
+struct integer_lanes<uint64_t> {
+    static __m128i set1(uint64_t value) { return _mm_set1_epi64x(int64_t(value)); }
+    static __m128i add(__m128i a, __m128i b) { return _mm_add_epi64(a, b); }
+    static __m128i shift_left(__m128i a, unsigned count) { return _mm_sll_epi64(a, _mm_cvtsi32_si128(int(count))); }
+    static __m128i shift_right(__m128i a, unsigned count) { return _mm_srl_epi64(a, _mm_cvtsi32_si128(int(count))); }
+};
+#endif
+
+/**
+ * @brief Function for bit packing of block. Layout is
+ * vertical (SIMD-BP128): value `i` goes to lane `i % lanes`
+ * of 16 byte words, so every row of block is packed with
+ * single vector shift. Scalar path writes the same layout.
+ * @param input `integer_block_size` values, that fit into `bits`.
+ * @param bits Bit width.
+ * @param output Output with `16 * bits` bytes.
+ */
+template <typename T>
+void pack_integer_block(const T* input, unsigned bits, uint8_t* output) {
+    constexpr unsigned width = 8 * sizeof(T);
+    constexpr std::size_t lanes = 16 / sizeof(T);
+    constexpr std::size_t rows = integer_block_size / lanes;
+
+    if (bits == 0) {
+        return;
+    }
+
+#if defined(BA_SIMD_SSE2)
+    using ops = integer_lanes<T>;
+
+    auto accumulator = _mm_setzero_si128();
+    unsigned filled = 0;
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + row * lanes));
+
+        accumulator = _mm_or_si128(accumulator, ops::shift_left(value, filled));
+        filled += bits;
+
+        if (filled >= width) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), accumulator);
+            output += 16;
+            filled -= width;
+            accumulator = filled ? ops::shift_right(value, bits - filled) : _mm_setzero_si128();
+        }
+    }
+#else
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        T accumulator = 0;
+        unsigned filled = 0;
+        std::size_t word = 0;
+
+        for (std::size_t row = 0; row < rows; ++row) {
+            T value = input[row * lanes + lane];
+
+            accumulator |= T(value << filled);
+            filled += bits;
+
+            if (filled >= width) {
+                store_little(output + (word++ * lanes + lane) * sizeof(T), accumulator);
+                filled -= width;
+                accumulator = filled ? T(value >> (bits - filled)) : T(0);
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Function for decoding of block with bit
+ * width, that's known at compile time, so shifts are
+ * immediates after unrolling. Reference and delta are
+ * applied to unpacked rows in registers.
+ */
+template <typename T, unsigned Bits>
+void decode_integer_block(const uint8_t* input, T* output, T reference, T base, integer_encoding encoding) {
+    constexpr unsigned width = 8 * sizeof(T);
+    constexpr std::size_t lanes = 16 / sizeof(T);
+    constexpr std::size_t rows = integer_block_size / lanes;
+
+#if defined(BA_SIMD_SSE2)
+    using ops = integer_lanes<T>;
+
+    auto mask = ops::set1(integer_mask<T>(Bits));
+    auto offset = ops::set1(reference);
+    auto previous = ops::set1(base);
+    auto current = Bits ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)) : _mm_setzero_si128();
+    bool delta = encoding == integer_encoding::delta;
+    unsigned shift = 0;
+    std::size_t word = 0;
+
+#if defined(__GNUC__)
+#pragma GCC unroll 64
+#endif
+    for (std::size_t row = 0; row < rows; ++row) {
+        auto value = ops::shift_right(current, shift);
+
+        shift += Bits;
+
+        if (Bits != 0 && shift >= width) {
+            shift -= width;
+
+            if (++word < Bits) {
+                current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + 16 * word));
+
+                if (shift) {
+                    value = _mm_or_si128(value, ops::shift_left(current, Bits - shift));
+                }
+            }
+        }
+
+        value = ops::add(_mm_and_si128(value, mask), offset);
+
+        if (delta) {
+            value = previous = ops::add(previous, value);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + row * lanes), value);
+    }
+#else
+    auto mask = integer_mask<T>(Bits);
+
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        std::size_t word = 0;
+        unsigned shift = 0;
+        T current = Bits ? load_little<T>(input + lane * sizeof(T)) : T(0);
+        T previous = base;
+
+        for (std::size_t row = 0; row < rows; ++row) {
+            T value = T(current >> shift);
+
+            shift += Bits;
+
+            if (Bits != 0 && shift >= width) {
+                shift -= width;
+
+                if (++word < Bits) {
+                    current = load_little<T>(input + (word * lanes + lane) * sizeof(T));
+
+                    if (shift) {
+                        value |= T(current << (Bits - shift));
+                    }
+                }
+            }
+
+            value = T((value & mask) + reference);
+
+            if (encoding == integer_encoding::delta) {
+                value = previous = T(previous + value);
+            }
+
+            output[row * lanes + lane] = value;
+        }
+    }
+#endif
+}
+
+template <typename T, std::size_t... Bits>
+void decode_integer_block(const uint8_t* input,
+                          unsigned bits,
+                          T* output,
+                          T reference,
+                          T base,
+                          integer_encoding encoding,
+                          std::index_sequence<Bits...>) {
+    using function = void (*)(const uint8_t*, T*, T, T, integer_encoding);
+
+    static constexpr function functions[] = {&decode_integer_block<T, unsigned(Bits)>...};
+
+    functions[bits](input, output, reference, base, encoding);
+}
+
+/**
+ * @brief Function for decoding of block, that's
+ * packed with `pack_integer_block`.
+ * @param input Input with `16 * bits` bytes.
+ * @param bits Bit width.
+ * @param output Output for `integer_block_size` values.
+ * @param reference Reference, that's added to values.
+ * @param base Value before block (delta encoding).
+ * @param encoding Encoding.
+ */
+template <typename T>
+void decode_integer_block(const uint8_t* input, unsigned bits, T* output, T reference, T base, integer_encoding encoding) {
+    assert(bits <= 8 * sizeof(T) && "Bit width is bigger, than value.");
+
+    decode_integer_block(input, bits, output, reference, base, encoding, std::make_index_sequence<8 * sizeof(T) + 1>());
+}
+
+/**
+ * @brief Function for reading single value of
+ * packed block without unpacking.
+ */
+template <typename T>
+T extract_integer(const uint8_t* input, unsigned bits, std::size_t index) {
+    constexpr unsigned width = 8 * sizeof(T);
+    constexpr std::size_t lanes = 16 / sizeof(T);
+
+    if (bits == 0) {
+        return 0;
+    }
+
+    auto lane = index % lanes;
+    auto bit = (index / lanes) * bits;
+    auto word = bit / width;
+    auto shift = unsigned(bit % width);
+
+    T value = T(load_little<T>(input + (word * lanes + lane) * sizeof(T)) >> shift);
+
+    if (shift + bits > width) {
+        value |= T(load_little<T>(input + ((word + 1) * lanes + lane) * sizeof(T)) << (width - shift));
+    }
+
+    return T(value & integer_mask<T>(bits));
+}
+
+/**
+ * @brief Function for transforming block before packing.
+ * @param values `integer_block_size` values.
+ * @param base Value before block (delta encoding).
+ * @param encoding Encoding.
+ * @param output Differences with reference.
+ * @param reference Minimal difference.
+ * @return Bit width of differences.
+ */
+template <typename T>
+unsigned prepare_integer_block(const T* values, T base, integer_encoding encoding, T* output, T& reference) {
+    constexpr std::size_t lanes = 16 / sizeof(T);
+
+    if (encoding == integer_encoding::delta) {
+        for (std::size_t i = 0; i < lanes; ++i) {
+            output[i] = T(values[i] - base);
+        }
+
+        for (std::size_t i = lanes; i < integer_block_size; ++i) {
+            output[i] = T(values[i] - values[i - lanes]);
+        }
+    } else {
+        std::copy(values, values + integer_block_size, output);
+    }
+
+    auto minimum = output[0];
+    auto maximum = output[0];
+
+    for (std::size_t i = 1; i < integer_block_size; ++i) {
+        minimum = std::min(minimum, output[i]);
+        maximum = std::max(maximum, output[i]);
+    }
+
+    for (std::size_t i = 0; i < integer_block_size; ++i) {
+        output[i] = T(output[i] - minimum);
+    }
+
+    reference = minimum;
+
+    return maximum == minimum ? 0 : highest_bit(uint64_t(maximum - minimum)) + 1;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for encoding integers with
+ * frame of reference or delta and bit packing. Every
+ * 128 values form block with 16 * bit width bytes, last
+ * values are stored as LEB128 varints.
+ * Layout: varint count, encoding byte, value size byte,
+ * blocks (bit width byte, varint reference, varint base
+ * for delta, packed values) and tail (varint base for
+ * delta, varints).
+ * @tparam T `uint32_t` or `uint64_t`.
+ * @param target Byte array or processor, data is appended to.
+ * @param values Pointer to values.
+ * @param count Amount of values.
+ * @param encoding Encoding.
+ * @return Amount of written bytes.
+ */
+template <typename T, typename ValueType, typename Allocator>
+typename std::enable_if<std::is_same<T, uint32_t>::value || std::is_same<T, uint64_t>::value, std::size_t>::type
+encode_integers(bytearray_processor<ValueType, Allocator>& target,
+                const T* values,
+                std::size_t count,
+                integer_encoding encoding = integer_encoding::frame_of_reference) {
+    auto& container = target.container();
+    auto start = container.size();
+
+    target.push_back_varint(uint64_t(count));
+    target.template push_back<uint8_t>(uint8_t(encoding));
+    target.template push_back<uint8_t>(uint8_t(sizeof(T)));
+
+    T block[detail::integer_block_size];
+    T base = 0;
+    std::size_t position = 0;
+
+    for (; position + detail::integer_block_size <= count; position += detail::integer_block_size) {
+        T reference;
+        auto bits = detail::prepare_integer_block(values + position, base, encoding, block, reference);
+
+        target.template push_back<uint8_t>(uint8_t(bits));
+        target.push_back_varint(reference);
+
+        if (encoding == integer_encoding::delta) {
+            target.push_back_varint(base);
+        }
+
+        auto offset = container.size();
+
+        container.resize(offset + 16 * bits);
+
+        detail::pack_integer_block(block, bits, reinterpret_cast<uint8_t*>(container.data() + offset));
+
+        base = values[position + detail::integer_block_size - 1];
+    }
+
+    if (position < count && encoding == integer_encoding::delta) {
+        target.push_back_varint(base);
+    }
+
+    for (; position < count; ++position) {
+        if (encoding == integer_encoding::delta) {
+            target.push_back_varint(T(values[position] - base));
+            base = values[position];
+        } else {
+            target.push_back_varint(values[position]);
+        }
+    }
+
+    return container.size() - start;
+}
+
+/**
+ * @brief Function for encoding vector of integers.
+ */
+template <typename T, typename VectorAllocator, typename ValueType, typename Allocator>
+typename std::enable_if<std::is_same<T, uint32_t>::value || std::is_same<T, uint64_t>::value, std::size_t>::type
+encode_integers(bytearray_processor<ValueType, Allocator>& target,
+                const std::vector<T, VectorAllocator>& values,
+                integer_encoding encoding = integer_encoding::frame_of_reference) {
+    return encode_integers(target, values.data(), values.size(), encoding);
+}
+
+/**
+ * @brief Class, that implements decoding of integers,
+ * encoded with `encode_integers`. Offsets of blocks are
+ * collected on construction (headers only), so any
+ * block or value can be read without decoding of
+ * previous ones.
+ * @tparam T `uint32_t` or `uint64_t`.
+ */
+template <typename T>
+class integer_decoder {
+    static_assert(std::is_same<T, uint32_t>::value || std::is_same<T, uint64_t>::value, "Only uint32_t and uint64_t are supported");
+
+public:
+    /**
+     * @brief Amount of values in block.
+     */
+    static constexpr std::size_t block_size = detail::integer_block_size;
+
+    /**
+     * @brief Constructor. Throws `std::runtime_error`
+     * if data is truncated or encoded with other type.
+     * @param data Pointer to data.
+     * @param size Size of data. May contain data after encoded integers.
+     */
+    integer_decoder(const void* data, std::size_t size)
+        : m_data(static_cast<const uint8_t*>(data))
+        , m_count(0)
+        , m_encoding(integer_encoding::frame_of_reference)
+        , m_size(0) {
+        std::size_t position = 0;
+        uint64_t count;
+
+        position += read_varint(position, size, count);
+
+        if (size - position < 2 || m_data[position] > uint8_t(integer_encoding::delta) || m_data[position + 1] != sizeof(T)) {
+            throw std::runtime_error("Unknown integer encoding");
+        }
+
+        m_count = std::size_t(count);
+        m_encoding = integer_encoding(m_data[position]);
+        position += 2;
+
+        for (std::size_t block = 0; block < m_count / block_size; ++block) {
+            m_offsets.push_back(position);
+
+            if (position >= size || m_data[position] > 8 * sizeof(T)) {
+                throw std::runtime_error("Integer block is invalid");
+            }
+
+            auto bits = m_data[position++];
+            uint64_t value;
+
+            position += read_varint(position, size, value);
+
+            if (m_encoding == integer_encoding::delta) {
+                position += read_varint(position, size, value);
+            }
+
+            if (size - position < 16u * bits) {
+                throw std::runtime_error("Integer block is truncated");
+            }
+
+            position += 16u * bits;
+        }
+
+        if (m_count % block_size != 0) {
+            m_offsets.push_back(position);
+
+            uint64_t value;
+
+            for (std::size_t i = (m_encoding == integer_encoding::delta ? 0 : 1); i <= m_count % block_size; ++i) {
+                position += read_varint(position, size, value);
+            }
+        }
+
+        m_size = position;
+    }
+
+    /**
+     * @brief Constructor for byte array, it's
+     * reader, processor or view.
+     */
+    template <typename Sequence, typename = typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type>
+    explicit integer_decoder(const Sequence& sequence)
+        : integer_decoder(detail::byte_data(sequence), detail::byte_size(sequence)) {}
+
+    /**
+     * @brief Method for getting amount of values.
+     */
+    std::size_t size() const { return m_count; }
+
+    /**
+     * @brief Method for getting amount of bytes,
+     * taken by encoded integers.
+     */
+    std::size_t encoded_size() const { return m_size; }
+
+    /**
+     * @brief Method for getting encoding.
+     */
+    integer_encoding encoding() const { return m_encoding; }
+
+    /**
+     * @brief Method for getting amount of blocks
+     * (including incomplete last one).
+     */
+    std::size_t blocks() const { return m_offsets.size(); }
+
+    /**
+     * @brief Method for getting offset of block
+     * in encoded data.
+     */
+    std::size_t block_offset(std::size_t block) const {
+        assert(block < blocks() && "Block is out of range.");
+
+        return m_offsets[block];
+    }
+
+    /**
+     * @brief Method for decoding single block.
+     * @param block Block index.
+     * @param output Output for up to `block_size` values.
+     * @return Amount of decoded values.
+     */
+    std::size_t decode_block(std::size_t block, T* output) const {
+        assert(block < blocks() && "Block is out of range.");
+
+        auto data = m_data + m_offsets[block];
+        uint64_t value = 0;
+        T base = 0;
+
+        if (block < m_count / block_size) {
+            unsigned bits = *data++;
+            T reference;
+
+            data += detail::decode_varint(data, detail::max_varint_size, value);
+            reference = T(value);
+
+            if (m_encoding == integer_encoding::delta) {
+                data += detail::decode_varint(data, detail::max_varint_size, value);
+                base = T(value);
+            }
+
+            detail::decode_integer_block(data, bits, output, reference, base, m_encoding);
+
+            return block_size;
+        }
+
+        // Tail is validated on construction
+        if (m_encoding == integer_encoding::delta) {
+            data += detail::decode_varint(data, detail::max_varint_size, value);
+            base = T(value);
+        }
+
+        auto count = m_count % block_size;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            data += detail::decode_varint(data, detail::max_varint_size, value);
+
+            output[i] = m_encoding == integer_encoding::delta ? (base = T(base + T(value))) : T(value);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Method for decoding all values.
+     * @param output Output for `size()` values.
+     */
+    void decode(T* output) const {
+        for (std::size_t block = 0; block < blocks(); ++block) {
+            output += decode_block(block, output);
+        }
+    }
+
+    /**
+     * @brief Method for decoding all values to
+     * the end of vector.
+     */
+    template <typename VectorAllocator>
+    void decode(std::vector<T, VectorAllocator>& output) const {
+        auto offset = output.size();
+
+        output.resize(offset + m_count);
+
+        decode(output.data() + offset);
+    }
+
+    /**
+     * @brief Method for getting single value. Frame
+     * of reference values are read without unpacking,
+     * delta encoded block is decoded.
+     * @param index Index of value.
+     */
+    T at(std::size_t index) const {
+        assert(index < m_count && "Index is out of range.");
+
+        auto block = index / block_size;
+
+        if (block < m_count / block_size && m_encoding == integer_encoding::frame_of_reference) {
+            auto data = m_data + m_offsets[block];
+            unsigned bits = *data++;
+            uint64_t reference = 0;
+
+            data += detail::decode_varint(data, detail::max_varint_size, reference);
+
+            return T(detail::extract_integer<T>(data, bits, index % block_size) + T(reference));
+        }
+
+        T values[block_size];
+
+        decode_block(block, values);
+
+        return values[index % block_size];
+    }
+
+private:
+    std::size_t read_varint(std::size_t position, std::size_t size, uint64_t& value) const {
+        auto length = position < size ? detail::decode_varint(m_data + position, size - position, value) : 0;
+
+        if (length == 0 || value > std::numeric_limits<T>::max()) {
+            throw std::runtime_error("Integer varint is invalid");
+        }
+
+        return length;
+    }
+
+    const uint8_t* m_data;
+    std::size_t m_count;
+    integer_encoding m_encoding;
+    std::size_t m_size;
+    std::vector<std::size_t> m_offsets;
+};
+
+/**
+ * @brief Function for decoding all integers of
+ * byte array, it's reader or view, to the end of vector.
+ * Throws `std::runtime_error` on invalid data.
+ * @return Amount of consumed bytes.
+ */
+template <typename Sequence, typename T, typename VectorAllocator>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, std::size_t>::type
+decode_integers(const Sequence& sequence, std::vector<T, VectorAllocator>& output) {
+    integer_decoder<T> decoder(sequence);
+
+    decoder.decode(output);
+
+    return decoder.encoded_size();
+}
+
+}  // namespace ba
@@ -0,0 +1,1004 @@
+#pragma once
+
+// ba
+#include <ba/bytearray.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ba {
+
+namespace detail {
+
+constexpr std::size_t lz4_min_match = 4;
+constexpr std::size_t lz4_last_literals = 5;
+constexpr std::size_t lz4_match_find_limit = 12;
+constexpr std::size_t lz4_max_distance = 65535;
+constexpr unsigned lz4_hash_bits = 12;
+
+constexpr uint32_t lz4_frame_magic = 0x184D2204;
+constexpr uint32_t lz4_skippable_magic = 0x184D2A50;
+
+inline uint32_t lz4_hash(const uint8_t* data) {
+    return (load<uint32_t>(data) * 2654435761U) >> (32 - lz4_hash_bits);
+}
+
+inline uint16_t lz4_read16(const uint8_t* data) {
+    return uint16_t(data[0] | (data[1] << 8));
+}
+
+inline uint32_t lz4_read32(const uint8_t* data) {
+    return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+inline void lz4_write32(uint8_t* data, uint32_t value) {
+    for (std::size_t i = 0; i < 4; ++i) {
+        data[i] = uint8_t(value >> (8 * i));
+    }
+}
+
+inline uint32_t rotate_left(uint32_t value, unsigned count) {
+    return (value << count) | (value >> (32 - count));
+}
+
+/**
+ * @brief Class, that implements incremental XXH32,
+ * that's used by LZ4 frame for header, block and
+ * content checksums.
+ */
+class xxh32 {
+public:
+    static constexpr uint32_t prime1 = 0x9E3779B1U;
+    static constexpr uint32_t prime2 = 0x85EBCA77U;
+    static constexpr uint32_t prime3 = 0xC2B2AE3DU;
+    static constexpr uint32_t prime4 = 0x27D4EB2FU;
+    static constexpr uint32_t prime5 = 0x165667B1U;
+
+    explicit xxh32(uint32_t seed = 0)
+        : m_seed(seed)
+        , m_lanes{seed + prime1 + prime2, seed + prime2, seed, seed - prime1}
+        , m_total(0)
+        , m_buffered(0) {}
+
+    void update(const uint8_t* data, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+
+        m_total += size;
+
+        if (m_buffered + size < 16) {
+            std::memcpy(m_buffer + m_buffered, data, size);
+            m_buffered += size;
+            return;
+        }
+
+        if (m_buffered != 0) {
+            auto fill = 16 - m_buffered;
+
+            std::memcpy(m_buffer + m_buffered, data, fill);
+            consume(m_buffer);
+
+            data += fill;
+            size -= fill;
+            m_buffered = 0;
+        }
+
+        for (; size >= 16; data += 16, size -= 16) {
+            consume(data);
+        }
+
+        std::memcpy(m_buffer, data, size);
+        m_buffered = size;
+    }
+
+    uint32_t digest() const {
+        uint32_t hash = m_total >= 16 ? rotate_left(m_lanes[0], 1) + rotate_left(m_lanes[1], 7) +
+                                            rotate_left(m_lanes[2], 12) + rotate_left(m_lanes[3], 18)
+                                      : m_seed + prime5;
+
+        hash += uint32_t(m_total);
+
+        std::size_t i = 0;
+
+        for (; i + 4 <= m_buffered; i += 4) {
+            hash = rotate_left(hash + lz4_read32(m_buffer + i) * prime3, 17) * prime4;
+        }
+
+        for (; i < m_buffered; ++i) {
+            hash = rotate_left(hash + m_buffer[i] * prime5, 11) * prime1;
+        }
+
+        hash ^= hash >> 15;
+        hash *= prime2;
+        hash ^= hash >> 13;
+        hash *= prime3;
+        hash ^= hash >> 16;
+
+        return hash;
+    }
+
+    static uint32_t hash(const uint8_t* data, std::size_t size, uint32_t seed = 0) {
+        xxh32 state(seed);
+
+        state.update(data, size);
+
+        return state.digest();
+    }
+
+private:
+    void consume(const uint8_t* data) {
+        for (std::size_t i = 0; i < 4; ++i) {
+            m_lanes[i] = rotate_left(m_lanes[i] + lz4_read32(data + 4 * i) * prime2, 13) * prime1;
+        }
+    }
+
+    uint32_t m_seed;
+    uint32_t m_lanes[4];
+    uint64_t m_total;
+    uint8_t m_buffer[16];
+    std::size_t m_buffered;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Function for getting maximum size of
+ * LZ4 block, compressed from `size` bytes.
+ */
+inline std::size_t lz4_compress_bound(std::size_t size) {
+    return size + size / 255 + 16;
+}
+
+/**
+ * @brief Class, that holds hash table of LZ4
+ * compressor. It may be reused by any amount of
+ * calls without clearing: positions of previous
+ * calls are always farther, than 64 KiB.
+ */
+class lz4_state {
+public:
+    lz4_state()
+        : m_table(new uint32_t[std::size_t(1) << detail::lz4_hash_bits]())
+        , m_base(0) {}
+
+    /**
+     * @brief Method for clearing table.
+     */
+    void reset() {
+        std::fill(m_table.get(), m_table.get() + (std::size_t(1) << detail::lz4_hash_bits), 0u);
+        m_base = 0;
+    }
+
+private:
+    friend class lz4_frame_encoder;
+
+    friend std::size_t lz4_compress(const void*, std::size_t, void*, std::size_t, lz4_state&);
+
+    /**
+     * @brief Method for compressing `window[start, end)`.
+     * Data before `start` is history, that may be
+     * referenced by matches.
+     * @return Compressed size or 0 if it's bigger, than capacity.
+     */
+    std::size_t compress(const uint8_t* window, std::size_t start, std::size_t end, uint8_t* output, std::size_t capacity) {
+        using namespace detail;
+
+        // Absolute positions are kept in 32 bits
+        if (m_base + end > 0x7FFFFFFFU) {
+            reset();
+        }
+
+        auto table = m_table.get();
+        auto base = m_base;
+
+        auto absolute = [&](const uint8_t* pointer) { return uint32_t(base + std::size_t(pointer - window)); };
+
+        auto candidate = [&](uint32_t position, const uint8_t* current) -> const uint8_t* {
+            if (position < base || absolute(current) - position > lz4_max_distance) {
+                return nullptr;
+            }
+
+            auto match = window + (position - base);
+
+            return load<uint32_t>(match) == load<uint32_t>(current) ? match : nullptr;
+        };
+
+        const uint8_t* ip = window + start;
+        const uint8_t* anchor = ip;
+        const uint8_t* iend = window + end;
+
+        uint8_t* op = output;
+        uint8_t* oend = output + capacity;
+
+        auto writeLength = [&](std::size_t length) {
+            for (; length >= 255; length -= 255) {
+                *op++ = 255;
+            }
+
+            *op++ = uint8_t(length);
+        };
+
+        if (end - start >= lz4_match_find_limit + 1) {
+            const uint8_t* matchFindLimit = iend - lz4_match_find_limit;
+            const uint8_t* matchLimit = iend - lz4_last_literals;
+
+            table[lz4_hash(ip)] = absolute(ip);
+            ++ip;
+
+            auto forwardHash = lz4_hash(ip);
+
+            for (;;) {
+                // Searching match, step grows on incompressible data
+                const uint8_t* match = nullptr;
+                const uint8_t* forward = ip;
+                unsigned attempts = 1u << 6;
+
+                do {
+                    auto hash = forwardHash;
+
+                    ip = forward;
+                    forward += attempts++ >> 6;
+
+                    if (forward > matchFindLimit) {
+                        goto last_literals;
+                    }
+
+                    forwardHash = lz4_hash(forward);
+                    match = candidate(table[hash], ip);
+                    table[hash] = absolute(ip);
+                } while (match == nullptr);
+
+                while (ip > anchor && match > window && ip[-1] == match[-1]) {
+                    --ip;
+                    --match;
+                }
+
+                auto literals = std::size_t(ip - anchor);
+
+                // Token, literals, offset and end of sequence
+                if (std::size_t(oend - op) < 1 + literals + literals / 255 + 2 + 1 + lz4_last_literals) {
+                    return 0;
+                }
+
+                auto token = op++;
+
+                if (literals >= 15) {
+                    *token = 15 << 4;
+                    writeLength(literals - 15);
+                } else {
+                    *token = uint8_t(literals << 4);
+                }
+
+                std::memcpy(op, anchor, literals);
+                op += literals;
+
+                for (;;) {
+                    auto offset = std::size_t(ip - match);
+
+                    *op++ = uint8_t(offset);
+                    *op++ = uint8_t(offset >> 8);
+
+                    // Counting match length, 8 bytes at once
+                    ip += lz4_min_match;
+                    match += lz4_min_match;
+
+                    auto matchStart = ip;
+
+                    while (ip + 8 <= matchLimit) {
+                        auto difference = load<uint64_t>(ip) ^ load<uint64_t>(match);
+
+                        if (difference != 0) {
+                            ip += count_trailing_zeros(difference) / 8;
+                            goto counted;
+                        }
+
+                        ip += 8;
+                        match += 8;
+                    }
+
+                    while (ip < matchLimit && *ip == *match) {
+                        ++ip;
+                        ++match;
+                    }
+
+                counted:
+                    auto length = std::size_t(ip - matchStart);
+
+                    if (std::size_t(oend - op) < length / 255 + 1 + lz4_last_literals) {
+                        return 0;
+                    }
+
+                    if (length >= 15) {
+                        *token += 15;
+                        writeLength(length - 15);
+                    } else {
+                        *token += uint8_t(length);
+                    }
+
+                    anchor = ip;
+
+                    if (ip >= matchFindLimit) {
+                        goto last_literals;
+                    }
+
+                    table[lz4_hash(ip - 2)] = absolute(ip - 2);
+
+                    // Immediate next match doesn't need literals
+                    auto hash = lz4_hash(ip);
+
+                    match = candidate(table[hash], ip);
+                    table[hash] = absolute(ip);
+
+                    if (match == nullptr) {
+                        break;
+                    }
+
+                    token = op++;
+                    *token = 0;
+                }
+
+                forwardHash = lz4_hash(++ip);
+            }
+        }
+
+    last_literals:
+        auto literals = std::size_t(iend - anchor);
+
+        if (std::size_t(oend - op) < literals + (literals + 255 - 15) / 255 + 1) {
+            return 0;
+        }
+
+        if (literals >= 15) {
+            *op++ = 15 << 4;
+            writeLength(literals - 15);
+        } else {
+            *op++ = uint8_t(literals << 4);
+        }
+
+        if (literals != 0) {
+            std::memcpy(op, anchor, literals);
+            op += literals;
+        }
+
+        return std::size_t(op - output);
+    }
+
+    /**
+     * @brief Method for indexing history (dictionary).
+     */
+    void index(const uint8_t* window, std::size_t size) {
+        if (m_base + size > 0x7FFFFFFFU) {
+            reset();
+        }
+
+        for (std::size_t i = 0; i + detail::lz4_min_match <= size; ++i) {
+            m_table[detail::lz4_hash(window + i)] = uint32_t(m_base + i);
+        }
+    }
+
+    std::unique_ptr<uint32_t[]> m_table;
+    std::size_t m_base;
+};
+
+/**
+ * @brief Function for compressing data to
+ * LZ4 block format.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param output Output buffer (`lz4_compress_bound(size)`
+ * bytes is always enough).
+ * @param capacity Size of output buffer.
+ * @param state Reusable state.
+ * @return Compressed size or 0 if output buffer is too small.
+ */
+inline std::size_t lz4_compress(const void* data, std::size_t size, void* output, std::size_t capacity, lz4_state& state) {
+    auto result = state.compress(static_cast<const uint8_t*>(data), 0, size, static_cast<uint8_t*>(output), capacity);
+
+    // Next call can't reach positions of this one
+    state.m_base += size + detail::lz4_max_distance + 1;
+
+    return result;
+}
+
+/**
+ * @brief Function for compressing byte array,
+ * it's reader or view to LZ4 block format.
+ */
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bytearray<>>::type lz4_compress(const Sequence& sequence,
+                                                                                                     lz4_state& state) {
+    auto size = detail::byte_size(sequence);
+
+    bytearray<> result(lz4_compress_bound(size));
+
+    auto& container = result.container();
+
+    container.resize(lz4_compress(detail::byte_data(sequence), size, container.data(), container.size(), state));
+
+    return result;
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bytearray<>>::type lz4_compress(const Sequence& sequence) {
+    lz4_state state;
+
+    return lz4_compress(sequence, state);
+}
+
+namespace detail {
+
+/**
+ * @brief Function for copying 16 bytes blocks, it
+ * may write up to 15 bytes after `output + size`.
+ */
+inline void wild_copy(uint8_t* output, const uint8_t* input, std::size_t size) {
+    auto end = output + size;
+
+    do {
+#if defined(BA_SIMD_SSE2)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_loadu_si128(reinterpret_cast<const __m128i*>(input)));
+#else
+        std::memcpy(output, input, 16);
+#endif
+        output += 16;
+        input += 16;
+    } while (output < end);
+}
+
+/**
+ * @brief Function for decompressing LZ4 block.
+ * All reads and writes are checked, wild copies are
+ * used only far from the end of buffers.
+ * @param data Block.
+ * @param size Size of block.
+ * @param output Output.
+ * @param capacity Size of output.
+ * @param prefix Start of previous output, that may
+ * be referenced (`output` if there's no one).
+ * @param dictionary External dictionary, that's
+ * placed before `prefix`.
+ * @param dictionarySize Size of dictionary.
+ * @return Decompressed size or `std::size_t(-1)` on error.
+ */
+inline std::size_t lz4_decompress(const uint8_t* data,
+                                  std::size_t size,
+                                  uint8_t* output,
+                                  std::size_t capacity,
+                                  const uint8_t* prefix,
+                                  const uint8_t* dictionary,
+                                  std::size_t dictionarySize) {
+    constexpr std::size_t error = std::size_t(-1);
+
+    const uint8_t* ip = data;
+    const uint8_t* iend = data + size;
+    uint8_t* op = output;
+    uint8_t* oend = output + capacity;
+
+    auto readLength = [&](std::size_t& length) {
+        uint8_t byte;
+
+        do {
+            if (ip >= iend) {
+                return false;
+            }
+
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+
+        return true;
+    };
+
+    if (size == 0) {
+        return error;
+    }
+
+    for (;;) {
+        // Block can't end with match, last literals are required
+        if (ip >= iend) {
+            return error;
+        }
+
+        auto token = *ip++;
+        std::size_t length = token >> 4;
+
+        // Short literals far from the end of buffers: fixed size copies
+        if (length < 15 && iend - ip >= 32 && oend - op >= 64) {
+            wild_copy(op, ip, 16);
+            op += length;
+            ip += length;
+
+            std::size_t offset = lz4_read16(ip);
+            std::size_t matchLength = token & 15;
+            const uint8_t* next = ip + 2;
+
+            for (uint8_t byte = 255; matchLength >= 15 && byte == 255 && next < iend;) {
+                byte = *next++;
+                matchLength += byte;
+            }
+
+            matchLength += lz4_min_match;
+
+            if (offset >= 8 && offset <= std::size_t(op - prefix) && next < iend && std::size_t(oend - op) >= matchLength + 16) {
+                const uint8_t* match = op - offset;
+
+                if (offset >= 16) {
+                    wild_copy(op, match, matchLength);
+                } else {
+                    for (std::size_t i = 0; i < matchLength; i += 8) {
+                        std::memcpy(op + i, match + i, 8);
+                    }
+                }
+
+                ip = next;
+                op += matchLength;
+                continue;
+            }
+
+            // Literals are written, match is decoded by generic path
+            op -= length;
+            ip -= length;
+        }
+
+        if (length == 15 && !readLength(length)) {
+            return error;
+        }
+
+        if (length > std::size_t(iend - ip) || length > std::size_t(oend - op)) {
+            return error;
+        }
+
+        if (length <= 16 && iend - ip >= 16 && oend - op >= 16) {
+            wild_copy(op, ip, 16);
+        } else if (length != 0) {
+            // Output of empty block may be null
+            std::memcpy(op, ip, length);
+        }
+
+        ip += length;
+        op += length;
+
+        // Last sequence has only literals
+        if (ip == iend) {
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return error;
+        }
+
+        std::size_t offset = lz4_read16(ip);
+
+        ip += 2;
+        length = token & 15;
+
+        if (length == 15 && !readLength(length)) {
+            return error;
+        }
+
+        length += lz4_min_match;
+
+        auto available = std::size_t(op - prefix);
+
+        if (offset == 0 || length > std::size_t(oend - op) || offset > available + dictionarySize) {
+            return error;
+        }
+
+        if (offset > available) {
+            // Match starts in external dictionary
+            auto back = offset - available;
+            auto part = std::min(back, length);
+
+            std::memcpy(op, dictionary + dictionarySize - back, part);
+            op += part;
+            length -= part;
+
+            for (auto match = prefix; length > 0; --length) {
+                *op++ = *match++;
+            }
+
+            continue;
+        }
+
+        const uint8_t* match = op - offset;
+
+        if (offset >= 16 && std::size_t(oend - op) >= length + 16) {
+            wild_copy(op, match, length);
+        } else if (offset == 1) {
+            std::memset(op, *match, length);
+        } else if (offset >= 8 && std::size_t(oend - op) >= length + 8) {
+            for (std::size_t i = 0; i < length; i += 8) {
+                std::memcpy(op + i, match + i, 8);
+            }
+        } else {
+            for (std::size_t i = 0; i < length; ++i) {
+                op[i] = match[i];
+            }
+        }
+
+        op += length;
+    }
+
+    return std::size_t(op - output);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for decompressing LZ4 block.
+ * @param data Pointer to block.
+ * @param size Size of block.
+ * @param output Output buffer.
+ * @param outputSize Size of output buffer on input,
+ * decompressed size on output.
+ * @return Is block valid and fits into output buffer.
+ */
+inline bool lz4_decompress(const void* data, std::size_t size, void* output, std::size_t& outputSize) {
+    auto out = static_cast<uint8_t*>(output);
+    auto result = detail::lz4_decompress(static_cast<const uint8_t*>(data), size, out, outputSize, out, nullptr, 0);
+
+    if (result == std::size_t(-1)) {
+        return false;
+    }
+
+    outputSize = result;
+
+    return true;
+}
+
+/**
+ * @brief Function for decompressing LZ4 block
+ * to the end of byte array.
+ * @param sequence Block (byte array, it's reader or view).
+ * @param target Byte array or processor.
+ * @param size Decompressed size (LZ4 block doesn't hold it).
+ * @return Is block valid and it's decompressed size
+ * is `size`. Target is not changed on failure.
+ */
+template <typename Sequence, typename ValueType, typename Allocator>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bool>::type lz4_decompress_into(
+    const Sequence& sequence, bytearray_processor<ValueType, Allocator>& target, std::size_t size) {
+    auto& container = target.container();
+    auto offset = container.size();
+
+    container.resize(offset + size);
+
+    auto output = reinterpret_cast<uint8_t*>(container.data() + offset);
+    auto result = detail::lz4_decompress(detail::byte_data(sequence), detail::byte_size(sequence), output, size, output, nullptr, 0);
+
+    if (result != size) {
+        container.resize(offset);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Maximum size of LZ4 frame block.
+ */
+enum class lz4_block_size : uint8_t { max64kb = 4, max256kb = 5, max1mb = 6, max4mb = 7 };
+
+/**
+ * @brief Class, that implements streaming LZ4 frame
+ * compression (format of `lz4` tool). Blocks are linked:
+ * every block may reference last 64 KiB of previous
+ * ones or dictionary. Window and hash table are kept
+ * between frames, so encoder should be reused.
+ */
+class lz4_frame_encoder {
+public:
+    /**
+     * @brief Constructor.
+     * @param blockSize Maximum block size.
+     * @param contentChecksum Should XXH32 of content be written.
+     */
+    explicit lz4_frame_encoder(lz4_block_size blockSize = lz4_block_size::max64kb, bool contentChecksum = true)
+        : m_blockSize(std::size_t(1) << (8 + 2 * unsigned(blockSize)))
+        , m_blockId(blockSize)
+        , m_contentChecksum(contentChecksum)
+        , m_history(0) {
+        m_window.reserve(history_size + m_blockSize);
+    }
+
+    /**
+     * @brief Method for setting dictionary, that's
+     * used by next frames. Only last 64 KiB are used.
+     */
+    void load_dictionary(const void* data, std::size_t size) {
+        auto begin = static_cast<const uint8_t*>(data);
+        auto used = std::min(size, history_size);
+
+        m_dictionary.assign(begin + size - used, begin + size);
+    }
+
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type load_dictionary(const Sequence& sequence) {
+        load_dictionary(detail::byte_data(sequence), detail::byte_size(sequence));
+    }
+
+    /**
+     * @brief Method for writing frame header.
+     */
+    template <typename ValueType, typename Allocator>
+    void begin(bytearray_processor<ValueType, Allocator>& target) {
+        uint8_t header[7];
+
+        detail::lz4_write32(header, detail::lz4_frame_magic);
+
+        // Version 01, linked blocks
+        header[4] = uint8_t(0x40 | (m_contentChecksum ? 0x04 : 0x00));
+        header[5] = uint8_t(uint8_t(m_blockId) << 4);
+        header[6] = uint8_t(detail::xxh32::hash(header + 4, 2) >> 8);
+
+        append(target, header, sizeof(header));
+
+        m_checksum = detail::xxh32();
+        m_window.assign(m_dictionary.begin(), m_dictionary.end());
+        m_history = m_window.size();
+
+        m_state.index(m_window.data(), m_window.size());
+    }
+
+    /**
+     * @brief Method for compressing data. Full
+     * blocks are written immediately.
+     */
+    template <typename ValueType, typename Allocator>
+    void update(bytearray_processor<ValueType, Allocator>& target, const void* data, std::size_t size) {
+        auto input = static_cast<const uint8_t*>(data);
+
+        if (m_contentChecksum) {
+            m_checksum.update(input, size);
+        }
+
+        while (size > 0) {
+            auto part = std::min(size, m_history + m_blockSize - m_window.size());
+
+            m_window.insert(m_window.end(), input, input + part);
+            input += part;
+            size -= part;
+
+            if (m_window.size() == m_history + m_blockSize) {
+                flush(target);
+            }
+        }
+    }
+
+    template <typename ValueType, typename Allocator, typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type update(bytearray_processor<ValueType, Allocator>& target,
+                                                                                     const Sequence& sequence) {
+        update(target, detail::byte_data(sequence), detail::byte_size(sequence));
+    }
+
+    /**
+     * @brief Method for writing last block, end
+     * mark and content checksum.
+     */
+    template <typename ValueType, typename Allocator>
+    void end(bytearray_processor<ValueType, Allocator>& target) {
+        flush(target);
+
+        uint8_t trailer[8];
+
+        detail::lz4_write32(trailer, 0);
+        detail::lz4_write32(trailer + 4, m_checksum.digest());
+
+        append(target, trailer, m_contentChecksum ? 8 : 4);
+    }
+
+private:
+    static constexpr std::size_t history_size = 64 * 1024;
+
+    template <typename ValueType, typename Allocator>
+    static void append(bytearray_processor<ValueType, Allocator>& target, const uint8_t* data, std::size_t size) {
+        auto first = reinterpret_cast<const ValueType*>(data);
+
+        target.container().insert(target.container().end(), first, first + size);
+    }
+
+    template <typename ValueType, typename Allocator>
+    void flush(bytearray_processor<ValueType, Allocator>& target) {
+        auto size = m_window.size() - m_history;
+
+        if (size == 0) {
+            return;
+        }
+
+        auto& container = target.container();
+        auto offset = container.size();
+
+        container.resize(offset + 4 + size);
+
+        auto output = reinterpret_cast<uint8_t*>(container.data() + offset);
+
+        // Block, that isn't smaller, than data, is stored
+        auto compressed = m_state.compress(m_window.data(), m_history, m_window.size(), output + 4, size - 1);
+
+        if (compressed == 0) {
+            detail::lz4_write32(output, uint32_t(size) | 0x80000000U);
+            std::memcpy(output + 4, m_window.data() + m_history, size);
+        } else {
+            detail::lz4_write32(output, uint32_t(compressed));
+            container.resize(offset + 4 + compressed);
+        }
+
+        // Last 64 KiB are kept, their absolute positions are not changed
+        auto keep = std::min(m_window.size(), history_size);
+        auto shift = m_window.size() - keep;
+
+        m_state.m_base += shift;
+
+        m_window.erase(m_window.begin(), m_window.begin() + std::ptrdiff_t(shift));
+        m_history = m_window.size();
+    }
+
+    std::size_t m_blockSize;
+    lz4_block_size m_blockId;
+    bool m_contentChecksum;
+    std::vector<uint8_t> m_dictionary;
+    std::vector<uint8_t> m_window;
+    std::size_t m_history;
+    lz4_state m_state;
+    detail::xxh32 m_checksum;
+};
+
+/**
+ * @brief Function for decompressing LZ4 frame
+ * (any frame of `lz4` tool, including independent
+ * blocks and checksums; skippable frames are skipped)
+ * to the end of byte array.
+ * @param data Pointer to frame.
+ * @param size Size of data.
+ * @param target Byte array or processor.
+ * @param dictionary Dictionary, frame was compressed with.
+ * @param dictionarySize Size of dictionary.
+ * @return Size of frame or 0 if it's invalid
+ * (target is not changed then).
+ */
+template <typename ValueType, typename Allocator>
+std::size_t lz4_decompress_frame(const void* data,
+                                 std::size_t size,
+                                 bytearray_processor<ValueType, Allocator>& target,
+                                 const void* dictionary = nullptr,
+                                 std::size_t dictionarySize = 0) {
+    auto input = static_cast<const uint8_t*>(data);
+    auto& container = target.container();
+    auto start = container.size();
+
+    auto fail = [&]() -> std::size_t {
+        container.resize(start);
+        return 0;
+    };
+
+    if (size < 8) {
+        return 0;
+    }
+
+    auto magic = detail::lz4_read32(input);
+
+    if ((magic & 0xFFFFFFF0U) == detail::lz4_skippable_magic) {
+        auto length = detail::lz4_read32(input + 4);
+
+        return size - 8 >= length ? 8 + length : 0;
+    }
+
+    auto flags = input[4];
+    auto descriptor = input[5];
+
+    if (magic != detail::lz4_frame_magic || (flags >> 6) != 1 || (flags & 0x02) || (descriptor & 0x8F)) {
+        return 0;
+    }
+
+    auto blockId = (descriptor >> 4) & 0x07;
+
+    if (blockId < 4) {
+        return 0;
+    }
+
+    bool independent = flags & 0x20;
+    bool blockChecksum = flags & 0x10;
+    bool contentSize = flags & 0x08;
+    bool contentChecksum = flags & 0x04;
+    bool dictionaryId = flags & 0x01;
+
+    std::size_t headerSize = 7 + (contentSize ? 8 : 0) + (dictionaryId ? 4 : 0);
+
+    if (size < headerSize || input[headerSize - 1] != uint8_t(detail::xxh32::hash(input + 4, headerSize - 5) >> 8)) {
+        return 0;
+    }
+
+    auto blockMaximum = std::size_t(1) << (8 + 2 * blockId);
+    auto dictionaryData = static_cast<const uint8_t*>(dictionary);
+    std::size_t position = headerSize;
+
+    for (;;) {
+        if (size - position < 4) {
+            return fail();
+        }
+
+        auto header = detail::lz4_read32(input + position);
+
+        position += 4;
+
+        if (header == 0) {
+            break;
+        }
+
+        auto length = std::size_t(header & 0x7FFFFFFFU);
+
+        if (size - position < length + (blockChecksum ? 4 : 0) || length > blockMaximum) {
+            return fail();
+        }
+
+        auto block = input + position;
+
+        if (blockChecksum && detail::lz4_read32(block + length) != detail::xxh32::hash(block, length)) {
+            return fail();
+        }
+
+        auto offset = container.size();
+
+        if (header & 0x80000000U) {
+            auto first = reinterpret_cast<const ValueType*>(block);
+
+            container.insert(container.end(), first, first + length);
+        } else {
+            container.resize(offset + blockMaximum);
+
+            auto output = reinterpret_cast<uint8_t*>(container.data());
+            auto prefix = output + (independent ? offset : start);
+            auto result = detail::lz4_decompress(block, length, output + offset, blockMaximum, prefix, dictionaryData, dictionarySize);
+
+            if (result == std::size_t(-1)) {
+                return fail();
+            }
+
+            container.resize(offset + result);
+        }
+
+        position += length + (blockChecksum ? 4 : 0);
+    }
+
+    auto output = reinterpret_cast<const uint8_t*>(container.data()) + start;
+    auto written = container.size() - start;
+
+    if (contentSize && detail::lz4_read32(input + 6) + (uint64_t(detail::lz4_read32(input + 10)) << 32) != written) {
+        return fail();
+    }
+
+    if (contentChecksum) {
+        if (size - position < 4 || detail::lz4_read32(input + position) != detail::xxh32::hash(output, written)) {
+            return fail();
+        }
+
+        position += 4;
+    }
+
+    return position;
+}
+
+/**
+ * @brief Function for decompressing LZ4 frame of
+ * byte array, it's reader or view.
+ */
+template <typename Sequence, typename ValueType, typename Allocator>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, std::size_t>::type lz4_decompress_frame(
+    const Sequence& sequence,
+    bytearray_processor<ValueType, Allocator>& target,
+    const void* dictionary = nullptr,
+    std::size_t dictionarySize = 0) {
+    return lz4_decompress_frame(detail::byte_data(sequence), detail::byte_size(sequence), target, dictionary, dictionarySize);
+}
+
+}  // namespace ba
@@ -0,0 +1,537 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_view.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace ba {
+
+/**
+ * @brief Class, that implements precompiled matcher of
+ * set of byte patterns. Haystack is scanned once and every
+ * occurrence of every pattern is reported as
+ * (pattern id, offset) pair.
+ *
+ * Small pattern sets (up to `prefilter_limit` patterns) are
+ * scanned with SIMD nibble prefilter ("Teddy") and verified
+ * with `memcmp`. Large sets use Aho-Corasick DFA with byte
+ * classes, states are stored in breadth first order, so hot
+ * shallow states share cache lines.
+ *
+ * Usage: `add` patterns, `compile`, then `scan`/`find_all`
+ * or `make_stream` for chunked input.
+ */
+class multi_matcher {
+public:
+    /**
+     * @brief Maximal amount of patterns, scanned with SIMD
+     * prefilter.
+     */
+    static constexpr std::size_t prefilter_limit = 16;
+
+    /**
+     * @brief Structure, that describes single match.
+     */
+    struct match {
+        std::size_t pattern;
+        std::size_t offset;
+
+        bool operator==(const match& rhs) const { return pattern == rhs.pattern && offset == rhs.offset; }
+
+        bool operator<(const match& rhs) const { return offset < rhs.offset || (offset == rhs.offset && pattern < rhs.pattern); }
+    };
+
+    /**
+     * @brief Class, that implements scanning of input,
+     * split into several chunks. Automaton state is carried
+     * across chunks, so matches crossing chunk boundaries are
+     * reported. Offsets are counted from stream start.
+     */
+    class stream {
+    public:
+        /**
+         * @brief Constructor.
+         * @param matcher Compiled matcher. Has to outlive stream.
+         */
+        explicit stream(const multi_matcher& matcher)
+            : m_matcher(&matcher)
+            , m_state(0)
+            , m_offset(0) {
+            assert(matcher.m_compiled && "Matcher has to be compiled.");
+        }
+
+        /**
+         * @brief Method for scanning next chunk.
+         * @param data Pointer to chunk.
+         * @param size Chunk size.
+         * @param callback Callable with `match` argument.
+         */
+        template <typename Callback>
+        void feed(const void* data, std::size_t size, Callback&& callback) {
+            m_state = m_matcher->scan_automaton(static_cast<const uint8_t*>(data), size, m_offset, m_state, callback);
+            m_offset += size;
+        }
+
+        /**
+         * @brief Method for scanning next chunk, that is byte
+         * array or view.
+         */
+        template <typename Chunk, typename Callback, typename = detail::enable_if_byte_sequences<Chunk, Chunk>>
+        void feed(const Chunk& chunk, Callback&& callback) {
+            feed(detail::byte_data(chunk), detail::byte_size(chunk), callback);
+        }
+
+        /**
+         * @brief Method for getting amount of scanned bytes.
+         */
+        std::size_t offset() const { return m_offset; }
+
+        /**
+         * @brief Method for resetting stream to initial state.
+         */
+        void reset() {
+            m_state = 0;
+            m_offset = 0;
+        }
+
+    private:
+        const multi_matcher* m_matcher;
+        uint32_t m_state;
+        std::size_t m_offset;
+    };
+
+    /**
+     * @brief Default constructor.
+     */
+    multi_matcher() = default;
+
+    /**
+     * @brief Constructor, that adds patterns and compiles
+     * matcher.
+     * @param patterns Patterns. Pattern id is it's index.
+     */
+    multi_matcher(std::initializer_list<std::string_view> patterns) {
+        for (auto pattern : patterns) {
+            add(pattern.data(), pattern.size());
+        }
+
+        compile();
+    }
+
+    /**
+     * @brief Method for adding pattern. Matcher has to
+     * be compiled after adding patterns.
+     * @param data Pointer to pattern.
+     * @param size Pattern size. Has to be non zero.
+     * @return Pattern id.
+     */
+    std::size_t add(const void* data, std::size_t size) {
+        assert(size > 0 && "Pattern can't be empty.");
+
+        auto bytes = static_cast<const uint8_t*>(data);
+
+        m_patterns.emplace_back(bytes, bytes + size);
+        m_compiled = false;
+
+        return m_patterns.size() - 1;
+    }
+
+    /**
+     * @brief Method for adding pattern from byte array,
+     * view or string.
+     * @return Pattern id.
+     */
+    template <typename Pattern>
+    std::size_t add(const Pattern& pattern) {
+        if constexpr (detail::is_byte_sequence<Pattern>::value) {
+            return add(detail::byte_data(pattern), detail::byte_size(pattern));
+        } else {
+            std::string_view sv(pattern);
+
+            return add(sv.data(), sv.size());
+        }
+    }
+
+    /**
+     * @brief Method for getting amount of patterns.
+     */
+    std::size_t size() const { return m_patterns.size(); }
+
+    /**
+     * @brief Method for building automaton and
+     * prefilter tables.
+     * @throws std::length_error If automaton has more,
+     * than 2^31 transitions.
+     */
+    void compile() {
+        build_automaton();
+        build_prefilter();
+
+        m_compiled = true;
+    }
+
+    /**
+     * @brief Method for scanning memory block.
+     * @param data Pointer to data.
+     * @param size Size in bytes.
+     * @param callback Callable with `match` argument.
+     */
+    template <typename Callback>
+    void scan(const void* data, std::size_t size, Callback&& callback) const {
+        assert(m_compiled && "Matcher has to be compiled.");
+
+        auto bytes = static_cast<const uint8_t*>(data);
+
+        if (m_patterns.empty()) {
+            return;
+        }
+
+#if defined(BA_SIMD_SSSE3)
+        if (m_patterns.size() <= prefilter_limit) {
+            scan_prefilter(bytes, size, callback);
+            return;
+        }
+#endif
+
+        scan_automaton(bytes, size, 0, 0, callback);
+    }
+
+    /**
+     * @brief Method for scanning byte array or view.
+     */
+    template <typename Haystack, typename Callback, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+    void scan(const Haystack& haystack, Callback&& callback) const {
+        scan(detail::byte_data(haystack), detail::byte_size(haystack), callback);
+    }
+
+    /**
+     * @brief Method for getting all matches in byte array
+     * or view.
+     * @return Matches, sorted by offset and pattern id.
+     */
+    template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+    std::vector<match> find_all(const Haystack& haystack) const {
+        std::vector<match> result;
+
+        scan(haystack, [&result](const match& m) { result.push_back(m); });
+
+        std::sort(result.begin(), result.end());
+
+        return result;
+    }
+
+    /**
+     * @brief Method for creating stream scanner.
+     */
+    stream make_stream() const { return stream(*this); }
+
+private:
+    static constexpr uint32_t match_flag = 0x80000000;
+
+    /**
+     * @brief Aho-Corasick automaton construction.
+     * Trie is built over byte classes, missing transitions
+     * are resolved through failure links, so scanning makes
+     * exactly one table lookup per byte.
+     */
+    void build_automaton() {
+        // Byte classes. Bytes, that are absent in patterns share class 0.
+        std::fill(std::begin(m_classes), std::end(m_classes), uint8_t(0));
+
+        bool used[256] = {};
+
+        for (auto& pattern : m_patterns) {
+            for (auto symbol : pattern) {
+                used[symbol] = true;
+            }
+        }
+
+        m_stride = 1;
+
+        for (std::size_t i = 0; i < 256; ++i) {
+            if (used[i]) {
+                m_classes[i] = uint8_t(m_stride++ & 0xFF);
+            }
+        }
+
+        // 256 used bytes wrap class to 0, which is unused in this case
+        if (m_stride > 256) {
+            m_stride = 256;
+        }
+
+        constexpr uint32_t none = 0xFFFFFFFF;
+
+        // Trie
+        std::vector<uint32_t> trie(m_stride, none);
+        std::vector<std::vector<uint32_t>> outputs(1);
+
+        for (std::size_t id = 0; id < m_patterns.size(); ++id) {
+            uint32_t node = 0;
+
+            for (auto symbol : m_patterns[id]) {
+                auto& next = trie[node * m_stride + m_classes[symbol]];
+
+                if (next == none) {
+                    // Premultiplied state ids share 32 bits with match flag
+                    if ((outputs.size() + 1) * m_stride > match_flag) {
+                        throw std::length_error("Pattern set is too large for matcher.");
+                    }
+
+                    next = uint32_t(outputs.size());
+                    outputs.emplace_back();
+                    trie.resize(trie.size() + m_stride, none);
+                }
+
+                node = trie[node * m_stride + m_classes[symbol]];
+            }
+
+            outputs[node].push_back(uint32_t(id));
+        }
+
+        auto states = outputs.size();
+
+        // Breadth first traversal with failure links
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> fail(states, 0);
+
+        order.reserve(states);
+        order.push_back(0);
+
+        for (std::size_t c = 0; c < m_stride; ++c) {
+            auto& next = trie[c];
+
+            if (next == none) {
+                next = 0;
+            } else {
+                order.push_back(next);
+            }
+        }
+
+        for (std::size_t i = 1; i < order.size(); ++i) {
+            uint32_t node = order[i];
+
+            for (auto id : outputs[fail[node]]) {
+                outputs[node].push_back(id);
+            }
+
+            for (std::size_t c = 0; c < m_stride; ++c) {
+                auto& next = trie[node * m_stride + c];
+
+                if (next == none) {
+                    next = trie[fail[node] * m_stride + c];
+                } else {
+                    fail[next] = trie[fail[node] * m_stride + c];
+                    order.push_back(next);
+                }
+            }
+        }
+
+        // Renumbering into breadth first order with premultiplied ids
+        std::vector<uint32_t> position(states);
+
+        for (std::size_t i = 0; i < states; ++i) {
+            position[order[i]] = uint32_t(i);
+        }
+
+        m_table.assign(states * m_stride, 0);
+        m_outputOffsets.assign(states + 1, 0);
+        m_outputs.clear();
+
+        for (std::size_t i = 0; i < states; ++i) {
+            uint32_t node = order[i];
+
+            for (std::size_t c = 0; c < m_stride; ++c) {
+                uint32_t target = trie[node * m_stride + c];
+
+                m_table[i * m_stride + c] = uint32_t(position[target] * m_stride) | (outputs[target].empty() ? 0 : match_flag);
+            }
+
+            m_outputOffsets[i] = uint32_t(m_outputs.size());
+            m_outputs.insert(m_outputs.end(), outputs[node].begin(), outputs[node].end());
+        }
+
+        m_outputOffsets[states] = uint32_t(m_outputs.size());
+    }
+
+    /**
+     * @brief Prefilter construction. Pattern `i` goes
+     * to bucket `i % 8`, every bucket is described by low and
+     * high nibble masks of first two pattern bytes.
+     */
+    void build_prefilter() {
+        std::memset(m_nibbles, 0, sizeof(m_nibbles));
+
+        for (auto& bucket : m_buckets) {
+            bucket.clear();
+        }
+
+        if (m_patterns.size() > prefilter_limit) {
+            return;
+        }
+
+        for (std::size_t id = 0; id < m_patterns.size(); ++id) {
+            auto& pattern = m_patterns[id];
+            auto bit = uint8_t(1 << (id % 8));
+
+            m_buckets[id % 8].push_back(uint32_t(id));
+
+            m_nibbles[0][pattern[0] & 0x0F] |= bit;
+            m_nibbles[1][pattern[0] >> 4] |= bit;
+
+            if (pattern.size() >= 2) {
+                m_nibbles[2][pattern[1] & 0x0F] |= bit;
+                m_nibbles[3][pattern[1] >> 4] |= bit;
+            } else {
+                for (std::size_t i = 0; i < 16; ++i) {
+                    m_nibbles[2][i] |= bit;
+                    m_nibbles[3][i] |= bit;
+                }
+            }
+        }
+    }
+
+    template <typename Callback>
+    uint32_t scan_automaton(const uint8_t* data, std::size_t size, std::size_t base, uint32_t state, Callback& callback) const {
+        const uint32_t* table = m_table.data();
+
+        for (std::size_t i = 0; i < size; ++i) {
+            uint32_t next = table[state + m_classes[data[i]]];
+
+            state = next & ~match_flag;
+
+            if (next & match_flag) {
+                auto index = state / m_stride;
+
+                for (auto output = m_outputOffsets[index]; output < m_outputOffsets[index + 1]; ++output) {
+                    auto id = m_outputs[output];
+
+                    callback(match{id, base + i + 1 - m_patterns[id].size()});
+                }
+            }
+        }
+
+        return state;
+    }
+
+    template <typename Callback>
+    void verify(const uint8_t* data, std::size_t size, std::size_t position, uint32_t buckets, Callback& callback) const {
+        while (buckets) {
+            auto bucket = detail::count_trailing_zeros(buckets);
+
+            for (auto id : m_buckets[bucket]) {
+                auto& pattern = m_patterns[id];
+
+                if (position + pattern.size() <= size && std::memcmp(data + position, pattern.data(), pattern.size()) == 0) {
+                    callback(match{id, position});
+                }
+            }
+
+            buckets &= buckets - 1;
+        }
+    }
+
+#if defined(BA_SIMD_SSSE3)
+    template <typename Callback>
+    void scan_prefilter(const uint8_t* data, std::size_t size, Callback& callback) const {
+        std::size_t offset = 0;
+
+        const __m128i lowMask = _mm_set1_epi8(0x0F);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i low0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_nibbles[0]));
+        const __m128i high0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_nibbles[1]));
+        const __m128i low1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_nibbles[2]));
+        const __m128i high1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_nibbles[3]));
+
+        alignas(32) uint8_t candidates[32];
+
+#if defined(BA_SIMD_AVX2)
+        const __m256i lowMask2 = _mm256_set1_epi8(0x0F);
+        const __m256i low02 = _mm256_broadcastsi128_si256(low0);
+        const __m256i high02 = _mm256_broadcastsi128_si256(high0);
+        const __m256i low12 = _mm256_broadcastsi128_si256(low1);
+        const __m256i high12 = _mm256_broadcastsi128_si256(high1);
+
+        for (; offset + 33 <= size; offset += 32) {
+            __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+            __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + 1));
+
+            __m256i result = _mm256_and_si256(
+                _mm256_and_si256(_mm256_shuffle_epi8(low02, _mm256_and_si256(first, lowMask2)),
+                                 _mm256_shuffle_epi8(high02, _mm256_and_si256(_mm256_srli_epi16(first, 4), lowMask2))),
+                _mm256_and_si256(_mm256_shuffle_epi8(low12, _mm256_and_si256(second, lowMask2)),
+                                 _mm256_shuffle_epi8(high12, _mm256_and_si256(_mm256_srli_epi16(second, 4), lowMask2))));
+
+            auto mask = ~uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(result, _mm256_setzero_si256())));
+
+            if (mask) {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(candidates), result);
+
+                while (mask) {
+                    auto bit = detail::count_trailing_zeros(mask);
+
+                    verify(data, size, offset + bit, candidates[bit], callback);
+
+                    mask &= mask - 1;
+                }
+            }
+        }
+#endif
+
+        for (; offset + 17 <= size; offset += 16) {
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+            __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset + 1));
+
+            __m128i result = _mm_and_si128(_mm_and_si128(_mm_shuffle_epi8(low0, _mm_and_si128(first, lowMask)),
+                                                         _mm_shuffle_epi8(high0, _mm_and_si128(_mm_srli_epi16(first, 4), lowMask))),
+                                           _mm_and_si128(_mm_shuffle_epi8(low1, _mm_and_si128(second, lowMask)),
+                                                         _mm_shuffle_epi8(high1, _mm_and_si128(_mm_srli_epi16(second, 4), lowMask))));
+
+            auto mask = ~uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(result, zero))) & 0xFFFF;
+
+            if (mask) {
+                _mm_store_si128(reinterpret_cast<__m128i*>(candidates), result);
+
+                while (mask) {
+                    auto bit = detail::count_trailing_zeros(mask);
+
+                    verify(data, size, offset + bit, candidates[bit], callback);
+
+                    mask &= mask - 1;
+                }
+            }
+        }
+
+        // Tail positions are verified against every bucket
+        for (; offset < size; ++offset) {
+            verify(data, size, offset, 0xFF, callback);
+        }
+    }
+#endif
+
+    std::vector<std::vector<uint8_t>> m_patterns;
+    bool m_compiled = false;
+
+    // Automaton
+    uint8_t m_classes[256] = {};
+    std::size_t m_stride = 1;
+    std::vector<uint32_t> m_table;
+    std::vector<uint32_t> m_outputOffsets;
+    std::vector<uint32_t> m_outputs;
+
+    // Prefilter
+    uint8_t m_nibbles[4][16] = {};
+    std::vector<uint32_t> m_buckets[8];
+};
+
+}  // namespace ba
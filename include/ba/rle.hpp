@@ -0,0 +1,362 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_processor.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+#include <ba/detail/varint.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace ba {
+
+namespace detail {
+
+constexpr std::size_t rle_min_run = 3;
+constexpr std::size_t rle_max_run = 130;
+constexpr std::size_t rle_max_literals = 128;
+constexpr std::size_t zero_rle_min_run = 4;
+
+/**
+ * @brief Function for searching first position,
+ * that starts run of 3 equal bytes.
+ * @return Position or `size`.
+ */
+inline std::size_t find_run(const uint8_t* data, std::size_t position, std::size_t size) {
+#if defined(BA_SIMD_SSE2)
+    for (; position + 18 <= size; position += 16) {
+        auto first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        auto second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + 1));
+        auto third = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + 2));
+        auto mask = unsigned(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, second), _mm_cmpeq_epi8(second, third))));
+
+        if (mask != 0) {
+            return position + count_trailing_zeros(mask);
+        }
+    }
+#endif
+
+    for (; position + 2 < size; ++position) {
+        if (data[position] == data[position + 1] && data[position] == data[position + 2]) {
+            return position;
+        }
+    }
+
+    return size;
+}
+
+/**
+ * @brief Function for getting length of run of
+ * `value` bytes, that starts at `position`.
+ */
+inline std::size_t run_length(const uint8_t* data, std::size_t position, std::size_t size, uint8_t value) {
+    auto start = position;
+
+#if defined(BA_SIMD_SSE2)
+    auto pattern = _mm_set1_epi8(char(value));
+
+    for (; position + 16 <= size; position += 16) {
+        auto equal = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position)), pattern)));
+
+        if (equal != 0xFFFF) {
+            return position + count_trailing_zeros(~equal) - start;
+        }
+    }
+#endif
+
+    while (position < size && data[position] == value) {
+        ++position;
+    }
+
+    return position - start;
+}
+
+/**
+ * @brief Function for searching first position,
+ * that starts run of `zero_rle_min_run` zero bytes.
+ * @return Position or `size`.
+ */
+inline std::size_t find_zero_run(const uint8_t* data, std::size_t position, std::size_t size) {
+#if defined(BA_SIMD_SSE2)
+    auto zero = _mm_setzero_si128();
+
+    for (; position + 16 + zero_rle_min_run - 1 <= size; position += 16) {
+        auto mask = 0xFFFFu;
+
+        for (std::size_t i = 0; i < zero_rle_min_run; ++i) {
+            auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + i));
+
+            mask &= unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)));
+        }
+
+        if (mask != 0) {
+            return position + count_trailing_zeros(mask);
+        }
+    }
+#endif
+
+    for (; position + zero_rle_min_run <= size; ++position) {
+        if (run_length(data, position, position + zero_rle_min_run, 0) == zero_rle_min_run) {
+            return position;
+        }
+    }
+
+    return size;
+}
+
+template <typename ValueType, typename Allocator>
+void append_bytes(bytearray_processor<ValueType, Allocator>& target, const uint8_t* data, std::size_t size) {
+    auto first = reinterpret_cast<const ValueType*>(data);
+
+    target.container().insert(target.container().end(), first, first + size);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for run length encoding. Every
+ * block starts with control byte: `0 - 127` - next
+ * `control + 1` bytes are literals, `128 - 255` - next
+ * byte is repeated `control - 125` times (3 - 130).
+ * Runs are searched and measured 16 bytes at once.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param target Byte array or processor, data is appended to.
+ * @return Amount of written bytes.
+ */
+template <typename ValueType, typename Allocator>
+std::size_t rle_encode(const void* data, std::size_t size, bytearray_processor<ValueType, Allocator>& target) {
+    auto input = static_cast<const uint8_t*>(data);
+    auto start = target.container().size();
+
+    // At most one control byte per 128 literals
+    target.container().reserve(start + size + size / detail::rle_max_literals + 1);
+
+    std::size_t position = 0;
+
+    while (position < size) {
+        auto run = detail::find_run(input, position, size);
+
+        // Literals before run
+        while (position < run) {
+            auto literals = std::min(run - position, detail::rle_max_literals);
+
+            target.template push_back<uint8_t>(uint8_t(literals - 1));
+            detail::append_bytes(target, input + position, literals);
+
+            position += literals;
+        }
+
+        if (run == size) {
+            break;
+        }
+
+        auto length = detail::run_length(input, run, size, input[run]);
+
+        while (length >= detail::rle_min_run) {
+            auto part = std::min(length, detail::rle_max_run);
+
+            target.template push_back<uint8_t>(uint8_t(part - detail::rle_min_run + 128));
+            target.template push_back<uint8_t>(input[run]);
+
+            length -= part;
+            position += part;
+        }
+
+        // 1 or 2 bytes of long run are left for literals
+    }
+
+    return target.container().size() - start;
+}
+
+template <typename Sequence, typename ValueType, typename Allocator>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, std::size_t>::type rle_encode(
+    const Sequence& sequence, bytearray_processor<ValueType, Allocator>& target) {
+    return rle_encode(detail::byte_data(sequence), detail::byte_size(sequence), target);
+}
+
+/**
+ * @brief Function for decoding data, encoded with
+ * `rle_encode`. Decoded size is computed first, so
+ * target is resized once.
+ * @param data Pointer to encoded data.
+ * @param size Size of encoded data.
+ * @param target Byte array or processor, data is appended to.
+ * @return Is data valid (target is not changed otherwise).
+ */
+template <typename ValueType, typename Allocator>
+bool rle_decode(const void* data, std::size_t size, bytearray_processor<ValueType, Allocator>& target) {
+    auto input = static_cast<const uint8_t*>(data);
+    std::size_t decoded = 0;
+
+    for (std::size_t position = 0; position < size;) {
+        auto control = input[position++];
+        auto literals = control < 128;
+        auto length = literals ? std::size_t(control) + 1 : std::size_t(control) - 128 + detail::rle_min_run;
+        auto encoded = literals ? length : 1;
+
+        if (size - position < encoded) {
+            return false;
+        }
+
+        position += encoded;
+        decoded += length;
+    }
+
+    auto& container = target.container();
+    auto offset = container.size();
+
+    container.resize(offset + decoded);
+
+    auto output = reinterpret_cast<uint8_t*>(container.data() + offset);
+
+    for (std::size_t position = 0; position < size;) {
+        auto control = input[position++];
+
+        if (control < 128) {
+            std::memcpy(output, input + position, std::size_t(control) + 1);
+            output += std::size_t(control) + 1;
+            position += std::size_t(control) + 1;
+        } else {
+            std::memset(output, input[position++], std::size_t(control) - 128 + detail::rle_min_run);
+            output += std::size_t(control) - 128 + detail::rle_min_run;
+        }
+    }
+
+    return true;
+}
+
+template <typename Sequence, typename ValueType, typename Allocator>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bool>::type rle_decode(const Sequence& sequence,
+                                                                                         bytearray_processor<ValueType, Allocator>& target) {
+    return rle_decode(detail::byte_data(sequence), detail::byte_size(sequence), target);
+}
+
+/**
+ * @brief Function for encoding of zero runs only,
+ * that's cheaper for sparse data (zero padding). Data is
+ * stored as pairs of varints: amount of zero bytes and
+ * amount of literals, followed by literals. Zero runs
+ * shorter, than 4 bytes, are kept in literals.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param target Byte array or processor, data is appended to.
+ * @return Amount of written bytes.
+ */
+template <typename ValueType, typename Allocator>
+std::size_t zero_rle_encode(const void* data, std::size_t size, bytearray_processor<ValueType, Allocator>& target) {
+    auto input = static_cast<const uint8_t*>(data);
+    auto start = target.container().size();
+
+    std::size_t position = 0;
+
+    while (position < size) {
+        auto zeros = detail::run_length(input, position, size, 0);
+
+        if (zeros < detail::zero_rle_min_run && position + zeros < size) {
+            zeros = 0;
+        }
+
+        position += zeros;
+
+        auto literals = detail::find_zero_run(input, position, size) - position;
+
+        target.push_back_varint(uint64_t(zeros));
+        target.push_back_varint(uint64_t(literals));
+        detail::append_bytes(target, input + position, literals);
+
+        position += literals;
+    }
+
+    return target.container().size() - start;
+}
+
+template <typename Sequence, typename ValueType, typename Allocator>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, std::size_t>::type zero_rle_encode(
+    const Sequence& sequence, bytearray_processor<ValueType, Allocator>& target) {
+    return zero_rle_encode(detail::byte_data(sequence), detail::byte_size(sequence), target);
+}
+
+/**
+ * @brief Function for decoding data, encoded with
+ * `zero_rle_encode`. Decoded size is computed first, so
+ * target is resized once. Few bytes may describe zero
+ * run of any length, so `limit` has to be set for
+ * untrusted data.
+ * @param data Pointer to encoded data.
+ * @param size Size of encoded data.
+ * @param target Byte array or processor, data is appended to.
+ * @param limit Maximum decoded size, data, that is decoded
+ * to more bytes, is invalid.
+ * @return Is data valid (target is not changed otherwise).
+ */
+template <typename ValueType, typename Allocator>
+bool zero_rle_decode(const void* data,
+                     std::size_t size,
+                     bytearray_processor<ValueType, Allocator>& target,
+                     std::size_t limit = std::size_t(-1)) {
+    auto input = static_cast<const uint8_t*>(data);
+    auto& container = target.container();
+    uint64_t decoded = 0;
+
+    limit = std::min<std::size_t>(limit, container.max_size() - container.size());
+
+    for (std::size_t position = 0; position < size;) {
+        uint64_t zeros = 0;
+        uint64_t literals = 0;
+
+        auto first = detail::decode_varint(input + position, size - position, zeros);
+
+        position += first;
+
+        auto second = first == 0 ? 0 : detail::decode_varint(input + position, size - position, literals);
+
+        position += second;
+
+        if (second == 0 || size - position < literals || zeros > limit - decoded || literals > limit - decoded - zeros) {
+            return false;
+        }
+
+        position += std::size_t(literals);
+        decoded += zeros + literals;
+    }
+
+    auto offset = container.size();
+
+    container.resize(offset + std::size_t(decoded));
+
+    auto output = reinterpret_cast<uint8_t*>(container.data() + offset);
+
+    // Resized storage is already zero filled
+    for (std::size_t position = 0; position < size;) {
+        uint64_t zeros = 0;
+        uint64_t literals = 0;
+
+        position += detail::decode_varint(input + position, size - position, zeros);
+        position += detail::decode_varint(input + position, size - position, literals);
+
+        output += zeros;
+
+        if (literals != 0) {
+            std::memcpy(output, input + position, std::size_t(literals));
+        }
+
+        output += literals;
+        position += std::size_t(literals);
+    }
+
+    return true;
+}
+
+template <typename Sequence, typename ValueType, typename Allocator>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bool>::type zero_rle_decode(
+    const Sequence& sequence, bytearray_processor<ValueType, Allocator>& target, std::size_t limit = std::size_t(-1)) {
+    return zero_rle_decode(detail::byte_data(sequence), detail::byte_size(sequence), target, limit);
+}
+
+}  // namespace ba
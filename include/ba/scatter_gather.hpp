@@ -0,0 +1,239 @@
+#pragma once
+
+// ba
+#include <ba/compare.hpp>
+
+// C++ STL
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<sys/uio.h>) && __has_include(<sys/socket.h>)
+#define BA_HAS_SCATTER_GATHER 1
+
+// POSIX
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+#ifdef BA_HAS_SCATTER_GATHER
+
+namespace ba {
+
+/**
+ * @brief Class, that describes list of memory segments
+ * for vectored I/O. Segments are not copied, list only
+ * refers to byte arrays, views or raw memory, so they
+ * must outlive list.
+ *
+ * List keeps track of already transferred bytes, so
+ * after partial `writev`/`readv`/`sendmsg` next call
+ * continues from first not transferred byte.
+ */
+class iovec_list {
+public:
+    iovec_list()
+        : m_first(0)
+        , m_size(0) {}
+
+    /**
+     * @brief Method for adding raw memory segment.
+     * Empty segments are skipped.
+     * @param data Pointer to memory.
+     * @param size Size in bytes.
+     */
+    void append(const void* data, std::size_t size) {
+        if (size == 0) {
+            return;
+        }
+
+        // iovec is used both for reading and writing, so constness
+        // is dropped here. Only writable segments may be used for readv.
+        m_segments.push_back(iovec{const_cast<void*>(data), size});
+        m_size += size;
+    }
+
+    /**
+     * @brief Method for adding byte array, it's reader,
+     * processor or view as segment.
+     */
+    template <typename Sequence>
+    typename std::enable_if<detail::is_byte_sequence<Sequence>::value>::type append(const Sequence& sequence) {
+        append(detail::byte_data(sequence), detail::byte_size(sequence));
+    }
+
+    /**
+     * @brief Method for removing all segments.
+     */
+    void clear() {
+        m_segments.clear();
+        m_first = 0;
+        m_size = 0;
+    }
+
+    /**
+     * @brief Method for skipping transferred bytes.
+     * Fully transferred segments are dropped, first
+     * partially transferred segment is shortened.
+     * @param bytes Number of bytes. Can't be bigger, than `size()`.
+     */
+    void advance(std::size_t bytes) {
+        assert(bytes <= m_size && "Can't advance further, than list size.");
+
+        m_size -= bytes;
+
+        while (bytes > 0) {
+            auto& segment = m_segments[m_first];
+
+            if (bytes < segment.iov_len) {
+                segment.iov_base = static_cast<uint8_t*>(segment.iov_base) + bytes;
+                segment.iov_len -= bytes;
+                return;
+            }
+
+            bytes -= segment.iov_len;
+            ++m_first;
+        }
+
+        if (m_first == m_segments.size()) {
+            m_segments.clear();
+            m_first = 0;
+        }
+    }
+
+    /**
+     * @brief Method for getting pointer to first
+     * not transferred segment.
+     */
+    const iovec* data() const { return m_segments.data() + m_first; }
+
+    /**
+     * @brief Method for getting number of not transferred
+     * segments.
+     */
+    std::size_t count() const { return m_segments.size() - m_first; }
+
+    /**
+     * @brief Method for getting number of not transferred
+     * bytes.
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief Method for checking is everything transferred.
+     */
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief Method for getting number of segments,
+     * that can be passed to single system call.
+     */
+    int syscall_count() const {
+#ifdef IOV_MAX
+        return int(std::min<std::size_t>(count(), IOV_MAX));
+#else
+        return int(std::min<std::size_t>(count(), 1024));
+#endif
+    }
+
+private:
+    std::vector<iovec> m_segments;
+    std::size_t m_first;
+    std::size_t m_size;
+};
+
+/**
+ * @brief Function for writing segments to file descriptor
+ * with single `writev` call. Call is retried on `EINTR`.
+ * On success list is advanced by number of written bytes.
+ * @return Number of written bytes or -1 on error
+ * (`errno` is set).
+ */
+inline ssize_t writev(int fd, iovec_list& list) {
+    ssize_t result;
+
+    do {
+        result = ::writev(fd, list.data(), list.syscall_count());
+    } while (result < 0 && errno == EINTR);
+
+    if (result > 0) {
+        list.advance(std::size_t(result));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for reading from file descriptor
+ * into segments with single `readv` call. Segments have
+ * to refer to writable memory. Call is retried on `EINTR`.
+ * On success list is advanced by number of read bytes.
+ * @return Number of read bytes, 0 on end of file or -1
+ * on error (`errno` is set).
+ */
+inline ssize_t readv(int fd, iovec_list& list) {
+    ssize_t result;
+
+    do {
+        result = ::readv(fd, list.data(), list.syscall_count());
+    } while (result < 0 && errno == EINTR);
+
+    if (result > 0) {
+        list.advance(std::size_t(result));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for sending segments to socket
+ * with single `sendmsg` call. Call is retried on `EINTR`.
+ * On success list is advanced by number of sent bytes.
+ * @param flags `sendmsg` flags (`MSG_NOSIGNAL`, etc).
+ * @return Number of sent bytes or -1 on error
+ * (`errno` is set).
+ */
+inline ssize_t sendmsg(int fd, iovec_list& list, int flags = 0) {
+    msghdr message{};
+
+    message.msg_iov = const_cast<iovec*>(list.data());
+    message.msg_iovlen = decltype(message.msg_iovlen)(list.syscall_count());
+
+    ssize_t result;
+
+    do {
+        result = ::sendmsg(fd, &message, flags);
+    } while (result < 0 && errno == EINTR);
+
+    if (result > 0) {
+        list.advance(std::size_t(result));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for writing all segments to blocking
+ * file descriptor. Partial writes are continued from
+ * first not written byte.
+ * @return `true` if everything was written, `false`
+ * on error (`errno` is set, list contains not written rest).
+ */
+inline bool write_all(int fd, iovec_list& list) {
+    while (!list.empty()) {
+        if (ba::writev(fd, list) <= 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace ba
+
+#endif
@@ -0,0 +1,677 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_view.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace ba {
+
+/**
+ * @brief Value, returned by search functions if
+ * nothing was found.
+ */
+inline constexpr std::size_t npos = std::size_t(-1);
+
+namespace detail {
+
+/**
+ * @brief Function for getting pointer to first byte of
+ * string view, used as needle.
+ */
+inline const uint8_t* byte_data(std::string_view sv) {
+    return reinterpret_cast<const uint8_t*>(sv.data());
+}
+
+/**
+ * @brief Function for getting size of string view,
+ * used as needle.
+ */
+inline std::size_t byte_size(std::string_view sv) {
+    return sv.size();
+}
+
+/**
+ * @brief Trait for types, that can be used as needle.
+ * Byte sequences and string views are accepted.
+ */
+template <typename T>
+struct is_needle
+    : std::integral_constant<bool, is_byte_sequence<T>::value || std::is_convertible<const T&, std::string_view>::value> {};
+
+template <typename Haystack, typename Needle>
+using enable_if_search =
+    typename std::enable_if<is_byte_sequence<Haystack>::value && is_needle<Needle>::value, std::size_t>::type;
+
+template <typename T>
+const uint8_t* needle_data(const T& needle) {
+    if constexpr (is_byte_sequence<T>::value) {
+        return byte_data(needle);
+    } else {
+        return byte_data(std::string_view(needle));
+    }
+}
+
+template <typename T>
+std::size_t needle_size(const T& needle) {
+    if constexpr (is_byte_sequence<T>::value) {
+        return byte_size(needle);
+    } else {
+        return std::string_view(needle).size();
+    }
+}
+
+/**
+ * @brief Search of first byte with specified value.
+ * @return Offset of byte or `size` if not found.
+ */
+inline std::size_t find_byte(const uint8_t* data, std::size_t size, uint8_t value) {
+#if defined(BA_SIMD_AVX2)
+    std::size_t offset = 0;
+    const __m256i pattern = _mm256_set1_epi8(char(value));
+
+    for (; offset + 64 <= size; offset += 64) {
+        __m256i a = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset)), pattern);
+        __m256i b = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + 32)), pattern);
+
+        if (!_mm256_testz_si256(_mm256_or_si256(a, b), _mm256_or_si256(a, b))) {
+            auto low = uint64_t(uint32_t(_mm256_movemask_epi8(a)));
+            auto high = uint64_t(uint32_t(_mm256_movemask_epi8(b)));
+
+            return offset + count_trailing_zeros(low | (high << 32));
+        }
+    }
+
+    for (; offset + 32 <= size; offset += 32) {
+        auto mask = uint32_t(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset)), pattern)));
+
+        if (mask) {
+            return offset + count_trailing_zeros(mask);
+        }
+    }
+
+    for (; offset < size; ++offset) {
+        if (data[offset] == value) {
+            break;
+        }
+    }
+
+    return offset;
+#else
+    auto found = size ? static_cast<const uint8_t*>(std::memchr(data, value, size)) : nullptr;
+
+    return found ? std::size_t(found - data) : size;
+#endif
+}
+
+/**
+ * @brief Search of last byte with specified value.
+ * @return Offset of byte or `size` if not found.
+ */
+inline std::size_t rfind_byte(const uint8_t* data, std::size_t size, uint8_t value) {
+    std::size_t end = size;
+
+#if defined(BA_SIMD_AVX2)
+    const __m256i pattern = _mm256_set1_epi8(char(value));
+
+    for (; end >= 32; end -= 32) {
+        auto mask = uint32_t(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + end - 32)), pattern)));
+
+        if (mask) {
+            return end - 32 + highest_bit(mask);
+        }
+    }
+#elif defined(BA_SIMD_SSE2)
+    const __m128i pattern = _mm_set1_epi8(char(value));
+
+    for (; end >= 16; end -= 16) {
+        auto mask =
+            uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + end - 16)), pattern)));
+
+        if (mask) {
+            return end - 16 + highest_bit(mask);
+        }
+    }
+#endif
+
+    while (end) {
+        --end;
+
+        if (data[end] == value) {
+            return end;
+        }
+    }
+
+    return size;
+}
+
+/**
+ * @brief Counting of bytes with specified value.
+ */
+inline std::size_t count_byte(const uint8_t* data, std::size_t size, uint8_t value) {
+    std::size_t offset = 0;
+    std::size_t result = 0;
+
+#if defined(BA_SIMD_AVX2)
+    const __m256i pattern = _mm256_set1_epi8(char(value));
+
+    while (size - offset >= 32) {
+        // 8 bit counters overflow after 255 iterations
+        std::size_t iterations = (size - offset) / 32;
+        iterations = iterations > 255 ? 255 : iterations;
+
+        __m256i counters = _mm256_setzero_si256();
+
+        for (std::size_t i = 0; i < iterations; ++i, offset += 32) {
+            counters = _mm256_sub_epi8(
+                counters, _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset)), pattern));
+        }
+
+        __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+
+        result += uint64_t(_mm256_extract_epi64(sums, 0)) + uint64_t(_mm256_extract_epi64(sums, 1)) +
+                  uint64_t(_mm256_extract_epi64(sums, 2)) + uint64_t(_mm256_extract_epi64(sums, 3));
+    }
+#elif defined(BA_SIMD_SSE2)
+    const __m128i pattern = _mm_set1_epi8(char(value));
+
+    while (size - offset >= 16) {
+        std::size_t iterations = (size - offset) / 16;
+        iterations = iterations > 255 ? 255 : iterations;
+
+        __m128i counters = _mm_setzero_si128();
+
+        for (std::size_t i = 0; i < iterations; ++i, offset += 16) {
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset)), pattern));
+        }
+
+        __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+
+        result += uint32_t(_mm_cvtsi128_si32(sums)) + uint32_t(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+#endif
+
+    for (; offset < size; ++offset) {
+        result += data[offset] == value;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Search of first byte from set.
+ * SIMD version uses nibble lookup ("truffle"), which is
+ * exact for any set of bytes.
+ * @return Offset of byte or `size` if not found.
+ */
+inline std::size_t find_any(const uint8_t* data, std::size_t size, const uint8_t* set, std::size_t setSize) {
+    if (setSize == 0) {
+        return size;
+    }
+
+    if (setSize == 1) {
+        return find_byte(data, size, set[0]);
+    }
+
+    std::size_t offset = 0;
+
+#if defined(BA_SIMD_SSSE3)
+    alignas(16) uint8_t low[16] = {};
+    alignas(16) uint8_t high[16] = {};
+
+    for (std::size_t i = 0; i < setSize; ++i) {
+        (set[i] & 0x80 ? high : low)[set[i] & 0x0F] |= uint8_t(1 << ((set[i] >> 4) & 0x07));
+    }
+
+    const __m128i lowTable = _mm_load_si128(reinterpret_cast<const __m128i*>(low));
+    const __m128i highTable = _mm_load_si128(reinterpret_cast<const __m128i*>(high));
+    const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+
+#if defined(BA_SIMD_AVX2)
+    const __m256i lowTable2 = _mm256_broadcastsi128_si256(lowTable);
+    const __m256i highTable2 = _mm256_broadcastsi128_si256(highTable);
+    const __m256i bits2 = _mm256_broadcastsi128_si256(bits);
+
+    for (; offset + 32 <= size; offset += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+        __m256i members = _mm256_or_si256(_mm256_shuffle_epi8(lowTable2, v),
+                                          _mm256_shuffle_epi8(highTable2, _mm256_xor_si256(v, _mm256_set1_epi8(char(0x80)))));
+        __m256i bit = _mm256_shuffle_epi8(bits2, _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x07)));
+        auto mask = ~uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(members, bit), _mm256_setzero_si256())));
+
+        if (mask) {
+            return offset + count_trailing_zeros(mask);
+        }
+    }
+#endif
+
+    for (; offset + 16 <= size; offset += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+        __m128i members =
+            _mm_or_si128(_mm_shuffle_epi8(lowTable, v), _mm_shuffle_epi8(highTable, _mm_xor_si128(v, _mm_set1_epi8(char(0x80)))));
+        __m128i bit = _mm_shuffle_epi8(bits, _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x07)));
+        auto mask = ~uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(members, bit), _mm_setzero_si128()))) & 0xFFFF;
+
+        if (mask) {
+            return offset + count_trailing_zeros(mask);
+        }
+    }
+#endif
+
+    uint64_t bitmap[4] = {};
+
+    for (std::size_t i = 0; i < setSize; ++i) {
+        bitmap[set[i] >> 6] |= uint64_t(1) << (set[i] & 63);
+    }
+
+    for (; offset < size; ++offset) {
+        if (bitmap[data[offset] >> 6] & (uint64_t(1) << (data[offset] & 63))) {
+            break;
+        }
+    }
+
+    return offset;
+}
+
+/**
+ * @brief Horspool search of needle.
+ * @return Offset of needle or `size` if not found.
+ */
+inline std::size_t horspool(const uint8_t* data, std::size_t size, const uint8_t* needle, std::size_t needleSize) {
+    if (size < needleSize) {
+        return size;
+    }
+
+    std::size_t shift[256];
+
+    for (auto& value : shift) {
+        value = needleSize;
+    }
+
+    for (std::size_t i = 0; i + 1 < needleSize; ++i) {
+        shift[needle[i]] = needleSize - 1 - i;
+    }
+
+    const uint8_t last = needle[needleSize - 1];
+
+    for (std::size_t position = 0; position + needleSize <= size;) {
+        uint8_t symbol = data[position + needleSize - 1];
+
+        if (symbol == last && std::memcmp(data + position, needle, needleSize - 1) == 0) {
+            return position;
+        }
+
+        position += shift[symbol];
+    }
+
+    return size;
+}
+
+/**
+ * @brief Search of needle by it's first byte.
+ * Works best for short needles and haystacks.
+ * @return Offset of needle or `size` if not found.
+ */
+inline std::size_t find_by_first(const uint8_t* data, std::size_t size, const uint8_t* needle, std::size_t needleSize) {
+    if (size < needleSize) {
+        return size;
+    }
+
+    std::size_t last = size - needleSize;
+
+    for (std::size_t position = 0; position <= last; ++position) {
+        position += find_byte(data + position, last + 1 - position, needle[0]);
+
+        if (position > last) {
+            break;
+        }
+
+        if (std::memcmp(data + position + 1, needle + 1, needleSize - 1) == 0) {
+            return position;
+        }
+    }
+
+    return size;
+}
+
+/**
+ * @brief Search of needle. SIMD version filters candidates
+ * by first and last needle bytes, remainder is handled
+ * by Horspool algorithm.
+ * @return Offset of needle or `size` if not found.
+ */
+inline std::size_t find_bytes(const uint8_t* data, std::size_t size, const uint8_t* needle, std::size_t needleSize) {
+    if (needleSize == 0) {
+        return 0;
+    }
+
+    if (needleSize == 1) {
+        return find_byte(data, size, needle[0]);
+    }
+
+    if (size < needleSize) {
+        return size;
+    }
+
+    std::size_t offset = 0;
+
+#if defined(BA_SIMD_AVX2)
+    const __m256i first = _mm256_set1_epi8(char(needle[0]));
+    const __m256i last = _mm256_set1_epi8(char(needle[needleSize - 1]));
+
+    for (; offset + needleSize + 31 <= size; offset += 32) {
+        __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset));
+        __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + offset + needleSize - 1));
+        auto mask = uint32_t(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+
+        while (mask) {
+            auto bit = count_trailing_zeros(mask);
+
+            if (std::memcmp(data + offset + bit + 1, needle + 1, needleSize - 2) == 0) {
+                return offset + bit;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+#elif defined(BA_SIMD_SSE2)
+    const __m128i first = _mm_set1_epi8(char(needle[0]));
+    const __m128i last = _mm_set1_epi8(char(needle[needleSize - 1]));
+
+    for (; offset + needleSize + 15 <= size; offset += 16) {
+        __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+        __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset + needleSize - 1));
+        auto mask = uint32_t(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+
+        while (mask) {
+            auto bit = count_trailing_zeros(mask);
+
+            if (std::memcmp(data + offset + bit + 1, needle + 1, needleSize - 2) == 0) {
+                return offset + bit;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    std::size_t rest = size - offset;
+    std::size_t found = (needleSize >= 4 && rest >= 256) ? horspool(data + offset, rest, needle, needleSize)
+                                                          : find_by_first(data + offset, rest, needle, needleSize);
+
+    return found == rest ? size : offset + found;
+}
+
+/**
+ * @brief Search of last needle occurrence.
+ * @return Offset of needle or `size` if not found.
+ */
+inline std::size_t rfind_bytes(const uint8_t* data, std::size_t size, const uint8_t* needle, std::size_t needleSize) {
+    if (needleSize == 0) {
+        return size;
+    }
+
+    if (size < needleSize) {
+        return size;
+    }
+
+    // Candidates are searched by first needle byte
+    std::size_t end = size - needleSize + 1;
+
+    while (end) {
+        std::size_t position = rfind_byte(data, end, needle[0]);
+
+        if (position == end) {
+            break;
+        }
+
+        if (std::memcmp(data + position + 1, needle + 1, needleSize - 1) == 0) {
+            return position;
+        }
+
+        end = position;
+    }
+
+    return size;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for searching byte in memory block.
+ * @param data Pointer to data.
+ * @param size Size in bytes.
+ * @param value Byte value.
+ * @return Offset of byte or `npos`.
+ */
+inline std::size_t find(const void* data, std::size_t size, uint8_t value) {
+    auto found = detail::find_byte(static_cast<const uint8_t*>(data), size, value);
+
+    return found == size ? npos : found;
+}
+
+/**
+ * @brief Function for searching needle in memory block.
+ * @param data Pointer to data.
+ * @param size Size in bytes.
+ * @param needle Pointer to needle.
+ * @param needleSize Needle size in bytes.
+ * @return Offset of needle or `npos`.
+ */
+inline std::size_t find(const void* data, std::size_t size, const void* needle, std::size_t needleSize) {
+    if (needleSize > size) {
+        return npos;
+    }
+
+    auto found = detail::find_bytes(static_cast<const uint8_t*>(data), size, static_cast<const uint8_t*>(needle), needleSize);
+
+    return found == size && needleSize ? npos : found;
+}
+
+/**
+ * @brief Function for searching byte in byte sequence
+ * (byte array, reader or view).
+ * @param haystack Byte sequence.
+ * @param value Byte value.
+ * @param from Search start position.
+ * @return Offset of byte or `npos`.
+ */
+template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+std::size_t find(const Haystack& haystack, uint8_t value, std::size_t from = 0) {
+    auto size = detail::byte_size(haystack);
+
+    if (from >= size) {
+        return npos;
+    }
+
+    auto found = find(detail::byte_data(haystack) + from, size - from, value);
+
+    return found == npos ? npos : found + from;
+}
+
+template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+std::size_t find(const Haystack& haystack, std::byte value, std::size_t from = 0) {
+    return ba::find(haystack, uint8_t(value), from);
+}
+
+/**
+ * @brief Function for searching needle (byte sequence or
+ * string) in byte sequence.
+ * @param haystack Byte sequence.
+ * @param needle Needle.
+ * @param from Search start position.
+ * @return Offset of needle or `npos`.
+ */
+template <typename Haystack, typename Needle>
+detail::enable_if_search<Haystack, Needle> find(const Haystack& haystack, const Needle& needle, std::size_t from = 0) {
+    auto size = detail::byte_size(haystack);
+
+    if (from > size) {
+        return npos;
+    }
+
+    auto found = find(detail::byte_data(haystack) + from, size - from, detail::needle_data(needle), detail::needle_size(needle));
+
+    return found == npos ? npos : found + from;
+}
+
+/**
+ * @brief Function for searching last byte with
+ * specified value.
+ * @return Offset of byte or `npos`.
+ */
+template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+std::size_t rfind(const Haystack& haystack, uint8_t value) {
+    auto size = detail::byte_size(haystack);
+    auto found = detail::rfind_byte(detail::byte_data(haystack), size, value);
+
+    return found == size ? npos : found;
+}
+
+template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+std::size_t rfind(const Haystack& haystack, std::byte value) {
+    return ba::rfind(haystack, uint8_t(value));
+}
+
+/**
+ * @brief Function for searching last needle occurrence.
+ * @return Offset of needle or `npos`.
+ */
+template <typename Haystack, typename Needle>
+detail::enable_if_search<Haystack, Needle> rfind(const Haystack& haystack, const Needle& needle) {
+    auto size = detail::byte_size(haystack);
+    auto needleSize = detail::needle_size(needle);
+
+    if (needleSize == 0) {
+        return size;
+    }
+
+    auto found = detail::rfind_bytes(detail::byte_data(haystack), size, detail::needle_data(needle), needleSize);
+
+    return found == size ? npos : found;
+}
+
+/**
+ * @brief Function for searching first byte, that
+ * is contained in set.
+ * @param haystack Byte sequence.
+ * @param set Set of bytes (byte sequence or string).
+ * @param from Search start position.
+ * @return Offset of byte or `npos`.
+ */
+template <typename Haystack, typename Set>
+detail::enable_if_search<Haystack, Set> find_first_of(const Haystack& haystack, const Set& set, std::size_t from = 0) {
+    auto size = detail::byte_size(haystack);
+
+    if (from >= size) {
+        return npos;
+    }
+
+    auto found = detail::find_any(detail::byte_data(haystack) + from, size - from, detail::needle_data(set), detail::needle_size(set));
+
+    return found == size - from ? npos : found + from;
+}
+
+/**
+ * @brief Function for checking whether byte sequence
+ * contains needle.
+ */
+template <typename Haystack, typename Needle>
+typename std::enable_if<detail::is_byte_sequence<Haystack>::value && detail::is_needle<Needle>::value, bool>::type contains(
+    const Haystack& haystack,
+    const Needle& needle) {
+    return ba::find(haystack, needle) != npos;
+}
+
+template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+bool contains(const Haystack& haystack, uint8_t value) {
+    return ba::find(haystack, value) != npos;
+}
+
+template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+bool contains(const Haystack& haystack, std::byte value) {
+    return ba::find(haystack, uint8_t(value)) != npos;
+}
+
+/**
+ * @brief Function for counting bytes with specified value.
+ */
+template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+std::size_t count(const Haystack& haystack, uint8_t value) {
+    return detail::count_byte(detail::byte_data(haystack), detail::byte_size(haystack), value);
+}
+
+template <typename Haystack, typename = detail::enable_if_byte_sequences<Haystack, Haystack>>
+std::size_t count(const Haystack& haystack, std::byte value) {
+    return ba::count(haystack, uint8_t(value));
+}
+
+/**
+ * @brief Function for counting non overlapping needle
+ * occurrences.
+ */
+template <typename Haystack, typename Needle>
+detail::enable_if_search<Haystack, Needle> count(const Haystack& haystack, const Needle& needle) {
+    auto needleSize = detail::needle_size(needle);
+
+    if (needleSize == 0) {
+        return 0;
+    }
+
+    std::size_t result = 0;
+
+    for (auto position = ba::find(haystack, needle); position != npos; position = ba::find(haystack, needle, position + needleSize)) {
+        ++result;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for searching needle in byte array.
+ * @return View of found occurrence.
+ */
+template <typename ValueType, typename Allocator, typename Needle>
+typename std::enable_if<detail::is_needle<Needle>::value, std::optional<bytearray_view<ValueType, Allocator>>>::type find_view(
+    bytearray_processor<ValueType, Allocator>& haystack,
+    const Needle& needle,
+    std::size_t from = 0) {
+    auto position = ba::find(haystack, needle, from);
+
+    if (position == npos) {
+        return std::nullopt;
+    }
+
+    return bytearray_view<ValueType, Allocator>(haystack, position, detail::needle_size(needle));
+}
+
+/**
+ * @brief Function for searching needle in byte array view.
+ * @return Subview of found occurrence.
+ */
+template <typename ValueType, typename Allocator, typename Needle>
+typename std::enable_if<detail::is_needle<Needle>::value, std::optional<bytearray_view<ValueType, Allocator>>>::type find_view(
+    bytearray_view<ValueType, Allocator>& haystack,
+    const Needle& needle,
+    std::size_t from = 0) {
+    auto position = ba::find(haystack, needle, from);
+
+    if (position == npos) {
+        return std::nullopt;
+    }
+
+    return haystack.subview(position, detail::needle_size(needle));
+}
+
+}  // namespace ba
@@ -0,0 +1,411 @@
+#pragma once
+
+// ba
+#include <ba/bytearray.hpp>
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+
+// C++ STL
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace ba {
+
+namespace detail {
+
+#if defined(BA_SIMD_SSE2)
+/**
+ * @brief SSE2 operations of shuffle network.
+ * `even`/`odd` take even/odd bytes of 2 vectors,
+ * `low`/`high` interleave bytes back.
+ */
+struct shuffle_sse2 {
+    using vector = __m128i;
+
+    static constexpr std::size_t size = 16;
+
+    static vector load(const uint8_t* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+    static void store(uint8_t* data, vector value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value); }
+
+    static vector even(vector a, vector b) {
+        auto mask = _mm_set1_epi16(0x00FF);
+        return _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+    }
+
+    static vector odd(vector a, vector b) { return _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)); }
+
+    static vector low(vector a, vector b) { return _mm_unpacklo_epi8(a, b); }
+    static vector high(vector a, vector b) { return _mm_unpackhi_epi8(a, b); }
+};
+#endif
+
+#if defined(BA_SIMD_AVX2)
+/**
+ * @brief AVX2 operations of shuffle network. Pack
+ * and unpack work inside of 128 bit lanes, so 64 bit
+ * parts are reordered to get the same result, as
+ * with 32 byte registers.
+ */
+struct shuffle_avx2 {
+    using vector = __m256i;
+
+    static constexpr std::size_t size = 32;
+
+    static vector load(const uint8_t* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+    static void store(uint8_t* data, vector value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value); }
+
+    static vector even(vector a, vector b) {
+        auto mask = _mm256_set1_epi16(0x00FF);
+        return _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_and_si256(a, mask), _mm256_and_si256(b, mask)), 0xD8);
+    }
+
+    static vector odd(vector a, vector b) {
+        return _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8)), 0xD8);
+    }
+
+    static vector low(vector a, vector b) {
+        return _mm256_unpacklo_epi8(_mm256_permute4x64_epi64(a, 0xD8), _mm256_permute4x64_epi64(b, 0xD8));
+    }
+
+    static vector high(vector a, vector b) {
+        return _mm256_unpackhi_epi8(_mm256_permute4x64_epi64(a, 0xD8), _mm256_permute4x64_epi64(b, 0xD8));
+    }
+};
+#endif
+
+/**
+ * @brief Function for byte shuffle of `Ops::size`
+ * elements at once. `log2(Width)` steps of even/odd
+ * byte separation give byte planes in natural order.
+ * @return Amount of processed elements.
+ */
+template <std::size_t Width, typename Ops>
+std::size_t shuffle_blocks(const uint8_t* input, std::size_t count, uint8_t* output) {
+    typename Ops::vector vectors[Width];
+    typename Ops::vector next[Width];
+
+    std::size_t index = 0;
+
+    for (; index + Ops::size <= count; index += Ops::size) {
+        for (std::size_t i = 0; i < Width; ++i) {
+            vectors[i] = Ops::load(input + index * Width + i * Ops::size);
+        }
+
+        for (std::size_t step = 1; step < Width; step *= 2) {
+            for (std::size_t i = 0; i < Width / 2; ++i) {
+                next[i] = Ops::even(vectors[2 * i], vectors[2 * i + 1]);
+                next[i + Width / 2] = Ops::odd(vectors[2 * i], vectors[2 * i + 1]);
+            }
+
+            std::memcpy(vectors, next, sizeof(vectors));
+        }
+
+        for (std::size_t i = 0; i < Width; ++i) {
+            Ops::store(output + i * count + index, vectors[i]);
+        }
+    }
+
+    return index;
+}
+
+/**
+ * @brief Function for inverse of `shuffle_blocks`.
+ */
+template <std::size_t Width, typename Ops>
+std::size_t unshuffle_blocks(const uint8_t* input, std::size_t count, uint8_t* output) {
+    typename Ops::vector vectors[Width];
+    typename Ops::vector next[Width];
+
+    std::size_t index = 0;
+
+    for (; index + Ops::size <= count; index += Ops::size) {
+        for (std::size_t i = 0; i < Width; ++i) {
+            vectors[i] = Ops::load(input + i * count + index);
+        }
+
+        for (std::size_t step = 1; step < Width; step *= 2) {
+            for (std::size_t i = 0; i < Width / 2; ++i) {
+                next[2 * i] = Ops::low(vectors[i], vectors[i + Width / 2]);
+                next[2 * i + 1] = Ops::high(vectors[i], vectors[i + Width / 2]);
+            }
+
+            std::memcpy(vectors, next, sizeof(vectors));
+        }
+
+        for (std::size_t i = 0; i < Width; ++i) {
+            Ops::store(output + index * Width + i * Ops::size, vectors[i]);
+        }
+    }
+
+    return index;
+}
+
+template <std::size_t Width>
+std::size_t shuffle_vectorized(const uint8_t* input, std::size_t count, uint8_t* output, bool inverse) {
+#if defined(BA_SIMD_AVX2)
+    return inverse ? unshuffle_blocks<Width, shuffle_avx2>(input, count, output) : shuffle_blocks<Width, shuffle_avx2>(input, count, output);
+#elif defined(BA_SIMD_SSE2)
+    return inverse ? unshuffle_blocks<Width, shuffle_sse2>(input, count, output) : shuffle_blocks<Width, shuffle_sse2>(input, count, output);
+#else
+    (void)input;
+    (void)count;
+    (void)output;
+    (void)inverse;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Function for byte shuffle or unshuffle.
+ * Element sizes 2, 4, 8 and 16 are vectorized,
+ * other ones and last elements are done by scalar loop.
+ */
+inline void byte_shuffle(const uint8_t* input, std::size_t size, std::size_t width, uint8_t* output, bool inverse) {
+    assert(width != 0 && "Element size can't be 0.");
+
+    auto count = size / width;
+    std::size_t index = 0;
+
+    switch (width) {
+        case 1:
+            if (size != 0) {
+                std::memcpy(output, input, size);
+            }
+
+            return;
+        case 2:
+            index = shuffle_vectorized<2>(input, count, output, inverse);
+            break;
+        case 4:
+            index = shuffle_vectorized<4>(input, count, output, inverse);
+            break;
+        case 8:
+            index = shuffle_vectorized<8>(input, count, output, inverse);
+            break;
+        case 16:
+            index = shuffle_vectorized<16>(input, count, output, inverse);
+            break;
+        default:
+            break;
+    }
+
+    for (; index < count; ++index) {
+        for (std::size_t byte = 0; byte < width; ++byte) {
+            if (inverse) {
+                output[index * width + byte] = input[byte * count + index];
+            } else {
+                output[byte * count + index] = input[index * width + byte];
+            }
+        }
+    }
+
+    // Bytes of incomplete element are kept
+    if (count * width < size) {
+        std::memcpy(output + count * width, input + count * width, size - count * width);
+    }
+}
+
+/**
+ * @brief Function for transposing 8x8 bit matrix,
+ * stored by rows in bytes: bit `c` of byte `r`
+ * becomes bit `r` of byte `c`.
+ */
+inline uint64_t transpose_bits(uint64_t value) {
+    uint64_t t;
+
+    t = (value ^ (value >> 7)) & 0x00AA00AA00AA00AAULL;
+    value ^= t ^ (t << 7);
+    t = (value ^ (value >> 14)) & 0x0000CCCC0000CCCCULL;
+    value ^= t ^ (t << 14);
+    t = (value ^ (value >> 28)) & 0x00000000F0F0F0F0ULL;
+    value ^= t ^ (t << 28);
+
+    return value;
+}
+
+/**
+ * @brief Function for splitting byte plane to 8 bit
+ * rows: bit `i % 8` of byte `i / 8` of row `b` is bit `b`
+ * of byte `i`. Bits of 16 (32) bytes are taken with
+ * single movemask.
+ * @param input Plane with `count` bytes (multiple of 8).
+ * @param output 8 rows, `count / 8` bytes each.
+ */
+inline void split_bit_rows(const uint8_t* input, std::size_t count, uint8_t* output) {
+    auto row = count / 8;
+    std::size_t index = 0;
+
+#if defined(BA_SIMD_AVX2)
+    for (; index + 32 <= count; index += 32) {
+        auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + index));
+
+        for (int bit = 7; bit >= 0; --bit) {
+            store<uint32_t>(output + std::size_t(bit) * row + index / 8, uint32_t(_mm256_movemask_epi8(bytes)));
+            bytes = _mm256_add_epi8(bytes, bytes);
+        }
+    }
+#endif
+
+#if defined(BA_SIMD_SSE2)
+    for (; index + 16 <= count; index += 16) {
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + index));
+
+        for (int bit = 7; bit >= 0; --bit) {
+            store<uint16_t>(output + std::size_t(bit) * row + index / 8, uint16_t(_mm_movemask_epi8(bytes)));
+            bytes = _mm_add_epi8(bytes, bytes);
+        }
+    }
+#endif
+
+    for (; index < count; index += 8) {
+        uint64_t value = 0;
+
+        for (std::size_t i = 0; i < 8; ++i) {
+            value |= uint64_t(input[index + i]) << (8 * i);
+        }
+
+        value = transpose_bits(value);
+
+        for (std::size_t bit = 0; bit < 8; ++bit) {
+            output[bit * row + index / 8] = uint8_t(value >> (8 * bit));
+        }
+    }
+}
+
+/**
+ * @brief Function for inverse of `split_bit_rows`.
+ */
+inline void join_bit_rows(const uint8_t* input, std::size_t count, uint8_t* output) {
+    auto row = count / 8;
+
+    for (std::size_t index = 0; index < count; index += 8) {
+        uint64_t value = 0;
+
+        for (std::size_t bit = 0; bit < 8; ++bit) {
+            value |= uint64_t(input[bit * row + index / 8]) << (8 * bit);
+        }
+
+        value = transpose_bits(value);
+
+        for (std::size_t i = 0; i < 8; ++i) {
+            output[index + i] = uint8_t(value >> (8 * i));
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for byte shuffle: byte `j` of every
+ * `elementSize` byte element goes to plane `j`, so
+ * similar high bytes of typed arrays form long runs,
+ * that are compressed better. Last incomplete
+ * element is copied as is.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param elementSize Size of element.
+ * @param output Output with `size` bytes.
+ */
+inline void byte_shuffle(const void* data, std::size_t size, std::size_t elementSize, void* output) {
+    detail::byte_shuffle(static_cast<const uint8_t*>(data), size, elementSize, static_cast<uint8_t*>(output), false);
+}
+
+/**
+ * @brief Function for inverse of `byte_shuffle`.
+ */
+inline void byte_unshuffle(const void* data, std::size_t size, std::size_t elementSize, void* output) {
+    detail::byte_shuffle(static_cast<const uint8_t*>(data), size, elementSize, static_cast<uint8_t*>(output), true);
+}
+
+/**
+ * @brief Function for bit shuffle: after byte shuffle
+ * every byte plane is split to 8 bit rows. Elements
+ * after last multiple of 8 are byte shuffled only.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param elementSize Size of element.
+ * @param output Output with `size` bytes.
+ */
+inline void bit_shuffle(const void* data, std::size_t size, std::size_t elementSize, void* output) {
+    auto count = size / elementSize / 8 * 8;
+    auto bytes = count * elementSize;
+    auto out = static_cast<uint8_t*>(output);
+
+    std::vector<uint8_t> planes(bytes);
+
+    detail::byte_shuffle(static_cast<const uint8_t*>(data), bytes, elementSize, planes.data(), false);
+
+    for (std::size_t plane = 0; plane < elementSize; ++plane) {
+        detail::split_bit_rows(planes.data() + plane * count, count, out + plane * count);
+    }
+
+    detail::byte_shuffle(static_cast<const uint8_t*>(data) + bytes, size - bytes, elementSize, out + bytes, false);
+}
+
+/**
+ * @brief Function for inverse of `bit_shuffle`.
+ */
+inline void bit_unshuffle(const void* data, std::size_t size, std::size_t elementSize, void* output) {
+    auto count = size / elementSize / 8 * 8;
+    auto bytes = count * elementSize;
+    auto input = static_cast<const uint8_t*>(data);
+
+    std::vector<uint8_t> planes(bytes);
+
+    for (std::size_t plane = 0; plane < elementSize; ++plane) {
+        detail::join_bit_rows(input + plane * count, count, planes.data() + plane * count);
+    }
+
+    detail::byte_shuffle(planes.data(), bytes, elementSize, static_cast<uint8_t*>(output), true);
+    detail::byte_shuffle(input + bytes, size - bytes, elementSize, static_cast<uint8_t*>(output) + bytes, true);
+}
+
+/**
+ * @brief Function for byte shuffle of byte array,
+ * it's reader or view.
+ */
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bytearray<>>::type byte_shuffle(const Sequence& sequence,
+                                                                                                     std::size_t elementSize) {
+    bytearray<> result(detail::byte_size(sequence));
+
+    byte_shuffle(detail::byte_data(sequence), result.size(), elementSize, result.container().data());
+
+    return result;
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bytearray<>>::type byte_unshuffle(const Sequence& sequence,
+                                                                                                       std::size_t elementSize) {
+    bytearray<> result(detail::byte_size(sequence));
+
+    byte_unshuffle(detail::byte_data(sequence), result.size(), elementSize, result.container().data());
+
+    return result;
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bytearray<>>::type bit_shuffle(const Sequence& sequence,
+                                                                                                    std::size_t elementSize) {
+    bytearray<> result(detail::byte_size(sequence));
+
+    bit_shuffle(detail::byte_data(sequence), result.size(), elementSize, result.container().data());
+
+    return result;
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bytearray<>>::type bit_unshuffle(const Sequence& sequence,
+                                                                                                      std::size_t elementSize) {
+    bytearray<> result(detail::byte_size(sequence));
+
+    bit_unshuffle(detail::byte_data(sequence), result.size(), elementSize, result.container().data());
+
+    return result;
+}
+
+}  // namespace ba
@@ -0,0 +1,201 @@
+#pragma once
+
+// ba
+#include <ba/bytearray_view.hpp>
+#include <ba/search.hpp>
+
+// C++ STL
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace ba {
+
+/**
+ * @brief Class, that describes lazy range of tokens
+ * of byte array, separated by delimiter. Every token is
+ * `bytearray_view` over original storage, nothing is copied
+ * and nothing is allocated per token.
+ *
+ * Empty fields are preserved: "a,,b" gives "a", "", "b"
+ * and "a," gives "a", "". Empty input gives single empty
+ * token. Range refers to byte array, so byte array must
+ * not be modified while range is used.
+ */
+template <typename ValueType, typename Allocator>
+class split_range {
+    using processor = bytearray_processor<ValueType, Allocator>;
+
+public:
+    using size_type = typename processor::size_type;
+    using view = bytearray_view<ValueType, Allocator>;
+
+    /**
+     * @brief Input iterator over tokens.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = view;
+
+        iterator()
+            : m_range(nullptr)
+            , m_start(0)
+            , m_end(0) {}
+
+        /**
+         * @brief Method for getting current token.
+         */
+        view operator*() const { return view(*m_range->m_processor, m_range->m_offset + m_start, m_end - m_start); }
+
+        /**
+         * @brief Method for getting offset of current token
+         * from range start.
+         */
+        size_type offset() const { return m_start; }
+
+        iterator& operator++() {
+            if (m_end == m_range->m_size) {
+                m_range = nullptr;
+            } else {
+                m_start = m_end + m_range->m_delimiterSize;
+                m_end = m_range->find_from(m_start);
+            }
+
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator==(const iterator& rhs) const {
+            return m_range == rhs.m_range && (m_range == nullptr || m_start == rhs.m_start);
+        }
+
+        bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+
+    private:
+        friend class split_range;
+
+        explicit iterator(const split_range* range)
+            : m_range(range)
+            , m_start(0)
+            , m_end(range->find_from(0)) {}
+
+        const split_range* m_range;
+        size_type m_start;
+        size_type m_end;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param processor Byte array.
+     * @param offset Start of splitted region.
+     * @param size Size of splitted region.
+     * @param delimiter Pointer to delimiter.
+     * @param delimiterSize Delimiter size. Has to be non zero.
+     */
+    split_range(processor& processor, size_type offset, size_type size, const uint8_t* delimiter, std::size_t delimiterSize)
+        : m_processor(&processor)
+        , m_offset(offset)
+        , m_size(size)
+        , m_delimiterSize(delimiterSize) {
+        assert(delimiterSize > 0 && "Delimiter can't be empty.");
+
+        // Delimiter is copied, so temporary delimiters are allowed
+        if (delimiterSize <= m_inlineDelimiter.size()) {
+            std::copy(delimiter, delimiter + delimiterSize, m_inlineDelimiter.begin());
+        } else {
+            m_longDelimiter.assign(delimiter, delimiter + delimiterSize);
+        }
+    }
+
+    iterator begin() const { return iterator(this); }
+
+    iterator end() const { return iterator(); }
+
+private:
+    const uint8_t* delimiter() const { return m_longDelimiter.empty() ? m_inlineDelimiter.data() : m_longDelimiter.data(); }
+
+    /**
+     * @brief Method for searching delimiter.
+     * @return Position of delimiter or region size.
+     */
+    size_type find_from(size_type position) const {
+        auto data = reinterpret_cast<const uint8_t*>(m_processor->data()) + m_offset + position;
+        auto rest = m_size - position;
+
+        auto found = m_delimiterSize == 1 ? detail::find_byte(data, rest, delimiter()[0])
+                                          : detail::find_bytes(data, rest, delimiter(), m_delimiterSize);
+
+        return position + found;
+    }
+
+    processor* m_processor;
+    size_type m_offset;
+    size_type m_size;
+    std::size_t m_delimiterSize;
+    std::array<uint8_t, 16> m_inlineDelimiter{};
+    std::vector<uint8_t> m_longDelimiter;
+};
+
+/**
+ * @brief Function for splitting byte array by delimiter.
+ * @param array Byte array.
+ * @param delimiter Delimiter (byte sequence or string).
+ * @return Lazy range of views.
+ */
+template <typename ValueType, typename Allocator, typename Delimiter>
+typename std::enable_if<detail::is_needle<Delimiter>::value, split_range<ValueType, Allocator>>::type split(
+    bytearray_processor<ValueType, Allocator>& array,
+    const Delimiter& delimiter) {
+    return split_range<ValueType, Allocator>(array, 0, array.size(), detail::needle_data(delimiter),
+                                             detail::needle_size(delimiter));
+}
+
+/**
+ * @brief Function for splitting byte array view by delimiter.
+ * @param view Byte array view.
+ * @param delimiter Delimiter (byte sequence or string).
+ * @return Lazy range of subviews.
+ */
+template <typename ValueType, typename Allocator, typename Delimiter>
+typename std::enable_if<detail::is_needle<Delimiter>::value, split_range<ValueType, Allocator>>::type split(
+    bytearray_view<ValueType, Allocator>& view,
+    const Delimiter& delimiter) {
+    auto offset = std::size_t(view.data() - view.bytearray().data());
+
+    return split_range<ValueType, Allocator>(view.bytearray(), offset, view.size(), detail::needle_data(delimiter),
+                                             detail::needle_size(delimiter));
+}
+
+/**
+ * @brief Function for splitting byte array by single
+ * byte delimiter.
+ */
+template <typename ValueType, typename Allocator>
+split_range<ValueType, Allocator> split(bytearray_processor<ValueType, Allocator>& array, uint8_t delimiter) {
+    return split_range<ValueType, Allocator>(array, 0, array.size(), &delimiter, 1);
+}
+
+/**
+ * @brief Function for splitting byte array view by
+ * single byte delimiter.
+ */
+template <typename ValueType, typename Allocator>
+split_range<ValueType, Allocator> split(bytearray_view<ValueType, Allocator>& view, uint8_t delimiter) {
+    auto offset = std::size_t(view.data() - view.bytearray().data());
+
+    return split_range<ValueType, Allocator>(view.bytearray(), offset, view.size(), &delimiter, 1);
+}
+
+}  // namespace ba
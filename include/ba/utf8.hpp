@@ -0,0 +1,60 @@
+#pragma once
+
+// ba
+#include <ba/compare.hpp>
+#include <ba/detail/utf8.hpp>
+
+// C++ STL
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace ba {
+
+/**
+ * @brief Function for checking, that memory block
+ * is valid UTF-8 (shortest forms only, no surrogates,
+ * code points up to U+10FFFF). Vectorized with
+ * SSSE3/AVX2 lookup algorithm, ASCII blocks are skipped.
+ */
+inline bool validate_utf8(const void* data, std::size_t size) {
+    return detail::validate_utf8_bytes(static_cast<const uint8_t*>(data), size);
+}
+
+/**
+ * @brief Function for checking, that byte array,
+ * reader or view is valid UTF-8.
+ */
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bool>::type validate_utf8(const Sequence& sequence) {
+    return validate_utf8(detail::byte_data(sequence), detail::byte_size(sequence));
+}
+
+/**
+ * @brief Function for checking, that all bytes
+ * are 7 bit ASCII.
+ */
+inline bool is_ascii(const void* data, std::size_t size) {
+    return detail::is_ascii_bytes(static_cast<const uint8_t*>(data), size);
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, bool>::type is_ascii(const Sequence& sequence) {
+    return is_ascii(detail::byte_data(sequence), detail::byte_size(sequence));
+}
+
+/**
+ * @brief Function for counting printable ASCII
+ * bytes (`' '` - `'~'`, the same as ASCII column of
+ * hex dump).
+ */
+inline std::size_t count_printable(const void* data, std::size_t size) {
+    return detail::count_printable_bytes(static_cast<const uint8_t*>(data), size);
+}
+
+template <typename Sequence>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value, std::size_t>::type count_printable(const Sequence& sequence) {
+    return count_printable(detail::byte_data(sequence), detail::byte_size(sequence));
+}
+
+}  // namespace ba
@@ -0,0 +1,420 @@
+#pragma once
+
+// ba
+#include <ba/compare.hpp>
+#include <ba/detail/simd.hpp>
+#include <ba/detail/varint.hpp>
+
+// C++ STL
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace ba {
+
+/**
+ * @brief Function for zigzag encoding of signed value,
+ * so values with small magnitude have short varints.
+ */
+inline uint32_t zigzag_encode(int32_t value) {
+    return (uint32_t(value) << 1) ^ uint32_t(value >> 31);
+}
+
+inline uint64_t zigzag_encode(int64_t value) {
+    return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+/**
+ * @brief Function for zigzag decoding.
+ */
+inline int32_t zigzag_decode(uint32_t value) {
+    return int32_t((value >> 1) ^ (~(value & 1) + 1));
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+    return int64_t((value >> 1) ^ (~(value & 1) + 1));
+}
+
+namespace detail {
+
+/**
+ * @brief Function for decoding varint of up to
+ * 8 bytes without branches. 7 bit groups are
+ * compacted in 3 steps (16, 32 and 64 bit lanes).
+ * @param word Little endian 8 bytes, starting with varint.
+ * @param size Varint size (1 - 8).
+ */
+inline uint64_t compact_varint(uint64_t word, std::size_t size) {
+    if (size < 8) {
+        word &= (uint64_t(1) << (8 * size)) - 1;
+    }
+
+    word &= 0x7F7F7F7F7F7F7F7FULL;
+    word = ((word & 0x7F007F007F007F00ULL) >> 1) | (word & 0x007F007F007F007FULL);
+    word = ((word & 0x3FFF00003FFF0000ULL) >> 2) | (word & 0x00003FFF00003FFFULL);
+    word = ((word & 0x0FFFFFFF00000000ULL) >> 4) | (word & 0x000000000FFFFFFFULL);
+
+    return word;
+}
+
+#if defined(BA_SIMD_SSE2)
+/**
+ * @brief Function for storing 16 single byte values.
+ */
+template <typename T>
+inline void widen_bytes(__m128i bytes, T* output) {
+    auto zero = _mm_setzero_si128();
+    auto low = _mm_unpacklo_epi8(bytes, zero);
+    auto high = _mm_unpackhi_epi8(bytes, zero);
+
+    __m128i words[4] = {_mm_unpacklo_epi16(low, zero), _mm_unpackhi_epi16(low, zero), _mm_unpacklo_epi16(high, zero),
+                        _mm_unpackhi_epi16(high, zero)};
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        if (sizeof(T) == 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 4), words[i]);
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 4), _mm_unpacklo_epi32(words[i], zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 4 + 2), _mm_unpackhi_epi32(words[i], zero));
+        }
+    }
+}
+
+/**
+ * @brief Function for storing 4 values of 32 bit lanes.
+ */
+template <typename T>
+inline void store_lanes32(__m128i values, T* output) {
+    if (sizeof(T) == 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), values);
+    } else {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi32(values, _mm_setzero_si128()));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 2), _mm_unpackhi_epi32(values, _mm_setzero_si128()));
+    }
+}
+#endif
+
+#if defined(BA_SIMD_SSSE3)
+/**
+ * @brief Structure, that describes decoding of varints
+ * at the beginning of 16 byte block by continuation bits
+ * of it's first 12 bytes (Masked VByte).
+ */
+struct masked_varint_entry {
+    // 0 if first varints don't fit any pattern
+    uint8_t consumed;
+    uint8_t pattern;
+};
+
+// 6 varints of 1 - 2 bytes, 4 of 1 - 3 bytes, 2 of 1 - 5 bytes
+constexpr unsigned masked_varint_patterns = 64 + 81 + 25;
+
+/**
+ * @brief Function for building table of patterns for
+ * every 12 bit continuation mask. Pattern with the most
+ * varints is chosen.
+ */
+constexpr std::array<masked_varint_entry, 4096> make_masked_varint_table() {
+    std::array<masked_varint_entry, 4096> result{};
+
+    for (unsigned mask = 0; mask < 4096; ++mask) {
+        unsigned lengths[12] = {};
+        unsigned count = 0;
+        unsigned start = 0;
+
+        for (unsigned i = 0; i < 12; ++i) {
+            if ((mask >> i & 1) == 0) {
+                lengths[count++] = i + 1 - start;
+                start = i + 1;
+            }
+        }
+
+        auto fits = [&](unsigned amount, unsigned longest) {
+            if (count < amount) {
+                return false;
+            }
+
+            for (unsigned i = 0; i < amount; ++i) {
+                if (lengths[i] > longest) {
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        unsigned pattern = 0;
+        unsigned amount = 0;
+
+        if (fits(6, 2)) {
+            amount = 6;
+
+            for (unsigned i = 0; i < 6; ++i) {
+                pattern |= (lengths[i] - 1) << i;
+            }
+        } else if (fits(4, 3)) {
+            amount = 4;
+
+            for (unsigned i = 4; i-- > 0;) {
+                pattern = pattern * 3 + lengths[i] - 1;
+            }
+
+            pattern += 64;
+        } else if (fits(2, 5)) {
+            amount = 2;
+            pattern = 64 + 81 + (lengths[0] - 1) * 5 + lengths[1] - 1;
+        } else {
+            continue;
+        }
+
+        unsigned consumed = 0;
+
+        for (unsigned i = 0; i < amount; ++i) {
+            consumed += lengths[i];
+        }
+
+        result[mask] = masked_varint_entry{uint8_t(consumed), uint8_t(pattern)};
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for building shuffles, that move
+ * bytes of every varint of pattern to 16, 32 or 64 bit
+ * lane.
+ */
+constexpr std::array<std::array<uint8_t, 16>, masked_varint_patterns> make_masked_varint_shuffles() {
+    std::array<std::array<uint8_t, 16>, masked_varint_patterns> result{};
+
+    for (unsigned pattern = 0; pattern < masked_varint_patterns; ++pattern) {
+        unsigned lengths[6] = {};
+        unsigned amount = 0;
+        unsigned width = 0;
+
+        if (pattern < 64) {
+            amount = 6;
+            width = 2;
+
+            for (unsigned i = 0; i < 6; ++i) {
+                lengths[i] = 1 + (pattern >> i & 1);
+            }
+        } else if (pattern < 64 + 81) {
+            amount = 4;
+            width = 4;
+
+            for (unsigned i = 0, rest = pattern - 64; i < 4; ++i, rest /= 3) {
+                lengths[i] = 1 + rest % 3;
+            }
+        } else {
+            amount = 2;
+            width = 8;
+            lengths[0] = 1 + (pattern - 64 - 81) / 5;
+            lengths[1] = 1 + (pattern - 64 - 81) % 5;
+        }
+
+        for (auto& index : result[pattern]) {
+            index = 0x80;
+        }
+
+        for (unsigned i = 0, start = 0; i < amount; start += lengths[i++]) {
+            for (unsigned k = 0; k < lengths[i]; ++k) {
+                result[pattern][i * width + k] = uint8_t(start + k);
+            }
+        }
+    }
+
+    return result;
+}
+
+inline constexpr auto masked_varint_table = make_masked_varint_table();
+inline constexpr auto masked_varint_shuffles = make_masked_varint_shuffles();
+
+/**
+ * @brief Function for decoding varints of pattern:
+ * bytes are shuffled to lanes and 7 bit groups are
+ * compacted like in `compact_varint`. Up to 8 values
+ * are stored.
+ * @return Amount of decoded values, 0 if 5 byte
+ * varint doesn't fit `T`.
+ */
+template <typename T>
+inline std::size_t decode_masked_varints(__m128i bytes, masked_varint_entry entry, T* output) {
+    auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masked_varint_shuffles[entry.pattern].data()));
+    auto lanes = _mm_shuffle_epi8(bytes, shuffle);
+
+    lanes = _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi16(0x007F)), _mm_srli_epi16(_mm_and_si128(lanes, _mm_set1_epi16(0x7F00)), 1));
+
+    if (entry.pattern < 64) {
+        store_lanes32(_mm_unpacklo_epi16(lanes, _mm_setzero_si128()), output);
+        store_lanes32(_mm_unpackhi_epi16(lanes, _mm_setzero_si128()), output + 4);
+
+        return 6;
+    }
+
+    lanes = _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi32(0x3FFF)), _mm_srli_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0x3FFF0000)), 2));
+
+    if (entry.pattern < 64 + 81) {
+        store_lanes32(lanes, output);
+
+        return 4;
+    }
+
+    lanes = _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi64x(0x0FFFFFFF)),
+                         _mm_srli_epi64(_mm_and_si128(lanes, _mm_set1_epi64x(0x0FFFFFFF00000000LL)), 4));
+
+    if (sizeof(T) == 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), lanes);
+
+        return 2;
+    }
+
+    // 5 byte varints may have up to 35 bits
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi64(lanes, 32), _mm_setzero_si128())) != 0xFFFF) {
+        return 0;
+    }
+
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output), _mm_shuffle_epi32(lanes, _MM_SHUFFLE(3, 1, 2, 0)));
+
+    return 2;
+}
+#endif
+
+/**
+ * @brief Function for decoding sequence of varints.
+ * Continuation bits of 16 bytes from current position
+ * are taken with single movemask: 16 single byte values
+ * are decoded at once, otherwise (SSSE3) 12 bits of mask
+ * select shuffle of 6, 4 or 2 varints (Masked VByte by
+ * Plaisance, Kurz and Lemire). Otherwise ends of varints
+ * are taken from the mask and every varint, that ends in
+ * block, is decoded without loops.
+ * @return Amount of consumed bytes.
+ */
+template <typename T>
+std::size_t decode_varints(const uint8_t* data, std::size_t size, std::vector<T>& output) {
+    std::size_t position = 0;
+
+#if defined(BA_SIMD_SSE2)
+    // Vectors are stored past decoded values, so output is trimmed after loop
+    auto written = output.size();
+
+    // Varint, that ends in block, is loaded as 8 bytes
+    while (position + 24 <= size) {
+        if (output.size() - written < 16) {
+            output.resize(2 * written + 64);
+        }
+
+        auto out = output.data() + written;
+        auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        auto continuation = unsigned(_mm_movemask_epi8(bytes));
+
+        if (continuation == 0) {
+            widen_bytes(bytes, out);
+
+            position += 16;
+            written += 16;
+            continue;
+        }
+
+#if defined(BA_SIMD_SSSE3)
+        auto entry = masked_varint_table[continuation & 0xFFF];
+
+        if (entry.consumed != 0) {
+            auto count = decode_masked_varints(bytes, entry, out);
+
+            if (count != 0) {
+                position += entry.consumed;
+                written += count;
+                continue;
+            }
+        }
+#endif
+
+        // Every varint, that ends in block, is decoded by it's end
+        auto ends = ~continuation & 0xFFFFu;
+        std::size_t start = 0;
+
+        while (ends != 0) {
+            std::size_t end = count_trailing_zeros(ends);
+            std::size_t length = end - start + 1;
+            uint64_t value;
+
+            if (length <= 8) {
+                value = compact_varint(load<uint64_t>(data + position + start), length);
+            } else if (decode_varint(data + position + start, length, value) != length) {
+                break;
+            }
+
+            if (value > std::numeric_limits<T>::max()) {
+                break;
+            }
+
+            *out++ = T(value);
+
+            start = end + 1;
+            ends &= ends - 1;
+        }
+
+        written += std::size_t(out - (output.data() + written));
+        position += start;
+
+        // 16 continuation bytes or invalid value
+        if (ends != 0 || start == 0) {
+            break;
+        }
+    }
+
+    output.resize(written);
+#endif
+
+    while (position < size) {
+        uint64_t value;
+        auto length = decode_varint(data + position, size - position, value);
+
+        if (length == 0 || value > std::numeric_limits<T>::max()) {
+            break;
+        }
+
+        output.push_back(T(value));
+        position += length;
+    }
+
+    return position;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Function for decoding all LEB128 values
+ * of raw memory. Decoding stops at truncated or
+ * invalid value, so rest can be decoded with next
+ * chunk of stream.
+ * @tparam T `uint32_t` or `uint64_t`.
+ * @param data Pointer to data.
+ * @param size Size of data.
+ * @param output Vector, values are appended to.
+ * @return Amount of consumed bytes.
+ */
+template <typename T>
+typename std::enable_if<std::is_same<T, uint32_t>::value || std::is_same<T, uint64_t>::value, std::size_t>::type
+decode_varints(const void* data, std::size_t size, std::vector<T>& output) {
+    return detail::decode_varints(static_cast<const uint8_t*>(data), size, output);
+}
+
+/**
+ * @brief Function for decoding all LEB128 values
+ * of byte array, it's reader or view.
+ */
+template <typename Sequence, typename T>
+typename std::enable_if<detail::is_byte_sequence<Sequence>::value &&
+                            (std::is_same<T, uint32_t>::value || std::is_same<T, uint64_t>::value),
+                        std::size_t>::type
+decode_varints(const Sequence& sequence, std::vector<T>& output) {
+    return detail::decode_varints(detail::byte_data(sequence), detail::byte_size(sequence), output);
+}
+
+}  // namespace ba
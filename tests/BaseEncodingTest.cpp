@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+#include <ba/base_encoding.hpp>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include "TestData.hpp"
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace {
+
+ba::bytearray<> bytes(std::string_view text) {
+    ba::bytearray<> result;
+
+    for (auto symbol : text) {
+        result.push_back<uint8_t>(uint8_t(symbol));
+    }
+
+    return result;
+}
+
+// Bit by bit reference encoder
+std::string reference(const std::vector<uint8_t>& data, std::string_view symbols, unsigned bits) {
+    std::string result;
+    uint32_t accumulator = 0;
+    unsigned count = 0;
+
+    for (auto value : data) {
+        accumulator = accumulator << 8 | value;
+        count += 8;
+
+        while (count >= bits) {
+            count -= bits;
+            result += symbols[(accumulator >> count) & ((1u << bits) - 1)];
+        }
+    }
+
+    if (count != 0) {
+        result += symbols[(accumulator << (bits - count)) & ((1u << bits) - 1)];
+    }
+
+    return result;
+}
+
+bool decode64(std::string_view text, ba::bytearray<>& result, ba::decode_mode mode = ba::decode_mode::strict) {
+    result.clear();
+    return ba::base64_decode(text, result, ba::base64_alphabet::standard, mode);
+}
+
+}  // namespace
+
+TEST(BaseEncoding, Base64Known) {
+    const std::pair<std::string_view, std::string_view> vectors[] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"}};
+
+    for (auto& [data, text] : vectors) {
+        ASSERT_EQ(ba::base64_encode(bytes(data)), text);
+        ASSERT_EQ(ba::base64_encoded_size(data.size()), text.size());
+
+        ba::bytearray<> decoded;
+
+        ASSERT_TRUE(decode64(text, decoded)) << text;
+        ASSERT_EQ(decoded, bytes(data));
+        ASSERT_EQ(ba::base64_decoded_size(text), data.size());
+    }
+
+    ASSERT_EQ(ba::base64_encode("FBFF"_ba), "+/8=");
+    ASSERT_EQ(ba::base64_encode("FBFF"_ba, ba::base64_alphabet::url, false), "-_8");
+
+    ba::bytearray<> decoded;
+
+    ASSERT_TRUE(ba::base64_decode("-_8", decoded, ba::base64_alphabet::url));
+    ASSERT_EQ(decoded, "FBFF"_ba);
+}
+
+TEST(BaseEncoding, Base64Random) {
+    for (std::size_t size = 0; size < 300; size += 7) {
+        for (auto alphabet : {ba::base64_alphabet::standard, ba::base64_alphabet::url}) {
+            auto data = test_data::random_bytes(size, uint32_t(size));
+            auto symbols = alphabet == ba::base64_alphabet::url ? ba::detail::base64_url_symbols : ba::detail::base64_standard_symbols;
+
+            std::string text(ba::base64_encoded_size(size, false), '\0');
+
+            ASSERT_EQ(ba::base64_encode(data.data(), size, text.data(), alphabet, false), text.size());
+            ASSERT_EQ(text, reference(data, symbols, 6)) << size;
+
+            std::vector<uint8_t> decoded(ba::base64_decoded_size(text));
+            auto decodedSize = decoded.size();
+
+            ASSERT_TRUE(ba::base64_decode(text, decoded.data(), decodedSize, alphabet)) << size;
+            ASSERT_EQ(decodedSize, size);
+            ASSERT_EQ(decoded, data);
+        }
+    }
+}
+
+TEST(BaseEncoding, Base64Strict) {
+    ba::bytearray<> decoded = "AA"_ba;
+
+    // Invalid symbols in every block position
+    auto text = ba::base64_encode(bytes(std::string(120, 'x')));
+
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        auto damaged = text;
+
+        damaged[i] = '*';
+        ASSERT_FALSE(decode64(damaged, decoded)) << i;
+
+        damaged[i] = ' ';
+        ASSERT_FALSE(decode64(damaged, decoded)) << i;
+    }
+
+    ASSERT_FALSE(decode64("Zg=", decoded));
+    ASSERT_FALSE(decode64("Zg===", decoded));
+    ASSERT_FALSE(decode64("Z===", decoded));
+    ASSERT_FALSE(decode64("Z", decoded));
+    ASSERT_FALSE(decode64("Zm9v=", decoded));
+    ASSERT_FALSE(decode64("Zm=v", decoded));
+    // Not zero unused bits
+    ASSERT_FALSE(decode64("Zh==", decoded));
+    ASSERT_FALSE(decode64("Zm9=", decoded));
+    ASSERT_FALSE(decode64("-_8", decoded));
+
+    // Not padded text is accepted
+    ASSERT_TRUE(decode64("Zg", decoded));
+    ASSERT_EQ(decoded, "66"_ba);
+
+    // Target is not changed on failure
+    decoded = "AA"_ba;
+
+    ASSERT_FALSE(ba::base64_decode("Zh==", decoded));
+    ASSERT_EQ(decoded, "AA"_ba);
+
+    // Output buffer is too small
+    uint8_t output[2];
+    std::size_t outputSize = sizeof(output);
+
+    ASSERT_FALSE(ba::base64_decode("Zm9v", output, outputSize));
+}
+
+TEST(BaseEncoding, Base64Lenient) {
+    auto data = test_data::random_bytes(500, 2);
+    auto text = ba::base64_encode(ba::bytearray<>(reinterpret_cast<const std::byte*>(data.data()), data.size()));
+
+    // MIME lines
+    std::string wrapped;
+
+    for (std::size_t i = 0; i < text.size(); i += 76) {
+        wrapped += text.substr(i, 76) + "\r\n";
+    }
+
+    ba::bytearray<> decoded;
+
+    ASSERT_FALSE(decode64(wrapped, decoded));
+    ASSERT_TRUE(decode64(wrapped, decoded, ba::decode_mode::lenient));
+    ASSERT_EQ(decoded.size(), data.size());
+    ASSERT_EQ(std::memcmp(decoded.data(), data.data(), data.size()), 0);
+
+    ASSERT_TRUE(decode64(" Z m 9 v\nY h = = = \n", decoded, ba::decode_mode::lenient));
+    ASSERT_EQ(decoded, bytes("foob"));
+
+    ASSERT_FALSE(decode64("Zm9v*", decoded, ba::decode_mode::lenient));
+    ASSERT_FALSE(decode64("Zm=9v", decoded, ba::decode_mode::lenient));
+}
+
+TEST(BaseEncoding, Base32) {
+    const std::pair<std::string_view, std::string_view> vectors[] = {{"", ""},
+                                                                     {"f", "MY======"},
+                                                                     {"fo", "MZXQ===="},
+                                                                     {"foo", "MZXW6==="},
+                                                                     {"foob", "MZXW6YQ="},
+                                                                     {"fooba", "MZXW6YTB"},
+                                                                     {"foobar", "MZXW6YTBOI======"}};
+
+    for (auto& [data, text] : vectors) {
+        ASSERT_EQ(ba::base32_encode(bytes(data)), text);
+        ASSERT_EQ(ba::base32_encoded_size(data.size()), text.size());
+
+        ba::bytearray<> decoded;
+
+        ASSERT_TRUE(ba::base32_decode(text, decoded)) << text;
+        ASSERT_EQ(decoded, bytes(data));
+    }
+
+    for (std::size_t size = 0; size < 100; ++size) {
+        auto data = test_data::random_bytes(size, uint32_t(size));
+        auto array = ba::bytearray<>(reinterpret_cast<const std::byte*>(data.data()), data.size());
+        auto text = ba::base32_encode(array, false);
+
+        ASSERT_EQ(text, reference(data, ba::detail::base32_symbols, 5));
+
+        ba::bytearray<> decoded;
+
+        ASSERT_TRUE(ba::base32_decode(text, decoded));
+        ASSERT_EQ(decoded, array);
+    }
+
+    ba::bytearray<> decoded;
+
+    ASSERT_FALSE(ba::base32_decode("mzxw6===", decoded));
+    ASSERT_FALSE(ba::base32_decode("MZXW6Y==", decoded));
+    ASSERT_FALSE(ba::base32_decode("MZ======", decoded));
+    ASSERT_TRUE(ba::base32_decode("MZXW6===", decoded));
+
+    decoded.clear();
+
+    ASSERT_TRUE(ba::base32_decode("mzxw 6yq\n", decoded, ba::decode_mode::lenient));
+    ASSERT_EQ(decoded, bytes("foob"));
+}
+
+TEST(BaseEncoding, Z85) {
+    auto data = "864FD26FB559F75B"_ba;
+
+    ASSERT_EQ(ba::z85_encode(data), "HelloWorld");
+
+    ba::bytearray<> decoded;
+
+    ASSERT_TRUE(ba::z85_decode("HelloWorld", decoded));
+    ASSERT_EQ(decoded, data);
+
+    for (std::size_t size = 0; size < 50; ++size) {
+        auto sampleData = test_data::random_bytes(size, uint32_t(size));
+        auto array = ba::bytearray<>(reinterpret_cast<const std::byte*>(sampleData.data()), sampleData.size());
+        auto text = ba::z85_encode(array);
+
+        ASSERT_EQ(text.size(), ba::z85_encoded_size(size));
+        ASSERT_EQ(ba::z85_decoded_size(text), size);
+
+        decoded.clear();
+
+        ASSERT_TRUE(ba::z85_decode(text, decoded)) << size;
+        ASSERT_EQ(decoded, array);
+    }
+
+    // Group value is bigger, than 2^32 - 1
+    ASSERT_FALSE(ba::z85_decode("%nSc1", decoded));
+    ASSERT_FALSE(ba::z85_decode("Hello World", decoded));
+    ASSERT_FALSE(ba::z85_decode("Hello\"orld", decoded));
+    ASSERT_FALSE(ba::z85_decode("HelloW", decoded));
+
+    decoded.clear();
+
+    ASSERT_TRUE(ba::z85_decode("Hello\r\nWorld", decoded, ba::decode_mode::lenient));
+    ASSERT_EQ(decoded, data);
+
+    // Incomplete group has single encoding
+    auto tail = ba::z85_encode("AB"_ba);
+
+    tail.back() = ba::detail::z85_symbols[ba::detail::z85_codes[uint8_t(tail.back())] + 1];
+
+    ASSERT_FALSE(ba::z85_decode(tail, decoded));
+}
+
+TEST(BaseEncoding, LongText) {
+    // Longer, than SIMD blocks, every symbol is used
+    auto data = test_data::random_bytes(1000, 3);
+    auto array = ba::bytearray<>(reinterpret_cast<const std::byte*>(data.data()), data.size());
+
+    ba::bytearray<> decoded;
+
+    auto base32 = ba::base32_encode(array, false);
+
+    ASSERT_EQ(base32, reference(data, ba::detail::base32_symbols, 5));
+
+    std::string lower;
+
+    for (auto symbol : base32) {
+        lower += char(std::tolower(symbol));
+    }
+
+    ASSERT_FALSE(ba::base32_decode(lower, decoded));
+    ASSERT_TRUE(ba::base32_decode(lower, decoded, ba::decode_mode::lenient));
+    ASSERT_EQ(decoded, array);
+
+    auto z85 = ba::z85_encode(array);
+
+    // Groups are encoded independently
+    for (std::size_t i = 0; i < data.size(); i += 4) {
+        ASSERT_EQ(z85.substr(i / 4 * 5, 5), ba::z85_encode(ba::bytearray_view(array, i, 4))) << i;
+    }
+
+    // Invalid symbols in every block position
+    for (std::size_t i = 0; i < 200; ++i) {
+        auto damaged = base32.substr(0, 200);
+
+        damaged[i] = '1';
+        ASSERT_FALSE(ba::base32_decode(damaged, decoded)) << i;
+
+        damaged = z85.substr(0, 200);
+        damaged[i] = '"';
+        ASSERT_FALSE(ba::z85_decode(damaged, decoded)) << i;
+    }
+
+    // Group value is bigger, than 2^32 - 1, in the middle of block
+    auto large = z85.substr(0, 200);
+
+    large.replace(85, 5, "%nSc1");
+    ASSERT_FALSE(ba::z85_decode(large, decoded));
+
+    large.replace(85, 5, "%nSc0");
+    decoded.clear();
+    ASSERT_TRUE(ba::z85_decode(large, decoded));
+    ASSERT_EQ(decoded.read<uint32_t>(68), 0xFFFFFFFF);
+}
+
+TEST(BaseEncoding, View) {
+    auto array = "00666F6F00"_ba;
+
+    ba::bytearray_view view(array, 1, 3);
+
+    ASSERT_EQ(ba::base64_encode(view), "Zm9v");
+    ASSERT_EQ(ba::base32_encode(view), "MZXW6===");
+    ASSERT_EQ(ba::z85_encode(view), "w]zO");
+
+    ASSERT_TRUE(ba::base64_decode("YmFy", array));
+    ASSERT_EQ(array, "00666F6F00626172"_ba);
+}
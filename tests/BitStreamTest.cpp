@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <ba/bit_stream.hpp>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+
+#include <random>
+
+TEST(BitStream, MsbFirst) {
+    ba::bytearray<> array;
+    ba::bit_writer writer(array);
+
+    writer.write_bits(0b101, 3);
+    writer.write_bits(0b00011, 5);
+    writer.write_bit(true);
+    writer.flush();
+
+    ASSERT_EQ(array, "A380"_ba);
+
+    ba::bit_reader reader(array);
+
+    ASSERT_EQ(reader.read_bits(3), 0b101);
+    ASSERT_EQ(reader.peek_bits(5), 0b00011);
+    ASSERT_EQ(reader.read_bits(5), 0b00011);
+    ASSERT_TRUE(reader.read_bit());
+    ASSERT_FALSE(reader.is_aligned());
+
+    reader.align_to_byte();
+
+    ASSERT_EQ(reader.position(), 16);
+    ASSERT_EQ(reader.bits_left(), 0);
+}
+
+TEST(BitStream, LsbFirst) {
+    ba::bytearray<> array;
+    ba::bit_writer writer(array, ba::bit_order::lsb_first);
+
+    writer.write_bits(0b101, 3);
+    writer.write_bits(0b00011, 5);
+    writer.write_bits(0x1, 2);
+    writer.flush();
+
+    ASSERT_EQ(array, "1D01"_ba);
+
+    ba::bit_reader reader(array, ba::bit_order::lsb_first);
+
+    ASSERT_EQ(reader.read_bits(3), 0b101);
+    ASSERT_EQ(reader.read_bits(5), 0b00011);
+    ASSERT_EQ(reader.read_bits(2), 0x1);
+}
+
+TEST(BitStream, RoundTrip) {
+    for (auto order : {ba::bit_order::msb_first, ba::bit_order::lsb_first}) {
+        std::mt19937_64 generator(3);
+        std::vector<std::pair<uint64_t, unsigned>> values;
+
+        ba::bytearray<> array;
+        ba::bit_writer writer(array, order);
+
+        for (std::size_t i = 0; i < 10000; ++i) {
+            unsigned count = unsigned(generator() % 65);
+            uint64_t value = generator() & ba::detail::low_bits_mask(count);
+
+            values.emplace_back(value, count);
+            writer.write_bits(value, count);
+        }
+
+        auto total = writer.position();
+
+        writer.flush();
+
+        ASSERT_EQ(array.size(), (total + 7) / 8);
+
+        ba::bit_reader reader(array, order);
+
+        for (auto& [value, count] : values) {
+            ASSERT_EQ(reader.read_bits(count), value) << count;
+        }
+
+        ASSERT_EQ(reader.position(), total);
+    }
+}
+
+TEST(BitStream, Skip) {
+    auto array = "0123456789ABCDEF0123456789ABCDEF"_ba;
+
+    for (auto order : {ba::bit_order::msb_first, ba::bit_order::lsb_first}) {
+        for (std::size_t skip = 0; skip < 120; ++skip) {
+            ba::bit_reader expected(array, order);
+            ba::bit_reader reader(array, order);
+
+            for (std::size_t i = 0; i < skip; ++i) {
+                expected.read_bit();
+            }
+
+            reader.read_bits(3);
+            reader.skip_bits(skip < 3 ? 0 : skip - 3);
+
+            if (skip < 3) {
+                continue;
+            }
+
+            ASSERT_EQ(reader.position(), skip);
+            ASSERT_EQ(reader.read_bits(8), expected.read_bits(8)) << skip;
+        }
+    }
+}
+
+TEST(BitStream, View) {
+    auto array = "FFFF"_ba;
+
+    ba::bytearray_view view(array, 1, 0);
+    ba::bit_writer writer(view);
+
+    writer.write_bits(0xABC, 12);
+    writer.flush();
+
+    ASSERT_EQ(array, "FFABC0FF"_ba);
+
+    ba::bit_reader reader(view);
+
+    ASSERT_EQ(reader.read_bits(12), 0xABC);
+}
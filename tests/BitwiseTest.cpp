@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <ba/bitwise.hpp>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include "TestData.hpp"
+
+TEST(Bitwise, Known) {
+    auto array = "F00F55AA"_ba;
+
+    array.xor_with("FF00FF00"_ba);
+    ASSERT_EQ(array, "0F0FAAAA"_ba);
+
+    array.and_with("F0F0"_ba, 2);
+    ASSERT_EQ(array, "0F0FA0A0"_ba);
+
+    array.or_with("01"_ba, 1);
+    ASSERT_EQ(array, "0F0FA0A0"_ba);
+
+    array.or_with("10"_ba, 1);
+    ASSERT_EQ(array, "0F1FA0A0"_ba);
+
+    array.invert();
+    ASSERT_EQ(array, "F0E05F5F"_ba);
+
+    ASSERT_EQ(ba::bitwise_xor("0102"_ba, "0303"_ba), "0201"_ba);
+    ASSERT_EQ(ba::bitwise_and("0102"_ba, "0303"_ba), "0102"_ba);
+    ASSERT_EQ(ba::bitwise_or("0102"_ba, "0404"_ba), "0506"_ba);
+    ASSERT_EQ(ba::bitwise_not("00FF"_ba), "FF00"_ba);
+}
+
+TEST(Bitwise, Unaligned) {
+    for (std::size_t size : {0, 1, 7, 8, 15, 16, 31, 32, 33, 127, 128, 129, 1000}) {
+        for (std::size_t shift = 0; shift < 3; ++shift) {
+            auto lhs = test_data::random_bytes(size + shift, uint32_t(size));
+            auto rhs = test_data::random_bytes(size + shift, uint32_t(size + 1));
+
+            std::vector<uint8_t> output(size + shift);
+
+            ba::xor_bytes(output.data() + shift, lhs.data() + shift, rhs.data(), size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                ASSERT_EQ(output[i + shift], uint8_t(lhs[i + shift] ^ rhs[i]));
+            }
+
+            ba::and_bytes(output.data(), lhs.data(), rhs.data() + shift, size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                ASSERT_EQ(output[i], uint8_t(lhs[i] & rhs[i + shift]));
+            }
+
+            ba::or_bytes(output.data() + shift, lhs.data(), rhs.data(), size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                ASSERT_EQ(output[i + shift], uint8_t(lhs[i] | rhs[i]));
+            }
+
+            ba::invert_bytes(output.data(), lhs.data() + shift, size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                ASSERT_EQ(output[i], uint8_t(~lhs[i + shift]));
+            }
+
+            // In place
+            auto copy = lhs;
+            ba::xor_bytes(copy.data() + shift, copy.data() + shift, rhs.data() + shift, size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                ASSERT_EQ(copy[i + shift], uint8_t(lhs[i + shift] ^ rhs[i + shift]));
+            }
+        }
+    }
+}
+
+TEST(Bitwise, Mask) {
+    for (std::size_t keySize = 1; keySize <= 40; ++keySize) {
+        auto key = test_data::random_bytes(keySize, uint32_t(keySize));
+
+        for (std::size_t size : {0, 3, 16, 33, 100, 1000}) {
+            auto input = test_data::random_bytes(size, uint32_t(size));
+
+            for (std::size_t offset : {std::size_t(0), std::size_t(1), keySize - 1, keySize + 5}) {
+                std::vector<uint8_t> output(size);
+
+                auto next = ba::xor_mask_bytes(output.data(), input.data(), size, key.data(), keySize, offset);
+
+                ASSERT_EQ(next, (offset + size) % keySize);
+
+                for (std::size_t i = 0; i < size; ++i) {
+                    ASSERT_EQ(output[i], uint8_t(input[i] ^ key[(offset + i) % keySize])) << keySize << " " << size << " " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(Bitwise, MaskStream) {
+    // WebSocket payload, masked chunk by chunk
+    auto payload = test_data::random_bytes(1000, 1);
+    auto key = "37FA213D"_ba;
+
+    ba::bytearray<> array;
+
+    for (auto value : payload) {
+        array.push_back<uint8_t>(value);
+    }
+
+    auto whole = ba::xor_masked(array, key);
+
+    std::size_t offset = 0;
+
+    for (std::size_t position = 0; position < array.size();) {
+        auto size = std::min<std::size_t>(array.size() - position, position % 7 + 13);
+
+        offset = array.xor_mask(key.data(), key.size(), offset, position, size);
+        position += size;
+    }
+
+    ASSERT_EQ(array, whole);
+
+    // XOR twice gives original data
+    array.xor_mask(key);
+    ASSERT_EQ(ba::xor_masked(array, key), whole);
+}
+
+TEST(Bitwise, View) {
+    auto array = "00112233445566778899"_ba;
+
+    ba::bytearray_view view(array, 2, 6);
+
+    view.xor_with("FFFF"_ba, 1);
+    ASSERT_EQ(array, "001122CCBB5566778899"_ba);
+
+    view.invert(4, 2);
+    ASSERT_EQ(array, "001122CCBB5599888899"_ba);
+
+    ASSERT_EQ(view.xor_mask("01"_ba, 0), 0);
+    ASSERT_EQ(array, "001123CDBA5498898899"_ba);
+
+    view.and_with("0F0F0F0F0F0F"_ba);
+    ASSERT_EQ(array, "0011030D0A0408098899"_ba);
+
+    view.or_with("F0"_ba, 5);
+    ASSERT_EQ(array, "0011030D0A0408F98899"_ba);
+}
+
+TEST(Bitwise, Rollback) {
+    auto array = "00112233"_ba;
+
+    auto point = array.mark();
+
+    array.xor_with("FFFF"_ba, 1);
+    array.invert();
+
+    ASSERT_TRUE(array.rollback(point));
+    ASSERT_EQ(array, "00112233"_ba);
+
+    array.commit();
+}
+
+TEST(Bitwise, RollbackLarge) {
+    // Regions are longer, than journal_limit 8 byte chunks
+    auto array = test_data::random_bytearray(64 * 1024, 7);
+    auto key = test_data::random_bytearray(32 * 1024, 8);
+    auto expected = array;
+
+    auto point = array.mark();
+
+    array.xor_with(key, 1000);
+    array.invert();
+    array.swap_endianness<uint32_t>(0, array.size() / 4);
+
+    ASSERT_NE(array, expected);
+    ASSERT_TRUE(array.rollback(point));
+    ASSERT_EQ(array, expected);
+
+    array.commit();
+}
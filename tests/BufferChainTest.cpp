@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <ba/buffer_chain.hpp>
+
+TEST(BufferChain, PrependAppend) {
+    ba::buffer_chain chain(16, 4);
+
+    chain.append("CCDD"_ba);
+
+    ASSERT_EQ(chain.segments(), 1);
+    ASSERT_EQ(chain.headroom(), 4);
+
+    // Fits into headroom, no new segment
+    chain.push_front(uint16_t(0xAABB));
+
+    ASSERT_EQ(chain.segments(), 1);
+    ASSERT_EQ(chain.headroom(), 2);
+
+    // Doesn't fit into headroom
+    chain.push_front(uint32_t(0x00112233), ba::endianness::little);
+
+    ASSERT_EQ(chain.segments(), 2);
+
+    chain.push_back(uint8_t(0xEE));
+
+    ASSERT_EQ(chain.size(), 9);
+    ASSERT_EQ(chain.to_bytearray(), "33221100AABBCCDDEE"_ba);
+}
+
+TEST(BufferChain, LargeAppend) {
+    ba::buffer_chain chain(8, 0);
+
+    ba::bytearray<> payload(100);
+
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = std::byte(i);
+    }
+
+    chain.append(payload);
+    chain.append(payload);
+
+    ASSERT_EQ(chain.segments(), 2);
+    ASSERT_EQ(chain.size(), 200);
+
+    auto data = chain.coalesce();
+
+    ASSERT_EQ(chain.segments(), 1);
+    ASSERT_TRUE(std::equal(payload.begin(), payload.end(), data));
+    ASSERT_TRUE(std::equal(payload.begin(), payload.end(), data + 100));
+}
+
+TEST(BufferChain, Splice) {
+    ba::buffer_chain header;
+    ba::buffer_chain body;
+    ba::buffer_chain trailer;
+
+    header.append("01"_ba);
+    body.append("0203"_ba);
+    trailer.append("04"_ba);
+
+    body.prepend(std::move(header));
+    body.append(std::move(trailer));
+
+    ASSERT_TRUE(header.empty());
+    ASSERT_TRUE(trailer.empty());
+    ASSERT_EQ(body.segments(), 3);
+    ASSERT_EQ(body.to_bytearray(), "01020304"_ba);
+}
+
+TEST(BufferChain, SplitTrim) {
+    ba::buffer_chain chain(4, 0);
+
+    chain.append("0001020304050607"_ba);
+    chain.append("08090A"_ba);
+
+    auto head = chain.split(3);
+
+    ASSERT_EQ(head.to_bytearray(), "000102"_ba);
+    ASSERT_EQ(chain.to_bytearray(), "030405060708090A"_ba);
+
+    // Segment at split point is shared, so it's not written
+    ASSERT_EQ(head.tailroom(), 0);
+    ASSERT_EQ(chain.headroom(), 0);
+
+    head.push_back(uint8_t(0xFF));
+
+    ASSERT_EQ(head.to_bytearray(), "000102FF"_ba);
+    ASSERT_EQ(chain.to_bytearray(), "030405060708090A"_ba);
+
+    chain.trim_front(6);
+
+    ASSERT_EQ(chain.to_bytearray(), "090A"_ba);
+
+    chain.trim_back(1);
+
+    ASSERT_EQ(chain.to_bytearray(), "09"_ba);
+
+    chain.trim_back(1);
+
+    ASSERT_TRUE(chain.empty());
+    ASSERT_EQ(chain.segments(), 0);
+}
+
+TEST(BufferChain, Clone) {
+    ba::buffer_chain chain;
+
+    chain.append("0102"_ba);
+
+    auto copy = chain.clone();
+
+    chain.push_back(uint8_t(0x03));
+    copy.push_back(uint8_t(0x04));
+
+    ASSERT_EQ(chain.to_bytearray(), "010203"_ba);
+    ASSERT_EQ(copy.to_bytearray(), "010204"_ba);
+}
+
+TEST(BufferChain, Cursor) {
+    ba::buffer_chain chain(2, 0);
+
+    chain.append("0102"_ba);
+    chain.append("0304"_ba);
+    chain.append("05060708"_ba);
+
+    ASSERT_EQ(chain.segments(), 3);
+
+    auto cursor = chain.make_cursor();
+
+    ASSERT_EQ(cursor.read<uint8_t>(), 0x01);
+    ASSERT_EQ(cursor.read<uint16_t>(), 0x0203);
+    ASSERT_EQ(cursor.read<uint16_t>(ba::endianness::little), 0x0504);
+
+    cursor.skip(1);
+
+    ASSERT_EQ(cursor.position(), 6);
+    ASSERT_EQ(cursor.remaining(), 2);
+    ASSERT_EQ(cursor.read<uint16_t>(), 0x0708);
+    ASSERT_EQ(cursor.remaining(), 0);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+
+TEST(Checkpoint, Truncate) {
+    auto array = "0102"_ba;
+
+    array.reserve(64);
+
+    auto capacity = array.capacity();
+    auto point = array.mark();
+
+    array.push_back<uint32_t>(0xDEADBEEF);
+
+    ASSERT_TRUE(array.rollback(point));
+    ASSERT_EQ(array, "0102"_ba);
+    ASSERT_EQ(array.capacity(), capacity);
+
+    // Mark stays valid after rollback
+    array.push_back<uint8_t>(0x03);
+    array.commit();
+
+    ASSERT_EQ(array, "010203"_ba);
+}
+
+TEST(Checkpoint, UndoSet) {
+    auto array = "00000000"_ba;
+
+    auto outer = array.mark();
+
+    array.set<uint16_t>(0, 0xAABB);
+    array.push_back<uint8_t>(0x11);
+
+    auto inner = array.mark();
+
+    array.set<uint16_t>(1, 0xCCDD);
+    array.set<uint8_t>(4, 0x22);
+    array.push_back<uint8_t>(0x33);
+
+    ASSERT_EQ(array, "AACCDD002233"_ba);
+
+    ASSERT_TRUE(array.rollback(inner));
+    ASSERT_EQ(array, "AABB000011"_ba);
+
+    ASSERT_TRUE(array.rollback(outer));
+    ASSERT_EQ(array, "00000000"_ba);
+}
+
+TEST(Checkpoint, JournalOverflow) {
+    ba::bytearray<> array(8);
+
+    auto point = array.mark();
+
+    for (std::size_t i = 0; i < ba::bytearray<>::journal_limit + 1; ++i) {
+        array.set<uint8_t>(0, uint8_t(i));
+    }
+
+    ASSERT_FALSE(array.rollback(point));
+
+    array.commit();
+
+    point = array.mark();
+    array.set<uint8_t>(0, 0xFF);
+
+    ASSERT_TRUE(array.rollback(point));
+}
+
+TEST(Checkpoint, View) {
+    auto array = "FF0102FF"_ba;
+
+    ba::bytearray_view view(array, 1, 2);
+
+    auto point = view.mark();
+
+    view.set<uint8_t>(0, 0xAA);
+    view.push_back<uint16_t>(0xBBCC);
+
+    ASSERT_EQ(array, "FFAA02BBCCFF"_ba);
+
+    ASSERT_TRUE(view.rollback(point));
+    ASSERT_EQ(view, "0102"_ba);
+    ASSERT_EQ(array, "FF0102FF"_ba);
+
+    view.commit();
+}
+
+TEST(Checkpoint, Consume) {
+    auto array = "00010203040506070809"_ba;
+
+    auto point = array.mark();
+
+    array.set<uint8_t>(5, 0xEE);
+    array.push_back<uint16_t>(0xAABB);
+    array.consume(2);
+
+    ASSERT_EQ(array, "020304EE06070809AABB"_ba);
+
+    // Consumed bytes are returned
+    ASSERT_TRUE(array.rollback(point));
+    ASSERT_EQ(array, "00010203040506070809"_ba);
+
+    array.consume(3);
+    array.set<uint8_t>(0, 0xFF);
+
+    ASSERT_TRUE(array.rollback(point));
+    ASSERT_EQ(array, "00010203040506070809"_ba);
+
+    // Storage isn't compacted while mark is active
+    array.push_back_multiple<uint8_t>(0x11, 2 * ba::bytearray<>::compact_threshold);
+    array.consume(ba::bytearray<>::compact_threshold + 20);
+
+    ASSERT_EQ(array.size(), ba::bytearray<>::compact_threshold - 10);
+    ASSERT_TRUE(array.rollback(point));
+    ASSERT_EQ(array, "00010203040506070809"_ba);
+
+    array.commit();
+    array.consume(10);
+
+    ASSERT_TRUE(array.empty());
+}
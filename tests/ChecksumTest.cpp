@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/checksum.hpp>
+#include "TestData.hpp"
+
+namespace {
+
+uint32_t reference_crc(const uint8_t* data, std::size_t size, uint32_t polynomial) {
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+        }
+    }
+
+    return ~crc;
+}
+
+uint32_t reference_adler(const uint8_t* data, std::size_t size) {
+    uint32_t s1 = 1;
+    uint32_t s2 = 0;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        s1 = (s1 + data[i]) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+
+    return s1 | (s2 << 16);
+}
+
+}  // namespace
+
+TEST(Checksum, KnownValues) {
+    const char message[] = "123456789";
+
+    ASSERT_EQ(ba::crc32c(message, 9), 0xE3069283);
+    ASSERT_EQ(ba::crc32(message, 9), 0xCBF43926);
+    ASSERT_EQ(ba::adler32("Wikipedia", 9), 0x11E60398);
+
+    ASSERT_EQ(ba::crc32c(message, 0), 0);
+    ASSERT_EQ(ba::crc32(message, 0), 0);
+    ASSERT_EQ(ba::adler32(message, 0), 1);
+}
+
+TEST(Checksum, MatchesReference) {
+    for (std::size_t size : {1, 7, 15, 16, 63, 64, 65, 100, 255, 1024, 5551, 5553, 13000, 40000}) {
+        auto array = test_data::random_bytearray(size, uint32_t(size));
+        auto data = reinterpret_cast<const uint8_t*>(array.container().data());
+
+        ASSERT_EQ(ba::crc32c(array), reference_crc(data, size, 0x82F63B78)) << size;
+        ASSERT_EQ(ba::crc32(array), reference_crc(data, size, 0xEDB88320)) << size;
+        ASSERT_EQ(ba::adler32(array), reference_adler(data, size)) << size;
+    }
+}
+
+TEST(Checksum, AllOnesAdler) {
+    ba::bytearray<> array;
+
+    array.push_back_multiple<uint8_t>(0xFF, 100000);
+
+    auto data = reinterpret_cast<const uint8_t*>(array.container().data());
+
+    ASSERT_EQ(ba::adler32(array), reference_adler(data, array.size()));
+}
+
+TEST(Checksum, View) {
+    auto array = "00112233445566778899AABBCCDDEEFF"_ba;
+
+    ba::bytearray_view view(array, 3, 9);
+
+    auto data = reinterpret_cast<const uint8_t*>(array.container().data()) + 3;
+
+    ASSERT_EQ(ba::crc32c(view), reference_crc(data, 9, 0x82F63B78));
+    ASSERT_EQ(ba::crc32(view), reference_crc(data, 9, 0xEDB88320));
+    ASSERT_EQ(ba::adler32(view), reference_adler(data, 9));
+}
+
+TEST(Checksum, Incremental) {
+    auto array = test_data::random_bytearray(10000, 10000);
+    auto data = array.container().data();
+
+    for (std::size_t split : {0, 1, 64, 333, 9999, 10000}) {
+        ASSERT_EQ(ba::crc32c(data + split, 10000 - split, ba::crc32c(data, split)), ba::crc32c(array));
+        ASSERT_EQ(ba::crc32(data + split, 10000 - split, ba::crc32(data, split)), ba::crc32(array));
+        ASSERT_EQ(ba::adler32(data + split, 10000 - split, ba::adler32(data, split)), ba::adler32(array));
+    }
+}
+
+TEST(Checksum, Combine) {
+    auto array = test_data::random_bytearray(20000, 20000);
+    auto data = array.container().data();
+
+    for (std::size_t split : {0, 1, 64, 333, 5552, 19999, 20000}) {
+        auto size2 = 20000 - split;
+
+        ASSERT_EQ(ba::crc32c_combine(ba::crc32c(data, split), ba::crc32c(data + split, size2), size2), ba::crc32c(array));
+        ASSERT_EQ(ba::crc32_combine(ba::crc32(data, split), ba::crc32(data + split, size2), size2), ba::crc32(array));
+        ASSERT_EQ(ba::adler32_combine(ba::adler32(data, split), ba::adler32(data + split, size2), size2), ba::adler32(array));
+    }
+}
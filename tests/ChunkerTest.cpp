@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/chunker.hpp>
+#include <ba/hash.hpp>
+#include "TestData.hpp"
+
+#include <random>
+#include <set>
+#include <utility>
+
+namespace {
+
+using boundaries = std::vector<std::pair<std::size_t, std::size_t>>;
+
+boundaries split(const ba::chunker& chunker, const ba::bytearray<>& array) {
+    boundaries result;
+
+    chunker.split(array.data(), array.size(), [&](std::size_t offset, std::size_t size) { result.emplace_back(offset, size); });
+
+    return result;
+}
+
+}  // namespace
+
+TEST(Chunker, Sizes) {
+    ba::chunker chunker(1024, 4096, 16384);
+
+    auto array = test_data::random_bytearray(1 << 22, 1);
+    auto chunks = split(chunker, array);
+
+    std::size_t offset = 0;
+
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        ASSERT_EQ(chunks[i].first, offset);
+        ASSERT_LE(chunks[i].second, 16384);
+
+        if (i + 1 != chunks.size()) {
+            ASSERT_GT(chunks[i].second, 1024);
+        }
+
+        offset += chunks[i].second;
+    }
+
+    ASSERT_EQ(offset, array.size());
+
+    // Normalized chunking keeps average near requested one
+    auto average = double(array.size()) / double(chunks.size());
+
+    ASSERT_GT(average, 3000);
+    ASSERT_LT(average, 6000);
+}
+
+TEST(Chunker, Fixed) {
+    ba::chunker chunker(100, 100, 100, 0);
+
+    auto chunks = split(chunker, test_data::random_bytearray(1050, 2));
+
+    ASSERT_EQ(chunks.size(), 11);
+    ASSERT_EQ(chunks[3], std::make_pair(std::size_t(300), std::size_t(100)));
+    ASSERT_EQ(chunks.back().second, 50);
+}
+
+TEST(Chunker, ContentDefined) {
+    ba::chunker chunker;
+
+    auto array = test_data::random_bytearray(1 << 21, 3);
+
+    // Bytes inserted at front shift data, but chunks after first cut point stay the same
+    auto shifted = "DEADBEEF"_ba;
+    shifted.container().insert(shifted.container().end(), array.container().begin(), array.container().end());
+
+    std::set<uint64_t> original;
+
+    for (auto chunk : split(chunker, array)) {
+        original.insert(ba::hash64(array.data() + chunk.first, chunk.second));
+    }
+
+    auto chunks = split(chunker, shifted);
+    std::size_t same = 0;
+
+    for (auto chunk : chunks) {
+        same += original.count(ba::hash64(shifted.data() + chunk.first, chunk.second));
+    }
+
+    ASSERT_GE(same + 2, chunks.size());
+}
+
+TEST(Chunker, Stream) {
+    ba::chunker chunker(512, 2048, 8192);
+
+    auto array = test_data::random_bytearray(1 << 20, 4);
+    auto expected = split(chunker, array);
+
+    std::mt19937 generator(5);
+
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        auto stream = chunker.make_stream();
+
+        boundaries chunks;
+        auto callback = [&](std::size_t offset, std::size_t size) { chunks.emplace_back(offset, size); };
+
+        for (std::size_t offset = 0; offset < array.size();) {
+            auto block = std::min<std::size_t>(generator() % 5000, array.size() - offset);
+
+            stream.feed(array.data() + offset, block, callback);
+            offset += block;
+        }
+
+        stream.finish(callback);
+
+        ASSERT_EQ(stream.offset(), array.size());
+        ASSERT_EQ(chunks, expected);
+    }
+}
+
+TEST(Chunker, Range) {
+    ba::chunker chunker(256, 1024, 4096);
+
+    auto array = test_data::random_bytearray(100000, 6);
+    auto expected = split(chunker, array);
+
+    std::size_t index = 0;
+
+    for (auto chunk : ba::chunks(array, chunker)) {
+        ASSERT_LT(index, expected.size());
+        ASSERT_EQ(chunk.data(), array.data() + expected[index].first);
+        ASSERT_EQ(chunk.size(), expected[index].second);
+        ++index;
+    }
+
+    ASSERT_EQ(index, expected.size());
+
+    // Chunks of view are relative to view start
+    ba::bytearray_view view(array, 1000, 50000);
+
+    std::size_t offset = 0;
+
+    for (auto chunk : ba::chunks(view, chunker)) {
+        ASSERT_EQ(chunk.data(), view.data() + offset);
+        ASSERT_EQ(chunk.size(), chunker.cut(view.data() + offset, view.size() - offset));
+        offset += chunk.size();
+    }
+
+    ASSERT_EQ(offset, view.size());
+
+    ba::bytearray<> empty;
+    ASSERT_TRUE(ba::chunks(empty, chunker).begin() == ba::chunks(empty, chunker).end());
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/hash.hpp>
+
+#include <set>
+#include <unordered_set>
+
+TEST(Compare, ArrayEquality) {
+    auto a = "DEADBEEF"_ba;
+    auto b = "DEADBEEF"_ba;
+    auto c = "DEADBEEE"_ba;
+
+    ASSERT_TRUE(a == b);
+    ASSERT_FALSE(a != b);
+    ASSERT_FALSE(a == c);
+    ASSERT_TRUE(a != c);
+    ASSERT_FALSE(a == "DEAD"_ba);
+    ASSERT_TRUE(""_ba == ""_ba);
+}
+
+TEST(Compare, ArrayAndView) {
+    auto array = "00DEADBEEF00"_ba;
+    auto part = "DEADBEEF"_ba;
+
+    const ba::bytearray_view view(array, 1, 4);
+
+    ASSERT_TRUE(view == part);
+    ASSERT_TRUE(part == view);
+    ASSERT_TRUE(view != array);
+    ASSERT_TRUE(array != view);
+}
+
+TEST(Compare, Reader) {
+    const std::vector<std::byte> data = {std::byte(0xDE), std::byte(0xAD)};
+
+    ba::bytearray_reader reader(data);
+
+    ASSERT_TRUE(reader == "DEAD"_ba);
+    ASSERT_TRUE("DEAD"_ba == reader);
+    ASSERT_TRUE(reader < "DEAE"_ba);
+}
+
+TEST(Compare, Ordering) {
+    ASSERT_TRUE("00"_ba < "01"_ba);
+    ASSERT_TRUE("0100"_ba > "00FF"_ba);
+    ASSERT_TRUE("01"_ba < "0100"_ba);
+    ASSERT_TRUE(""_ba < "00"_ba);
+    ASSERT_TRUE("FF"_ba >= "FF"_ba);
+    ASSERT_TRUE("FE"_ba <= "FF"_ba);
+    ASSERT_FALSE("FF"_ba < "FF"_ba);
+
+    ASSERT_LT(ba::compare("0A"_ba, "0B"_ba), 0);
+    ASSERT_GT(ba::compare("0B"_ba, "0A"_ba), 0);
+    ASSERT_EQ(ba::compare("0B"_ba, "0B"_ba), 0);
+
+    // Unsigned ordering
+    ASSERT_TRUE("7F"_ba < "80"_ba);
+}
+
+TEST(Compare, Mismatch) {
+    ba::bytearray<> a(1000);
+    ba::bytearray<> b(1000);
+
+    ASSERT_EQ(ba::mismatch(a, b), 1000);
+
+    for (std::size_t position : {0, 1, 7, 15, 16, 31, 32, 33, 500, 999}) {
+        b[position] = std::byte(0x01);
+
+        ASSERT_EQ(ba::mismatch(a, b), position);
+        ASSERT_EQ(ba::mismatch(a.container().data(), b.container().data(), a.size()), position);
+
+        ba::bytearray_view view(b, 0, position);
+
+        ASSERT_EQ(ba::mismatch(a, view), position);
+
+        b[position] = std::byte(0x00);
+    }
+
+    ASSERT_EQ(ba::mismatch("DEADBEEF"_ba, "DEAD"_ba), 2);
+}
+
+TEST(Compare, Containers) {
+    std::set<ba::bytearray<>> ordered = {"02"_ba, "0100"_ba, "01"_ba, "02"_ba};
+
+    ASSERT_EQ(ordered.size(), 3);
+    ASSERT_TRUE(*ordered.begin() == "01"_ba);
+    ASSERT_TRUE(*ordered.rbegin() == "02"_ba);
+
+    std::unordered_set<ba::bytearray<>> unordered = {"DEAD"_ba, "BEEF"_ba, "DEAD"_ba};
+
+    ASSERT_EQ(unordered.size(), 2);
+    ASSERT_EQ(unordered.count("BEEF"_ba), 1);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/search.hpp>
+
+TEST(Consume, Positions) {
+    auto array = "0001020304050607"_ba;
+
+    array.consume(3);
+
+    ASSERT_EQ(array.size(), 5);
+    ASSERT_EQ(array[0], std::byte(0x03));
+    ASSERT_EQ(array.read<uint16_t>(0), 0x0304);
+    ASSERT_EQ(array.read_part<uint32_t>(3, 2), 0x0607);
+    ASSERT_EQ(*array.begin(), std::byte(0x03));
+    ASSERT_EQ(*(array.rend() - 1), std::byte(0x03));
+    ASSERT_EQ(std::distance(array.begin(), array.end()), 5);
+    ASSERT_EQ(std::to_string(array), "0304050607");
+    ASSERT_EQ(array, "0304050607"_ba);
+
+    array.set<uint8_t>(0, 0xAA);
+    array.insert<uint8_t>(1, 0xBB, ba::endianness::little);
+
+    ASSERT_EQ(array, "AABB04050607"_ba);
+    ASSERT_THROW(array.at(6), std::out_of_range);
+
+    ASSERT_EQ(ba::find(array, uint8_t(0x05)), 3);
+
+    ba::bytearray_view view(array, 2, 2);
+
+    ASSERT_EQ(view, "0405"_ba);
+    ASSERT_EQ(view.read<uint16_t>(0), 0x0405);
+    ASSERT_EQ(*view.begin(), std::byte(0x04));
+
+    ba::bytearray_view whole(array);
+
+    ASSERT_EQ(whole.size(), 6);
+    ASSERT_EQ(whole.data(), array.data());
+}
+
+TEST(Consume, CopyAndMove) {
+    auto array = "00112233"_ba;
+
+    array.consume(2);
+
+    ba::bytearray<> copy(array);
+
+    ASSERT_EQ(copy.container().size(), 2);
+    ASSERT_EQ(copy, "2233"_ba);
+
+    ba::bytearray<> moved(std::move(array));
+
+    ASSERT_EQ(moved, "2233"_ba);
+
+    copy = moved;
+
+    ASSERT_EQ(copy, "2233"_ba);
+}
+
+TEST(Consume, Compaction) {
+    ba::bytearray<> array;
+
+    // Consuming small frames from big buffer
+    for (std::size_t i = 0; i < 1 << 16; ++i) {
+        array.push_back(uint8_t(i));
+    }
+
+    auto capacity = array.capacity();
+
+    for (std::size_t i = 0; i < (1 << 16) - 2; ++i) {
+        ASSERT_EQ(array.read<uint8_t>(0), uint8_t(i));
+
+        array.consume(1);
+    }
+
+    ASSERT_EQ(array.size(), 2);
+    ASSERT_LT(array.container().size(), 2 * ba::bytearray<>::compact_threshold);
+    ASSERT_EQ(array.capacity(), capacity);
+
+    array.consume(2);
+
+    ASSERT_TRUE(array.empty());
+    ASSERT_TRUE(array.container().empty());
+}
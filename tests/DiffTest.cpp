@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/diff.hpp>
+#include "TestData.hpp"
+
+namespace {
+
+ba::bytearray<> patched(const ba::bytearray<>& source, const ba::bytearray<>& patch) {
+    ba::bytearray<> result;
+
+    EXPECT_TRUE(ba::apply_diff(source, patch, result));
+
+    return result;
+}
+
+}  // namespace
+
+TEST(Diff, Equal) {
+    auto source = test_data::random_bytearray(100000, 1);
+    auto patch = ba::diff(source, source);
+
+    ASSERT_LT(patch.size(), 20);
+    ASSERT_EQ(ba::diff_target_size(patch), source.size());
+    ASSERT_EQ(patched(source, patch), source);
+}
+
+TEST(Diff, Empty) {
+    auto source = test_data::random_bytearray(1000, 2);
+    ba::bytearray<> empty;
+
+    ASSERT_EQ(patched(source, ba::diff(source, empty)), empty);
+    ASSERT_EQ(patched(empty, ba::diff(empty, source)), source);
+    ASSERT_EQ(patched(empty, ba::diff(empty, empty)), empty);
+}
+
+TEST(Diff, SmallChanges) {
+    auto source = test_data::random_bytearray(1 << 20, 3);
+    auto target = source;
+
+    // Replaced bytes, insertion and removal
+    target.set<uint8_t>(1000, 0x55);
+    target.set<uint32_t>(500000, 0xDEADBEEF);
+    target.container().insert(target.container().begin() + 700000, 4, std::byte(0xCA));
+    target.container().erase(target.container().begin() + 900000, target.container().begin() + 900100);
+
+    auto patch = ba::diff(source, target);
+
+    ASSERT_LT(patch.size(), 100);
+    ASSERT_EQ(patched(source, patch), target);
+}
+
+TEST(Diff, Moved) {
+    auto first = test_data::random_bytearray(50000, 4);
+    auto second = test_data::random_bytearray(50000, 5);
+
+    auto source = first;
+    source.container().insert(source.container().end(), second.container().begin(), second.container().end());
+
+    auto target = second;
+    target.container().insert(target.container().end(), first.container().begin(), first.container().end());
+
+    auto patch = ba::diff(source, target);
+
+    ASSERT_LT(patch.size(), 30);
+    ASSERT_EQ(patched(source, patch), target);
+}
+
+TEST(Diff, Unrelated) {
+    auto source = test_data::random_bytearray(10000, 6);
+    auto target = test_data::random_bytearray(12345, 7);
+
+    auto patch = ba::diff(source, target);
+
+    ASSERT_LT(patch.size(), target.size() + 20);
+    ASSERT_EQ(patched(source, patch), target);
+}
+
+TEST(Diff, BoundedIndex) {
+    auto source = test_data::random_bytearray(1 << 20, 8);
+    auto target = source;
+
+    target.set<uint8_t>(12345, 0);
+    target.container().erase(target.container().begin());
+
+    // Index of 1024 blocks - 1 KiB block size
+    ba::bytearray<> patch;
+    ba::diff(source.data(), source.size(), target.data(), target.size(), patch, 1024);
+
+    ASSERT_LT(patch.size(), 100);
+    ASSERT_EQ(patched(source, patch), target);
+}
+
+TEST(Diff, Preallocated) {
+    auto source = test_data::random_bytearray(5000, 9);
+    auto target = source;
+
+    target.set<uint16_t>(10, 0xFFFF);
+
+    auto patch = ba::diff(source, target);
+
+    std::vector<uint8_t> output(ba::diff_target_size(patch));
+    auto size = output.size();
+
+    ASSERT_TRUE(ba::apply_diff(source.data(), source.size(), patch.data(), patch.size(), output.data(), size));
+    ASSERT_EQ(size, target.size());
+    ASSERT_EQ(std::memcmp(output.data(), target.data(), size), 0);
+
+    // Not enough space
+    size = output.size() - 1;
+    ASSERT_FALSE(ba::apply_diff(source.data(), source.size(), patch.data(), patch.size(), output.data(), size));
+}
+
+TEST(Diff, Invalid) {
+    auto source = test_data::random_bytearray(5000, 10);
+    auto target = source;
+
+    target.set<uint8_t>(2500, 0);
+
+    auto patch = ba::diff(source, target);
+
+    ba::bytearray<> result = "AA"_ba;
+
+    // Other source
+    auto other = source;
+    other.set<uint8_t>(100, 1);
+
+    ASSERT_FALSE(ba::apply_diff(other, patch, result));
+    ASSERT_FALSE(ba::apply_diff(ba::bytearray_view(source, 0, 4999), patch, result));
+
+    // Truncated or damaged patch
+    for (std::size_t i = 0; i < patch.size(); ++i) {
+        ASSERT_FALSE(ba::apply_diff(source, ba::bytearray_view(patch, 0, i), result));
+
+        auto damaged = patch;
+        damaged.set<uint8_t>(i, uint8_t(damaged.read<uint8_t>(i) ^ 0x40));
+
+        ASSERT_FALSE(ba::apply_diff(source, damaged, result));
+    }
+
+    ASSERT_EQ(result, "AA"_ba);
+}
+
+TEST(Diff, HugeTargetSize) {
+    auto source = "00112233"_ba;
+
+    // Header claims 1 TiB target, but instructions describe 4 bytes
+    ba::bytearray<> patch;
+
+    patch.push_back_varint(source.size());
+    patch.push_back_varint(uint64_t(1) << 40);
+    patch.push_back<uint32_t>(0);
+    patch.push_back_varint(4U << 1);
+    patch.push_back<uint32_t>(0xDEADBEEF);
+
+    ba::bytearray<> result = "AA"_ba;
+
+    ASSERT_FALSE(ba::apply_diff(source, patch, result));
+    ASSERT_EQ(result, "AA"_ba);
+    ASSERT_LT(result.container().capacity(), 1024);
+}
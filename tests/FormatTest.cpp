@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/format.hpp>
+
+#if defined(BA_WITH_FMT)
+#include <fmt/ranges.h>
+#endif
+
+#include <string>
+#include <vector>
+
+#if defined(__cpp_lib_format)
+#define BA_TEST_FORMAT std::format
+#elif defined(FMT_VERSION)
+#define BA_TEST_FORMAT fmt::format
+#endif
+
+#if defined(BA_TEST_FORMAT)
+
+TEST(Format, Hex) {
+    auto array = "DEADbeef0001"_ba;
+
+    ASSERT_EQ(BA_TEST_FORMAT("{}", array), "DEADBEEF0001");
+    ASSERT_EQ(BA_TEST_FORMAT("{:X}", array), "DEADBEEF0001");
+    ASSERT_EQ(BA_TEST_FORMAT("{:x}", array), "deadbeef0001");
+    ASSERT_EQ(BA_TEST_FORMAT("[{:x}]", ba::bytearray<>()), "[]");
+    ASSERT_EQ(BA_TEST_FORMAT("{}", array), std::to_string(array));
+}
+
+TEST(Format, Separator) {
+    auto array = "DEADBEEF"_ba;
+
+    ASSERT_EQ(BA_TEST_FORMAT("{:s}", array), "DE AD BE EF");
+    ASSERT_EQ(BA_TEST_FORMAT("{:s:}", array), "DE:AD:BE:EF");
+    ASSERT_EQ(BA_TEST_FORMAT("{:s-}", "01"_ba), "01");
+    ASSERT_EQ(BA_TEST_FORMAT("{:s}", ba::bytearray<>()), "");
+}
+
+TEST(Format, Limit) {
+    auto array = "0011223344"_ba;
+
+    ASSERT_EQ(BA_TEST_FORMAT("{:.2x}", array), "0011...");
+    ASSERT_EQ(BA_TEST_FORMAT("{:.5x}", array), "0011223344");
+    ASSERT_EQ(BA_TEST_FORMAT("{:.64}", array), "0011223344");
+    ASSERT_EQ(BA_TEST_FORMAT("{:.0}", array), "...");
+    ASSERT_EQ(BA_TEST_FORMAT("{:.3s,}", array), "00,11,22...");
+}
+
+TEST(Format, Large) {
+    // Longer, than stack buffer of formatter
+    std::vector<uint8_t> data(1000);
+    std::string expected;
+    std::string separated;
+
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 7);
+
+        expected += "0123456789abcdef"[data[i] >> 4];
+        expected += "0123456789abcdef"[data[i] & 0xF];
+
+        separated += i == 0 ? "" : " ";
+        separated += "0123456789ABCDEF"[data[i] >> 4];
+        separated += "0123456789ABCDEF"[data[i] & 0xF];
+    }
+
+    ba::bytearray<> array(reinterpret_cast<const std::byte*>(data.data()), data.size());
+
+    ASSERT_EQ(BA_TEST_FORMAT("{:x}", array), expected);
+    ASSERT_EQ(BA_TEST_FORMAT("{:s}", array), separated);
+}
+
+TEST(Format, Hexdump) {
+    ba::bytearray<> array(reinterpret_cast<const std::byte*>("0123456789abcdefXYZ"), 20);
+
+    ASSERT_EQ(BA_TEST_FORMAT("{:d}", array),
+              "    0x00000000 | 30 31 32 33 | 34 35 36 37 | 38 39 61 62 | 63 64 65 66 | 0123456789abcdef\n"
+              "    0x00000010 | 58 59 5A 00 |             |             |             | XYZ.");
+
+    ASSERT_EQ(BA_TEST_FORMAT("{:.4d}", array), "    0x00000000 | 30 31 32 33 |             |             |             | 0123\n...");
+    ASSERT_EQ(BA_TEST_FORMAT("{:d}", ba::bytearray<>()), "");
+}
+
+TEST(Format, ReaderAndView) {
+    auto array = "AABBCCDDEE"_ba;
+
+    ba::bytearray_view view(array, 1, 3);
+
+    ASSERT_EQ(BA_TEST_FORMAT("{:x}", view), "bbccdd");
+    ASSERT_EQ(BA_TEST_FORMAT("{:.1s}", view), "BB...");
+
+    std::vector<uint8_t> data = {0x01, 0x02};
+    ba::bytearray_reader<uint8_t, std::allocator<uint8_t>> reader(data);
+
+    ASSERT_EQ(BA_TEST_FORMAT("{} {:s}", reader, reader), "0102 01 02");
+
+    const ba::bytearray_processor<std::byte, std::allocator<std::byte>>& processor = array;
+
+    ASSERT_EQ(BA_TEST_FORMAT("{:.2}", processor), "AABB...");
+}
+
+#if defined(FMT_VERSION)
+TEST(Format, WrongSpec) {
+    auto array = "0011"_ba;
+
+    ASSERT_THROW(fmt::format(fmt::runtime("{:q}"), array), fmt::format_error);
+    ASSERT_THROW(fmt::format(fmt::runtime("{:.}"), array), fmt::format_error);
+    ASSERT_THROW(fmt::format(fmt::runtime("{:xx}"), array), fmt::format_error);
+}
+
+TEST(Format, FmtRanges) {
+    // Byte arrays aren't formatted as ranges with fmt/ranges.h
+    auto array = "DEADBEEF"_ba;
+
+    ba::bytearray_view view(array, 1, 2);
+
+    ASSERT_EQ(fmt::format("{}", array), "DEADBEEF");
+    ASSERT_EQ(fmt::format("{:x}", view), "adbe");
+
+    std::vector<ba::bytearray<>> arrays = {"0102"_ba, "AA"_ba};
+
+    ASSERT_EQ(fmt::format("{}", arrays), "[0102, AA]");
+}
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/hash.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+std::vector<uint8_t> pattern(std::size_t size) {
+    std::vector<uint8_t> data(size);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        data[i] = uint8_t(i * 131 + 7);
+    }
+
+    return data;
+}
+
+}  // namespace
+
+TEST(Hash, StableValues) {
+    // Values must not depend on instruction set.
+    auto data = pattern(5000);
+
+    ASSERT_EQ(ba::hash64(data.data(), 0), 0x93228A4DE0EEC5A2ull);
+    ASSERT_EQ(ba::hash64(data.data(), 3), 0x2CB96FB680F039D3ull);
+    ASSERT_EQ(ba::hash64(data.data(), 16), 0x8B286F37C7E28104ull);
+    ASSERT_EQ(ba::hash64(data.data(), 100), 0x89F5224768F6F3A2ull);
+    ASSERT_EQ(ba::hash64(data.data(), 512), 0x5EC05DF38701CD29ull);
+    ASSERT_EQ(ba::hash64(data.data(), 1025), 0x5879D6651886FB83ull);
+    ASSERT_EQ(ba::hash64(data.data(), 5000), 0x4ABF37DF6CE6BA64ull);
+}
+
+TEST(Hash, Seed) {
+    auto data = pattern(2000);
+
+    for (std::size_t size : {0, 5, 40, 2000}) {
+        ASSERT_NE(ba::hash64(data.data(), size, 1), ba::hash64(data.data(), size, 2));
+    }
+}
+
+TEST(Hash, NoCollisions) {
+    std::unordered_set<uint64_t> hashes;
+
+    uint8_t buffer[8] = {};
+
+    for (uint32_t i = 0; i < 20000; ++i) {
+        std::memcpy(buffer, &i, sizeof(i));
+
+        for (std::size_t size : {4, 8}) {
+            hashes.insert(ba::hash64(buffer, size));
+        }
+    }
+
+    ASSERT_EQ(hashes.size(), 40000);
+
+    // Single bit flip in long input
+    auto data = pattern(3000);
+    auto initial = ba::hash64(data.data(), data.size());
+
+    for (std::size_t i = 0; i < data.size(); i += 97) {
+        data[i] ^= 0x10;
+        ASSERT_NE(ba::hash64(data.data(), data.size()), initial);
+        data[i] ^= 0x10;
+    }
+}
+
+TEST(Hash, ViewMatchesArray) {
+    auto array = "00112233445566778899AABBCCDDEEFF"_ba;
+    auto part = "33445566"_ba;
+
+    ba::bytearray_view view(array, 3, 4);
+
+    ASSERT_EQ(ba::hash64(view), ba::hash64(part));
+    ASSERT_EQ(std::hash<decltype(view)>()(view), std::hash<ba::bytearray<>>()(part));
+    ASSERT_EQ(ba::bytearray_hash()(view), ba::bytearray_hash()(part));
+    ASSERT_TRUE(ba::bytearray_equal()(view, part));
+    ASSERT_TRUE(ba::bytearray_equal()(part, view));
+    ASSERT_FALSE(ba::bytearray_equal()(array, view));
+}
+
+TEST(Hash, UnorderedMap) {
+    std::unordered_map<ba::bytearray<>, int, ba::bytearray_hash, ba::bytearray_equal> map;
+
+    map.emplace("DEADBEEF"_ba, 1);
+    map.emplace("CAFE"_ba, 2);
+    map.emplace(""_ba, 3);
+
+    ASSERT_EQ(map.size(), 3);
+    ASSERT_EQ(map.at("DEADBEEF"_ba), 1);
+    ASSERT_EQ(map.at("CAFE"_ba), 2);
+    ASSERT_EQ(map.at(""_ba), 3);
+    ASSERT_EQ(map.count("CAFF"_ba), 0);
+}
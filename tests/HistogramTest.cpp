@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/histogram.hpp>
+#include "TestData.hpp"
+
+#include <vector>
+
+namespace {
+
+ba::byte_histogram naive(const std::vector<uint8_t>& data) {
+    ba::byte_histogram result{};
+
+    for (auto value : data) {
+        ++result[value];
+    }
+
+    return result;
+}
+
+}  // namespace
+
+TEST(Histogram, Known) {
+    auto histogram = ba::histogram("0001010202020000FF"_ba);
+
+    ASSERT_EQ(histogram[0x00], 3);
+    ASSERT_EQ(histogram[0x01], 2);
+    ASSERT_EQ(histogram[0x02], 3);
+    ASSERT_EQ(histogram[0xFF], 1);
+    ASSERT_EQ(histogram[0x03], 0);
+
+    auto array = "AABBCCDD"_ba;
+
+    ba::bytearray_view view(array, 1, 2);
+
+    auto part = ba::histogram(view);
+
+    ASSERT_EQ(part[0xBB], 1);
+    ASSERT_EQ(part[0xCC], 1);
+    ASSERT_EQ(part[0xAA], 0);
+}
+
+TEST(Histogram, Sizes) {
+    for (std::size_t size : {0, 1, 7, 8, 9, 100, 4097}) {
+        for (uint32_t range : {1, 3, 256}) {
+            auto data = test_data::random_bytes(size, uint32_t(size), range);
+
+            ASSERT_EQ(ba::histogram(data.data(), data.size()), naive(data));
+        }
+    }
+}
+
+TEST(Histogram, Threads) {
+    // Amount of parts isn't multiple of size
+    auto data = test_data::random_bytes(3 * ba::detail::histogram_min_partition + 12345, 7, 256);
+    auto expected = naive(data);
+
+    for (unsigned threads : {0, 1, 2, 3, 8}) {
+        ASSERT_EQ(ba::histogram(data.data(), data.size(), threads), expected) << threads;
+    }
+}
+
+TEST(Histogram, Entropy) {
+    ASSERT_DOUBLE_EQ(ba::entropy(""_ba), 0.0);
+    ASSERT_DOUBLE_EQ(ba::entropy("AAAAAAAA"_ba), 0.0);
+    ASSERT_DOUBLE_EQ(ba::entropy("00FF00FF"_ba), 1.0);
+    ASSERT_DOUBLE_EQ(ba::entropy("00010203"_ba), 2.0);
+
+    std::vector<uint8_t> uniform(256 * 16);
+
+    for (std::size_t i = 0; i < uniform.size(); ++i) {
+        uniform[i] = uint8_t(i);
+    }
+
+    ASSERT_DOUBLE_EQ(ba::entropy(uniform.data(), uniform.size()), 8.0);
+
+    auto text = test_data::random_bytes(10000, 1, 16);
+
+    ASSERT_NEAR(ba::entropy(text.data(), text.size()), 4.0, 0.01);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/integer_codec.hpp>
+
+#include <random>
+
+namespace {
+
+template <typename T>
+void check(const std::vector<T>& values, ba::integer_encoding encoding) {
+    ba::bytearray<> array;
+
+    array.push_back<uint8_t>(0xEE);
+
+    auto written = ba::encode_integers(array, values, encoding);
+
+    ASSERT_EQ(array.size(), 1 + written);
+
+    ba::bytearray_view view(array, 1, array.size() - 1);
+    ba::integer_decoder<T> decoder(view);
+
+    ASSERT_EQ(decoder.size(), values.size());
+    ASSERT_EQ(decoder.encoded_size(), written);
+    ASSERT_EQ(decoder.encoding(), encoding);
+    ASSERT_EQ(decoder.blocks(), (values.size() + 127) / 128);
+
+    std::vector<T> decoded;
+
+    ASSERT_EQ(ba::decode_integers(view, decoded), written);
+    ASSERT_EQ(decoded, values);
+
+    for (std::size_t i = 0; i < values.size(); i += 37) {
+        ASSERT_EQ(decoder.at(i), values[i]) << i;
+    }
+}
+
+template <typename T>
+void checkAll(const std::vector<T>& values) {
+    check(values, ba::integer_encoding::frame_of_reference);
+    check(values, ba::integer_encoding::delta);
+}
+
+}  // namespace
+
+TEST(IntegerCodec, Empty) {
+    checkAll(std::vector<uint32_t>());
+    checkAll(std::vector<uint64_t>());
+}
+
+TEST(IntegerCodec, Tail) {
+    ba::bytearray<> array;
+
+    std::vector<uint32_t> values = {300, 1, 5};
+
+    ba::encode_integers(array, values);
+
+    // Count, encoding, value size and varints
+    ASSERT_EQ(array, "030004AC020105"_ba);
+
+    array.clear();
+
+    ba::encode_integers(array, values, ba::integer_encoding::delta);
+
+    // Base and differences with wrap around
+    ASSERT_EQ(array, "03010400AC02D5FDFFFF0F04"_ba);
+
+    checkAll(values);
+}
+
+TEST(IntegerCodec, Layout) {
+    ba::bytearray<> array;
+
+    std::vector<uint32_t> values(128);
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = uint32_t(i & 1);
+    }
+
+    ba::encode_integers(array, values);
+
+    // Value i goes to lane i % 4 of 16 byte word
+    ASSERT_EQ(array, "800100040100"
+                     "00000000FFFFFFFF00000000FFFFFFFF"_ba);
+}
+
+TEST(IntegerCodec, SortedTimestamps) {
+    std::vector<uint64_t> timestamps;
+
+    for (uint64_t i = 0; i < 10000; ++i) {
+        timestamps.push_back(1600000000000ULL + i * 1000 + (i % 7));
+    }
+
+    checkAll(timestamps);
+
+    ba::bytearray<> array;
+
+    ba::encode_integers(array, timestamps, ba::integer_encoding::delta);
+
+    // Differences take 12 bits instead of 64
+    ASSERT_LT(array.size(), timestamps.size() * 2);
+}
+
+TEST(IntegerCodec, Constant) {
+    std::vector<uint32_t> values(1024, 42);
+
+    checkAll(values);
+
+    ba::bytearray<> array;
+
+    ba::encode_integers(array, values);
+
+    // Blocks without packed values
+    ASSERT_LT(array.size(), 64);
+}
+
+TEST(IntegerCodec, AllWidths) {
+    std::mt19937_64 generator(40);
+
+    for (unsigned bits = 0; bits <= 64; ++bits) {
+        std::vector<uint64_t> values(300);
+
+        for (auto& value : values) {
+            value = generator() & (bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1);
+        }
+
+        checkAll(values);
+
+        if (bits <= 32) {
+            checkAll(std::vector<uint32_t>(values.begin(), values.end()));
+        }
+    }
+}
+
+TEST(IntegerCodec, Unsorted) {
+    std::mt19937 generator(40);
+    std::vector<uint32_t> values(1000);
+
+    for (auto& value : values) {
+        value = generator();
+    }
+
+    checkAll(values);
+}
+
+TEST(IntegerCodec, Invalid) {
+    ba::bytearray<> array;
+
+    ba::encode_integers(array, std::vector<uint32_t>(200, 7));
+
+    ASSERT_THROW(ba::integer_decoder<uint64_t>{array}, std::runtime_error);
+
+    array.container().pop_back();
+
+    ASSERT_THROW(ba::integer_decoder<uint32_t>{array}, std::runtime_error);
+}
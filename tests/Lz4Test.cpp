@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/lz4.hpp>
+
+#include <memory>
+#include <random>
+#include <string>
+
+namespace {
+
+ba::bytearray<> sample(std::size_t size, bool compressible) {
+    std::mt19937 generator(static_cast<uint32_t>(size));
+
+    const char* words[] = {"{\"id\":", "42", ",\"name\":\"", "sensor", "\",\"value\":", "3.14", "}\n"};
+
+    ba::bytearray<> result;
+
+    while (result.size() < size) {
+        if (compressible) {
+            auto word = words[generator() % 7];
+
+            for (std::size_t i = 0; word[i] != 0 && result.size() < size; ++i) {
+                result.push_back<uint8_t>(uint8_t(word[i]));
+            }
+        } else {
+            result.push_back<uint8_t>(uint8_t(generator()));
+        }
+    }
+
+    return result;
+}
+
+}  // namespace
+
+TEST(Lz4, DecompressKnown) {
+    // Literal 'a', match with offset 1 and length 7, literals "bcdef"
+    auto block = "1361010050626364656"
+                 "6"_ba;
+
+    ba::bytearray<> result;
+
+    ASSERT_TRUE(ba::lz4_decompress_into(block, result, 13));
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result.data()), result.size()), "aaaaaaaabcdef");
+
+    // Wrong size
+    ASSERT_FALSE(ba::lz4_decompress_into(block, result, 12));
+    ASSERT_EQ(result.size(), 13);
+}
+
+TEST(Lz4, Reference) {
+    std::string expected;
+
+    for (int i = 0; i < 40; ++i) {
+        expected += "sensor " + std::to_string(i % 8) + " value " + std::to_string(i * i) + "\n";
+    }
+
+    expected += std::string(300, 'a') + "end\n";
+
+    // Output of `lz4 -9` tool
+    auto frame = "04224D186440A70A010000F30273656E736F7220302076616C756520300A110013311100143111001332110014341100"
+                 "133311001439110014343300143612001335120024323512001336120015332400143758002B390A8C002C36348D001D"
+                 "388E003C31303090003D31323192002C343493003C31363994002D313995003C32323596003C32353697003C32383998"
+                 "002D333228012D333698003C34303098003C34343198003C34383498002D35322E012D353798003C36323598003C3637"
+                 "3698002D3732C2012D373830011E3898003C39303098003C39363198003D313032C8012E313032014E31313536CB012D"
+                 "3235CC013D323936CD011F33CE01002D343437016F313532310A610100FF185061656E640A00000000160EBE84"_ba;
+
+    ba::bytearray<> result;
+
+    ASSERT_EQ(ba::lz4_decompress_frame(frame, result), frame.size());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result.data()), result.size()), expected);
+
+    // Block after frame header and block size
+    ba::bytearray_view block(frame, 11, 266);
+
+    result.clear();
+
+    ASSERT_TRUE(ba::lz4_decompress_into(block, result, expected.size()));
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(result.data()), result.size()), expected);
+}
+
+TEST(Lz4, Invalid) {
+    uint8_t output[32] = {};
+
+    // Single empty literals sequence is valid empty block
+    std::size_t empty = sizeof(output);
+
+    ASSERT_TRUE(ba::lz4_decompress("00"_ba.data(), 1, output, empty));
+    ASSERT_EQ(empty, 0);
+
+    // Last one ends with match
+    for (auto block : {"136101"_ba, "13610000506263646566"_ba, "13610200506263646566"_ba, "F0"_ba, ""_ba, "10610100"_ba}) {
+        std::size_t size = sizeof(output);
+
+        ASSERT_FALSE(ba::lz4_decompress(block.data(), block.size(), output, size)) << std::to_string(block);
+    }
+
+    // Output is too small
+    auto block = "1361010050626364656"
+                 "6"_ba;
+
+    std::size_t size = 12;
+
+    ASSERT_FALSE(ba::lz4_decompress(block.data(), block.size(), output, size));
+}
+
+TEST(Lz4, RoundTrip) {
+    ba::lz4_state state;
+
+    for (auto compressible : {true, false}) {
+        for (std::size_t size : {0, 1, 12, 13, 100, 4096, 65535, 65536, 200000}) {
+            auto data = sample(size, compressible);
+            auto compressed = ba::lz4_compress(data, state);
+
+            ASSERT_LE(compressed.size(), ba::lz4_compress_bound(size));
+
+            if (compressible && size >= 4096) {
+                ASSERT_LT(compressed.size(), size / 2);
+            }
+
+            ba::bytearray<> result;
+
+            ASSERT_TRUE(ba::lz4_decompress_into(compressed, result, size)) << size;
+            ASSERT_EQ(result, data) << size;
+        }
+    }
+}
+
+TEST(Lz4, View) {
+    auto data = sample(1000, true);
+
+    ba::bytearray_view view(data, 100, 500);
+
+    auto compressed = ba::lz4_compress(view);
+
+    ba::bytearray<> result;
+
+    ASSERT_TRUE(ba::lz4_decompress_into(compressed, result, 500));
+    ASSERT_EQ(result, view);
+}
+
+TEST(Lz4, SmallOutput) {
+    ba::lz4_state state;
+
+    auto data = sample(1000, false);
+
+    std::vector<uint8_t> output(999);
+
+    ASSERT_EQ(ba::lz4_compress(data.data(), data.size(), output.data(), output.size(), state), 0);
+}
+
+TEST(Lz4, TinyOutput) {
+    ba::lz4_state state;
+
+    auto data = sample(64, true);
+
+    // Exact sized heap buffers, so overflow is seen by sanitizers
+    for (std::size_t capacity = 0; capacity < 16; ++capacity) {
+        std::unique_ptr<uint8_t[]> output(new uint8_t[capacity]);
+
+        ASSERT_EQ(ba::lz4_compress(data.data(), data.size(), output.get(), capacity, state), 0) << capacity;
+    }
+}
+
+TEST(Lz4, Checksum) {
+    ASSERT_EQ(ba::detail::xxh32::hash(nullptr, 0), 0x02CC5D05U);
+
+    auto data = sample(1000, false);
+
+    ba::detail::xxh32 state;
+
+    // Parts, that are not multiple of 16
+    for (std::size_t i = 0; i < data.size(); i += 7) {
+        state.update(reinterpret_cast<const uint8_t*>(data.data()) + i, std::min<std::size_t>(7, data.size() - i));
+    }
+
+    ASSERT_EQ(state.digest(), ba::detail::xxh32::hash(reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+}
+
+TEST(Lz4, EmptyFrame) {
+    // Output of `lz4` tool for empty file
+    auto frame = "04224D186440A700000000055DCC02"_ba;
+
+    ba::bytearray<> result;
+
+    ASSERT_EQ(ba::lz4_decompress_frame(frame, result), frame.size());
+    ASSERT_TRUE(result.empty());
+
+    ba::lz4_frame_encoder encoder;
+    ba::bytearray<> encoded;
+
+    encoder.begin(encoded);
+    encoder.end(encoded);
+
+    ASSERT_EQ(ba::lz4_decompress_frame(encoded, result), encoded.size());
+    ASSERT_TRUE(result.empty());
+}
+
+TEST(Lz4, Frame) {
+    auto data = sample(300000, true);
+
+    ba::lz4_frame_encoder encoder;
+
+    // Encoder is reused
+    for (std::size_t chunk : {1000, 65536, 100000}) {
+        ba::bytearray<> frame;
+
+        frame.push_back<uint8_t>(0xEE);
+
+        encoder.begin(frame);
+
+        for (std::size_t i = 0; i < data.size(); i += chunk) {
+            encoder.update(frame, data.data() + i, std::min(chunk, data.size() - i));
+        }
+
+        encoder.end(frame);
+
+        ASSERT_LT(frame.size(), data.size() / 2);
+
+        ba::bytearray_view view(frame, 1, frame.size() - 1);
+        ba::bytearray<> result;
+
+        ASSERT_EQ(ba::lz4_decompress_frame(view, result), view.size());
+        ASSERT_EQ(result, data);
+
+        // Damaged content checksum
+        frame[frame.size() - 1] ^= std::byte(1);
+
+        ASSERT_EQ(ba::lz4_decompress_frame(view, result), 0);
+        ASSERT_EQ(result, data);
+    }
+}
+
+TEST(Lz4, Dictionary) {
+    auto dictionary = sample(20000, true);
+    auto message = sample(300, true);
+
+    ba::lz4_frame_encoder plain;
+    ba::lz4_frame_encoder primed(ba::lz4_block_size::max256kb, false);
+
+    primed.load_dictionary(dictionary);
+
+    ba::bytearray<> first;
+    ba::bytearray<> second;
+
+    for (auto pair : {std::make_pair(&plain, &first), std::make_pair(&primed, &second)}) {
+        pair.first->begin(*pair.second);
+        pair.first->update(*pair.second, message);
+        pair.first->end(*pair.second);
+    }
+
+    ASSERT_LT(second.size(), first.size());
+
+    ba::bytearray<> result;
+
+    ASSERT_EQ(ba::lz4_decompress_frame(second, result, dictionary.data(), dictionary.size()), second.size());
+    ASSERT_EQ(result, message);
+}
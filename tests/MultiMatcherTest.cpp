@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/multi_matcher.hpp>
+#include "TestData.hpp"
+
+#include <random>
+
+namespace {
+
+std::vector<ba::multi_matcher::match> naive(const ba::bytearray<>& haystack, const std::vector<ba::bytearray<>>& patterns) {
+    std::vector<ba::multi_matcher::match> result;
+
+    for (std::size_t offset = 0; offset < haystack.size(); ++offset) {
+        for (std::size_t id = 0; id < patterns.size(); ++id) {
+            auto& pattern = patterns[id];
+
+            if (offset + pattern.size() <= haystack.size() &&
+                std::equal(pattern.begin(), pattern.end(), haystack.begin() + offset)) {
+                result.push_back({id, offset});
+            }
+        }
+    }
+
+    return result;
+}
+
+void check(std::size_t patternCount, uint32_t alphabet) {
+    auto haystack = test_data::random_bytearray(3000, 1, alphabet);
+
+    std::mt19937 generator(patternCount);
+    std::vector<ba::bytearray<>> patterns;
+    ba::multi_matcher matcher;
+
+    for (std::size_t i = 0; i < patternCount; ++i) {
+        std::size_t size = 1 + generator() % 6;
+        std::size_t start = generator() % (haystack.size() - size);
+
+        // Mix of present and random patterns
+        ba::bytearray<> pattern = i % 3 ? ba::bytearray<>(haystack.container().data() + start, size)
+                                        : test_data::random_bytearray(size, uint32_t(i + 100), alphabet);
+
+        ASSERT_EQ(matcher.add(pattern), i);
+
+        patterns.push_back(std::move(pattern));
+    }
+
+    matcher.compile();
+
+    auto expected = naive(haystack, patterns);
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(matcher.find_all(haystack), expected);
+
+    // Streaming with different chunk sizes
+    for (std::size_t chunk : {1, 7, 64, 1000}) {
+        std::vector<ba::multi_matcher::match> streamed;
+
+        auto stream = matcher.make_stream();
+
+        for (std::size_t offset = 0; offset < haystack.size(); offset += chunk) {
+            auto size = std::min(chunk, haystack.size() - offset);
+
+            stream.feed(haystack.container().data() + offset, size, [&streamed](const ba::multi_matcher::match& m) {
+                streamed.push_back(m);
+            });
+        }
+
+        std::sort(streamed.begin(), streamed.end());
+
+        ASSERT_EQ(stream.offset(), haystack.size());
+        ASSERT_EQ(streamed, expected) << chunk;
+    }
+}
+
+}  // namespace
+
+TEST(MultiMatcher, Overlapping) {
+    ba::multi_matcher matcher{"he", "she", "his", "hers"};
+
+    auto text = ba::bytearray<>(reinterpret_cast<const std::byte*>("ushers"), 6);
+
+    std::vector<ba::multi_matcher::match> expected = {{1, 1}, {0, 2}, {3, 2}};
+
+    ASSERT_EQ(matcher.size(), 4);
+    ASSERT_EQ(matcher.find_all(text), expected);
+}
+
+TEST(MultiMatcher, SmallSet) {
+    check(5, 4);
+    check(16, 16);
+}
+
+TEST(MultiMatcher, LargeSet) {
+    check(17, 4);
+    check(300, 256);
+}
+
+TEST(MultiMatcher, View) {
+    auto array = "00DEADBEEF00CAFE00"_ba;
+
+    ba::bytearray_view view(array, 1, 8);
+
+    ba::multi_matcher matcher;
+
+    matcher.add("CAFE"_ba);
+    matcher.add("BEEF"_ba);
+    matcher.add("00"_ba);
+    matcher.compile();
+
+    std::vector<ba::multi_matcher::match> expected = {{1, 2}, {2, 4}, {0, 5}, {2, 7}};
+
+    ASSERT_EQ(matcher.find_all(view), expected);
+}
+
+TEST(MultiMatcher, StreamAcrossBoundary) {
+    ba::multi_matcher matcher;
+
+    matcher.add("0D0A0D0A"_ba);
+    matcher.compile();
+
+    auto first = "00110D0A"_ba;
+    auto second = "0D0A22"_ba;
+
+    std::vector<ba::multi_matcher::match> found;
+
+    auto stream = matcher.make_stream();
+
+    stream.feed(first, [&found](const ba::multi_matcher::match& m) { found.push_back(m); });
+
+    ASSERT_TRUE(found.empty());
+
+    stream.feed(second, [&found](const ba::multi_matcher::match& m) { found.push_back(m); });
+
+    ASSERT_EQ(found.size(), 1);
+    ASSERT_EQ(found[0].offset, 2);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+
+#include <random>
+
+namespace {
+
+template <std::size_t Width, typename T>
+void check(ba::endianness order) {
+    std::mt19937_64 generator(Width);
+
+    // Different counts to cover vector, 8 byte and tail paths
+    for (std::size_t count : {0, 1, 3, 5, 16, 17, 100, 1001}) {
+        std::vector<T> values(count);
+
+        for (auto& value : values) {
+            value = T(generator() & (~uint64_t(0) >> (64 - 8 * Width)));
+        }
+
+        ba::bytearray<> array;
+
+        array.push_back<uint8_t>(0xEE);
+        array.pack_width<Width>(values, order);
+
+        ASSERT_EQ(array.size(), 1 + count * Width);
+
+        // Compare with byte by byte encoding
+        for (std::size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(array.read_part<T>(1 + i * Width, Width, order), values[i]) << i;
+        }
+
+        std::vector<T> unpacked(count);
+
+        ASSERT_EQ(array.unpack_width<Width>(1, unpacked.data(), count, order), count * Width);
+        ASSERT_EQ(unpacked, values) << count;
+    }
+}
+
+}  // namespace
+
+TEST(PackedWidth, Known) {
+    ba::bytearray<> array;
+
+    std::vector<uint32_t> samples = {0x112233, 0xAABBCC};
+
+    array.pack_width<3>(samples);
+
+    ASSERT_EQ(array, "112233AABBCC"_ba);
+
+    array.pack_width<3>(samples.data(), 1, ba::endianness::little);
+
+    ASSERT_EQ(array, "112233AABBCC332211"_ba);
+
+    uint64_t timestamps[2];
+
+    ba::bytearray<> stamps = "0102030405060A0B0C0D0E0F"_ba;
+
+    stamps.unpack_width<6>(0, timestamps, 2);
+
+    ASSERT_EQ(timestamps[0], 0x010203040506);
+    ASSERT_EQ(timestamps[1], 0x0A0B0C0D0E0F);
+}
+
+TEST(PackedWidth, RoundTrip) {
+    for (auto order : {ba::endianness::big, ba::endianness::little}) {
+        check<1, uint32_t>(order);
+        check<2, uint16_t>(order);
+        check<3, uint32_t>(order);
+        check<3, uint64_t>(order);
+        check<4, uint32_t>(order);
+        check<5, uint64_t>(order);
+        check<6, uint64_t>(order);
+        check<7, uint64_t>(order);
+        check<8, uint64_t>(order);
+    }
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/rle.hpp>
+
+#include <random>
+
+namespace {
+
+ba::bytearray<> sample(std::size_t size, uint32_t seed) {
+    std::mt19937 generator(seed);
+
+    ba::bytearray<> result;
+
+    while (result.size() < size) {
+        auto value = uint8_t(generator() % 4 == 0 ? 0 : generator());
+        auto length = generator() % 3 == 0 ? std::size_t(generator() % 300) : std::size_t(1);
+
+        for (std::size_t i = 0; i < length && result.size() < size; ++i) {
+            result.push_back<uint8_t>(value);
+        }
+    }
+
+    return result;
+}
+
+}  // namespace
+
+TEST(Rle, EncodeKnown) {
+    ba::bytearray<> encoded;
+
+    ASSERT_EQ(ba::rle_encode("AAAAAAB0"_ba, encoded), 4);
+    ASSERT_EQ(encoded, "80AA00B0"_ba);
+
+    encoded.clear();
+    ba::rle_encode(""_ba, encoded);
+    ASSERT_TRUE(encoded.empty());
+
+    // 131 equal bytes - maximum run and 1 literal
+    ba::bytearray<> run;
+
+    for (int i = 0; i < 131; ++i) {
+        run.push_back<uint8_t>(7);
+    }
+
+    ba::rle_encode(run, encoded);
+    ASSERT_EQ(encoded, "FF070007"_ba);
+}
+
+TEST(Rle, RoundTrip) {
+    for (std::size_t size : {0, 1, 2, 3, 15, 16, 17, 100, 128, 129, 1000, 65537}) {
+        for (uint32_t seed = 0; seed < 4; ++seed) {
+            auto data = sample(size, seed);
+
+            ba::bytearray<> encoded;
+            ba::rle_encode(data, encoded);
+
+            ba::bytearray<> decoded;
+            ASSERT_TRUE(ba::rle_decode(encoded, decoded));
+            ASSERT_EQ(decoded, data) << size;
+        }
+    }
+}
+
+TEST(Rle, Random) {
+    std::mt19937 generator(1);
+
+    ba::bytearray<> data;
+
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back<uint8_t>(uint8_t(generator()));
+    }
+
+    ba::bytearray<> encoded;
+    ba::rle_encode(data, encoded);
+
+    // Only control bytes are added
+    ASSERT_LE(encoded.size(), data.size() + data.size() / 128 + 1);
+
+    ba::bytearray<> decoded;
+    ASSERT_TRUE(ba::rle_decode(encoded, decoded));
+    ASSERT_EQ(decoded, data);
+}
+
+TEST(Rle, Invalid) {
+    auto decoded = "AA"_ba;
+
+    for (auto encoded : {"01AA"_ba, "80"_ba, "7F"_ba}) {
+        ASSERT_FALSE(ba::rle_decode(encoded, decoded));
+        ASSERT_EQ(decoded, "AA"_ba);
+    }
+
+    // Decoded data is appended
+    ASSERT_TRUE(ba::rle_decode("80BB"_ba, decoded));
+    ASSERT_EQ(decoded, "AABBBBBB"_ba);
+}
+
+TEST(ZeroRle, EncodeKnown) {
+    ba::bytearray<> encoded;
+
+    ASSERT_EQ(ba::zero_rle_encode("0000000000AA00BB"_ba, encoded), 5);
+    ASSERT_EQ(encoded, "0503AA00BB"_ba);
+
+    // Short zero run at the end is stored as zero run
+    encoded.clear();
+    ba::zero_rle_encode("0000"_ba, encoded);
+    ASSERT_EQ(encoded, "0200"_ba);
+}
+
+TEST(ZeroRle, RoundTrip) {
+    for (std::size_t size : {0, 1, 3, 4, 5, 16, 19, 20, 100, 1000, 65537}) {
+        for (uint32_t seed = 0; seed < 4; ++seed) {
+            auto data = sample(size, seed);
+
+            ba::bytearray<> encoded;
+            ba::zero_rle_encode(data, encoded);
+
+            ba::bytearray<> decoded;
+            ASSERT_TRUE(ba::zero_rle_decode(encoded, decoded));
+            ASSERT_EQ(decoded, data) << size;
+        }
+    }
+}
+
+TEST(ZeroRle, Sparse) {
+    ba::bytearray<> data(100000);
+
+    data.set<uint32_t>(500, 0xDEADBEEF);
+    data.set<uint8_t>(99999, 1);
+
+    ba::bytearray<> encoded;
+    ba::zero_rle_encode(data, encoded);
+
+    ASSERT_LT(encoded.size(), 20);
+
+    ba::bytearray<> decoded;
+    ASSERT_TRUE(ba::zero_rle_decode(encoded, decoded));
+    ASSERT_EQ(decoded, data);
+}
+
+TEST(ZeroRle, Invalid) {
+    ba::bytearray<> decoded;
+
+    for (auto encoded : {"00"_ba, "0002AA"_ba, "80"_ba, "FFFFFFFFFFFFFFFFFF7F00"_ba}) {
+        ASSERT_FALSE(ba::zero_rle_decode(encoded, decoded));
+        ASSERT_TRUE(decoded.empty());
+    }
+}
+
+TEST(ZeroRle, Limit) {
+    ba::bytearray<> decoded;
+
+    // 2^40 zeros
+    auto encoded = "80808080802000"_ba;
+
+    ASSERT_FALSE(ba::zero_rle_decode(encoded, decoded, 1 << 20));
+    ASSERT_TRUE(decoded.empty());
+
+    ASSERT_TRUE(ba::zero_rle_decode("0302AABB"_ba, decoded, 5));
+    ASSERT_EQ(decoded, "000000AABB"_ba);
+
+    ASSERT_FALSE(ba::zero_rle_decode("0302AABB"_ba, decoded, 4));
+    ASSERT_EQ(decoded, "000000AABB"_ba);
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/scatter_gather.hpp>
+
+#ifdef BA_HAS_SCATTER_GATHER
+
+#include <unistd.h>
+
+#include <thread>
+
+TEST(ScatterGather, Advance) {
+    auto header = "0102"_ba;
+    auto body = "030405"_ba;
+    auto trailer = "06"_ba;
+
+    ba::iovec_list list;
+
+    list.append(header);
+    list.append(body);
+    list.append(nullptr, 0);
+    list.append(trailer);
+
+    ASSERT_EQ(list.count(), 3);
+    ASSERT_EQ(list.size(), 6);
+
+    list.advance(3);
+
+    ASSERT_EQ(list.count(), 2);
+    ASSERT_EQ(list.size(), 3);
+    ASSERT_EQ(list.data()->iov_base, body.container().data() + 1);
+    ASSERT_EQ(list.data()->iov_len, 2);
+
+    list.advance(2);
+
+    ASSERT_EQ(list.count(), 1);
+    ASSERT_EQ(list.data()->iov_base, trailer.container().data());
+
+    list.advance(1);
+
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.count(), 0);
+}
+
+TEST(ScatterGather, WriteRead) {
+    int fds[2];
+
+    ASSERT_EQ(pipe(fds), 0);
+
+    auto header = "AABB"_ba;
+    auto payload = "00112233445566"_ba;
+
+    ba::bytearray_view body(payload, 1, 4);
+
+    ba::iovec_list output;
+
+    output.append(header);
+    output.append(body);
+
+    ASSERT_EQ(ba::writev(fds[1], output), 6);
+    ASSERT_TRUE(output.empty());
+
+    ba::bytearray<> first(1);
+    ba::bytearray<> second(5);
+
+    ba::iovec_list input;
+
+    input.append(first);
+    input.append(second);
+
+    ASSERT_EQ(ba::readv(fds[0], input), 6);
+    ASSERT_TRUE(input.empty());
+
+    ASSERT_EQ(first, "AA"_ba);
+    ASSERT_EQ(second, "BB11223344"_ba);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(ScatterGather, WriteAll) {
+    int fds[2];
+
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    // Bigger, than socket buffer, so writes are partial
+    std::vector<ba::bytearray<>> segments;
+
+    for (std::size_t i = 0; i < 64; ++i) {
+        segments.emplace_back(std::size_t(16 * 1024 + i));
+
+        for (auto& b : segments.back()) {
+            b = std::byte(i);
+        }
+    }
+
+    ba::iovec_list list;
+    std::size_t total = 0;
+
+    for (auto& segment : segments) {
+        list.append(segment);
+        total += segment.size();
+    }
+
+    ba::bytearray<> received(total);
+
+    std::thread reader([&]() {
+        std::size_t offset = 0;
+
+        while (offset < total) {
+            auto result = read(fds[1], received.container().data() + offset, total - offset);
+
+            if (result <= 0) {
+                break;
+            }
+
+            offset += std::size_t(result);
+        }
+    });
+
+    ASSERT_TRUE(ba::write_all(fds[0], list));
+
+    reader.join();
+
+    ASSERT_TRUE(list.empty());
+
+    std::size_t offset = 0;
+
+    for (auto& segment : segments) {
+        ASSERT_TRUE(std::equal(segment.begin(), segment.end(), received.begin() + offset));
+        offset += segment.size();
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(ScatterGather, SendMessage) {
+    int fds[2];
+
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    auto header = "0A0B"_ba;
+    auto body = "0C"_ba;
+
+    ba::iovec_list list;
+
+    list.append(header);
+    list.append(body);
+
+    ASSERT_EQ(ba::sendmsg(fds[0], list), 3);
+    ASSERT_TRUE(list.empty());
+
+    ba::bytearray<> received(3);
+
+    ASSERT_EQ(read(fds[1], received.container().data(), 3), 3);
+    ASSERT_EQ(received, "0A0B0C"_ba);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/search.hpp>
+#include "TestData.hpp"
+
+namespace {
+
+std::size_t naive_find(const std::vector<std::byte>& data, const std::vector<std::byte>& needle, std::size_t from) {
+    if (needle.size() > data.size()) {
+        return ba::npos;
+    }
+
+    for (std::size_t i = from; i + needle.size() <= data.size(); ++i) {
+        if (std::equal(needle.begin(), needle.end(), data.begin() + i)) {
+            return i;
+        }
+    }
+
+    return ba::npos;
+}
+
+}  // namespace
+
+TEST(Search, FindByte) {
+    ba::bytearray<> array(1000);
+
+    ASSERT_EQ(ba::find(array, uint8_t(0x0A)), ba::npos);
+
+    for (std::size_t position : {0, 1, 15, 16, 31, 32, 63, 64, 65, 500, 999}) {
+        array[position] = std::byte(0x0A);
+
+        ASSERT_EQ(ba::find(array, uint8_t(0x0A)), position);
+        ASSERT_EQ(ba::find(array, std::byte(0x0A)), position);
+        ASSERT_EQ(ba::rfind(array, uint8_t(0x0A)), position);
+        ASSERT_EQ(ba::find(array, uint8_t(0x0A), position + 1), ba::npos);
+        ASSERT_TRUE(ba::contains(array, uint8_t(0x0A)));
+
+        array[position] = std::byte(0x00);
+    }
+
+    ASSERT_FALSE(ba::contains(array, uint8_t(0x0A)));
+}
+
+TEST(Search, FindNeedle) {
+    auto array = "000D0A11220D0A330D"_ba;
+
+    ASSERT_EQ(ba::find(array, "0D0A"_ba), 1);
+    ASSERT_EQ(ba::find(array, "0D0A"_ba, 2), 5);
+    ASSERT_EQ(ba::find(array, "0D0A"_ba, 6), ba::npos);
+    ASSERT_EQ(ba::find(array, "\r\n"), 1);
+    ASSERT_EQ(ba::find(array, ""_ba), 0);
+    ASSERT_EQ(ba::find(array, "0D"_ba, 8), 8);
+    ASSERT_EQ(ba::rfind(array, "0D0A"_ba), 5);
+    ASSERT_EQ(ba::rfind(array, "0D"_ba), 8);
+    ASSERT_EQ(ba::rfind(array, "FF"_ba), ba::npos);
+    ASSERT_EQ(ba::count(array, "0D0A"_ba), 2);
+    ASSERT_EQ(ba::count(array, uint8_t(0x0D)), 3);
+    ASSERT_TRUE(ba::contains(array, "1122"_ba));
+    ASSERT_FALSE(ba::contains(array, "1133"_ba));
+    ASSERT_EQ(ba::find("0D"_ba, "0D0A"_ba), ba::npos);
+}
+
+TEST(Search, MatchesNaive) {
+    for (std::size_t size : {10, 100, 1000, 5000}) {
+        auto array = test_data::random_bytearray(size, uint32_t(size), 4);
+
+        for (std::size_t needleSize : {2, 3, 5, 8, 17}) {
+            for (std::size_t start : {std::size_t(0), std::size_t(3), size / 2}) {
+                if (start + needleSize > size) {
+                    continue;
+                }
+
+                std::vector<std::byte> needle(array.begin() + start, array.begin() + start + needleSize);
+
+                ba::bytearray<> needleArray(needle.data(), needle.size());
+
+                for (std::size_t from : {std::size_t(0), start + 1}) {
+                    ASSERT_EQ(ba::find(array, needleArray, from), naive_find(array.container(), needle, from))
+                        << size << ' ' << needleSize << ' ' << from;
+                }
+            }
+        }
+    }
+}
+
+TEST(Search, Long) {
+    auto array = test_data::random_bytearray(100000, 100000);
+    auto needle = "DEADBEEFCAFEBABE0011"_ba;
+
+    ASSERT_EQ(ba::find(array, needle), ba::npos);
+
+    for (std::size_t i = 0; i < needle.size(); ++i) {
+        array[77777 + i] = needle[i];
+    }
+
+    ASSERT_EQ(ba::find(array, needle), 77777);
+    ASSERT_EQ(ba::rfind(array, needle), 77777);
+    ASSERT_EQ(ba::count(array, needle), 1);
+}
+
+TEST(Search, CountByte) {
+    auto array = test_data::random_bytearray(20000, 20000, 3);
+
+    std::size_t expected = 0;
+
+    for (auto b : array) {
+        expected += b == std::byte(1);
+    }
+
+    ASSERT_EQ(ba::count(array, uint8_t(1)), expected);
+
+    ba::bytearray<> zeros(70000);
+
+    ASSERT_EQ(ba::count(zeros, uint8_t(0)), 70000);
+}
+
+TEST(Search, FindFirstOf) {
+    ba::bytearray<> array(300);
+
+    auto set = "0A0DFF8020"_ba;
+
+    ASSERT_EQ(ba::find_first_of(array, set), ba::npos);
+
+    for (std::size_t position : {299, 100, 40, 17, 0}) {
+        for (auto symbol : set) {
+            array[position] = symbol;
+
+            ASSERT_EQ(ba::find_first_of(array, set), position);
+        }
+
+        array[position] = std::byte(0x90);
+    }
+
+    ASSERT_EQ(ba::find_first_of(array, set), ba::npos);
+    ASSERT_EQ(ba::find_first_of(array, "\x90"), 0);
+    ASSERT_EQ(ba::find_first_of(array, "\x90\x01", 1), 17);
+    ASSERT_EQ(ba::find_first_of(array, ""), ba::npos);
+}
+
+TEST(Search, Views) {
+    auto array = "AA0D0ABB0D0ACC"_ba;
+
+    ba::bytearray_view view(array, 2, 4);
+
+    ASSERT_EQ(ba::find(view, "0D0A"_ba), 2);
+    ASSERT_EQ(ba::find(view, uint8_t(0xCC)), ba::npos);
+
+    auto found = ba::find_view(view, "0D0A"_ba);
+
+    ASSERT_TRUE(found.has_value());
+    ASSERT_EQ(found->size(), 2);
+    ASSERT_EQ(found->data(), array.container().data() + 4);
+
+    auto foundInArray = ba::find_view(array, "BB"_ba);
+
+    ASSERT_TRUE(foundInArray.has_value());
+    ASSERT_EQ(foundInArray->data(), array.container().data() + 3);
+
+    ASSERT_FALSE(ba::find_view(array, "BBCC"_ba).has_value());
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/shuffle.hpp>
+#include "TestData.hpp"
+
+TEST(Shuffle, ByteKnown) {
+    auto data = "0011223344556677AA"_ba;
+
+    ASSERT_EQ(ba::byte_shuffle(data, 2), "0022446611335577AA"_ba);
+    ASSERT_EQ(ba::byte_shuffle(data, 4), "0044115522663377AA"_ba);
+    ASSERT_EQ(ba::byte_shuffle(data, 1), data);
+}
+
+TEST(Shuffle, ByteRoundTrip) {
+    for (std::size_t width = 1; width <= 17; ++width) {
+        for (std::size_t size : {0, 1, 15, 16, 33, 100, 512, 1000, 4099}) {
+            auto data = test_data::random_bytearray(size, uint32_t(size));
+            auto shuffled = ba::byte_shuffle(data, width);
+
+            // Compare with definition
+            auto count = size / width;
+
+            for (std::size_t i = 0; i < count * width; ++i) {
+                ASSERT_EQ(shuffled[(i % width) * count + i / width], data[i]) << width << " " << size;
+            }
+
+            for (std::size_t i = count * width; i < size; ++i) {
+                ASSERT_EQ(shuffled[i], data[i]);
+            }
+
+            ASSERT_EQ(ba::byte_unshuffle(shuffled, width), data) << width << " " << size;
+        }
+    }
+}
+
+TEST(Shuffle, BitRoundTrip) {
+    for (std::size_t width : {1, 2, 3, 4, 8, 16}) {
+        for (std::size_t size : {0, 7, 8, 64, 100, 256, 1000, 4099}) {
+            auto data = test_data::random_bytearray(size, uint32_t(size));
+            auto shuffled = ba::bit_shuffle(data, width);
+            auto input = reinterpret_cast<const uint8_t*>(data.data());
+            auto output = reinterpret_cast<const uint8_t*>(shuffled.data());
+
+            // Bit `b` of plane `j` holds bit `b` of byte `j` of all elements
+            auto count = size / width / 8 * 8;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                for (std::size_t byte = 0; byte < width; ++byte) {
+                    for (std::size_t bit = 0; bit < 8; ++bit) {
+                        auto position = byte * count + bit * (count / 8) + i / 8;
+
+                        ASSERT_EQ((output[position] >> (i % 8)) & 1, (input[i * width + byte] >> bit) & 1);
+                    }
+                }
+            }
+
+            ASSERT_EQ(ba::bit_unshuffle(shuffled, width), data) << width << " " << size;
+        }
+    }
+}
+
+TEST(Shuffle, BitPlanes) {
+    // Small values have zero high bits, so most of bit rows are zero
+    std::vector<uint32_t> values(1024);
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = uint32_t(i % 16);
+    }
+
+    std::vector<uint8_t> shuffled(values.size() * sizeof(uint32_t));
+
+    ba::bit_shuffle(values.data(), shuffled.size(), sizeof(uint32_t), shuffled.data());
+
+    std::size_t nonzero = 0;
+
+    for (auto value : shuffled) {
+        nonzero += value != 0;
+    }
+
+    ASSERT_LE(nonzero, 4 * values.size() / 8);
+}
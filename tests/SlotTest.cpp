@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+
+TEST(Slot, LengthPrefix) {
+    ba::bytearray<> array;
+
+    auto length = array.reserve_slot<uint16_t>();
+
+    array.push_back<uint32_t>(0xDEADBEEF);
+    array.patch(length, array.size_after(length));
+
+    ASSERT_EQ(array, "0004DEADBEEF"_ba);
+    ASSERT_EQ(length.position, 0);
+    ASSERT_EQ(length.end(), 2);
+}
+
+TEST(Slot, Nested) {
+    ba::bytearray<> array;
+
+    // TLV in TLV
+    array.push_back<uint8_t>(0x01);
+    auto outer = array.reserve_slot<uint16_t>();
+
+    array.push_back<uint8_t>(0x02);
+    auto inner = array.reserve_slot<uint8_t>();
+
+    array.push_back<uint16_t>(0xAABB);
+    array.patch(inner, uint8_t(array.size_after(inner)));
+
+    array.push_back<uint8_t>(0xCC);
+    array.patch(outer, array.size_after(outer), ba::endianness::little);
+
+    ASSERT_EQ(array, "01050002 02AABB CC"_ba);
+}
+
+TEST(Slot, View) {
+    auto array = "FFFF"_ba;
+
+    ba::bytearray_view view(array, 1, 0);
+
+    auto length = view.reserve_slot<uint8_t>();
+
+    view.push_back<uint16_t>(0x1122);
+    view.patch(length, view.size_after(length));
+
+    ASSERT_EQ(view, "021122"_ba);
+    ASSERT_EQ(array, "FF021122FF"_ba);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/split.hpp>
+
+namespace {
+
+template <typename Range>
+std::vector<std::string> collect(const Range& range) {
+    std::vector<std::string> result;
+
+    for (auto token : range) {
+        result.push_back(std::to_string(token));
+    }
+
+    return result;
+}
+
+}  // namespace
+
+TEST(Split, SingleByte) {
+    auto array = "11002233000044"_ba;
+
+    std::vector<std::string> expected = {"11", "2233", "", "44"};
+
+    ASSERT_EQ(collect(ba::split(array, 0x00)), expected);
+}
+
+TEST(Split, MultiByte) {
+    auto array = "AA0D0ABBCC0D0A0D0ADD"_ba;
+
+    std::vector<std::string> expected = {"AA", "BBCC", "", "DD"};
+
+    ASSERT_EQ(collect(ba::split(array, "\r\n")), expected);
+    ASSERT_EQ(collect(ba::split(array, "0D0A"_ba)), expected);
+}
+
+TEST(Split, EmptyFields) {
+    auto array = "2C2C"_ba;
+
+    std::vector<std::string> expected = {"", "", ""};
+
+    ASSERT_EQ(collect(ba::split(array, ',')), expected);
+
+    ba::bytearray<> empty;
+
+    ASSERT_EQ(collect(ba::split(empty, ',')), std::vector<std::string>{""});
+
+    auto noDelimiter = "DEADBEEF"_ba;
+
+    ASSERT_EQ(collect(ba::split(noDelimiter, ',')), std::vector<std::string>{"DEADBEEF"});
+}
+
+TEST(Split, ZeroCopy) {
+    auto array = "01000203000405"_ba;
+
+    std::vector<const std::byte*> pointers;
+
+    for (auto token : ba::split(array, 0x00)) {
+        pointers.push_back(token.data());
+    }
+
+    std::vector<const std::byte*> expected = {array.container().data(), array.container().data() + 2,
+                                              array.container().data() + 5};
+
+    ASSERT_EQ(pointers, expected);
+
+    auto range = ba::split(array, 0x00);
+    auto iterator = range.begin();
+
+    ++iterator;
+
+    ASSERT_EQ(iterator.offset(), 2);
+    ASSERT_EQ((*iterator).size(), 2);
+}
+
+TEST(Split, View) {
+    auto array = "FF0100020003FF"_ba;
+
+    ba::bytearray_view view(array, 1, 5);
+
+    std::vector<std::string> expected = {"01", "02", "03"};
+
+    ASSERT_EQ(collect(ba::split(view, 0x00)), expected);
+}
+
+TEST(Split, LongDelimiter) {
+    std::string delimiter(20, '-');
+    std::string text = "first" + delimiter + "second" + delimiter;
+
+    ba::bytearray<> array(reinterpret_cast<const std::byte*>(text.data()), text.size());
+
+    std::vector<std::size_t> sizes;
+
+    for (auto token : ba::split(array, delimiter)) {
+        sizes.push_back(token.size());
+    }
+
+    ASSERT_EQ(sizes, (std::vector<std::size_t>{5, 6, 0}));
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+
+namespace {
+
+template <typename T>
+void checkSwap() {
+    for (std::size_t count : {0, 1, 3, 7, 8, 15, 16, 17, 33, 64, 100}) {
+        for (std::size_t shift = 0; shift < 3; ++shift) {
+            ba::bytearray<> array;
+
+            for (std::size_t i = 0; i < shift + count * sizeof(T) + 2; ++i) {
+                array.push_back<uint8_t>(uint8_t(i * 7 + count));
+            }
+
+            auto original = array;
+
+            array.swap_endianness<T>(shift, count);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+                    ASSERT_EQ(array[shift + i * sizeof(T) + byte], original[shift + i * sizeof(T) + sizeof(T) - 1 - byte]);
+                }
+            }
+
+            // Bytes around region are not changed
+            for (std::size_t i = 0; i < shift; ++i) {
+                ASSERT_EQ(array[i], original[i]);
+            }
+
+            for (std::size_t i = shift + count * sizeof(T); i < array.size(); ++i) {
+                ASSERT_EQ(array[i], original[i]);
+            }
+
+            array.swap_endianness<T>(shift, count);
+
+            ASSERT_EQ(array, original);
+        }
+    }
+}
+
+}  // namespace
+
+TEST(SwapEndianness, Known) {
+    auto array = "0102030405060708"_ba;
+
+    array.swap_endianness<uint16_t>(0, 4);
+    ASSERT_EQ(array, "0201040306050807"_ba);
+
+    array.swap_endianness<uint16_t>(0, 4);
+    array.swap_endianness<uint32_t>(0, 2);
+    ASSERT_EQ(array, "0403020108070605"_ba);
+
+    array.swap_endianness<uint32_t>(0, 2);
+    array.swap_endianness<uint64_t>(0, 1);
+    ASSERT_EQ(array, "0807060504030201"_ba);
+
+    array.swap_endianness<uint8_t>(0, 8);
+    ASSERT_EQ(array, "0807060504030201"_ba);
+}
+
+TEST(SwapEndianness, Sizes) {
+    checkSwap<uint16_t>();
+    checkSwap<int32_t>();
+    checkSwap<uint64_t>();
+    checkSwap<float>();
+    checkSwap<double>();
+}
+
+TEST(SwapEndianness, View) {
+    auto array = "00112233445566778899"_ba;
+
+    ba::bytearray_view view(array, 1, 8);
+
+    view.swap_endianness<uint16_t>(1, 3);
+    ASSERT_EQ(array, "00113322554477668899"_ba);
+
+    view.swap_endianness<uint32_t>(0, 2);
+    ASSERT_EQ(array, "00552233118866774499"_ba);
+}
+
+TEST(SwapEndianness, Rollback) {
+    auto array = "0011223344556677"_ba;
+
+    auto point = array.mark();
+
+    array.swap_endianness<uint32_t>(0, 2);
+    ASSERT_EQ(array, "3322110077665544"_ba);
+
+    ASSERT_TRUE(array.rollback(point));
+    ASSERT_EQ(array, "0011223344556677"_ba);
+
+    array.commit();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ba/bytearray.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace test_data {
+
+/**
+ * @brief Function for generating seeded random bytes.
+ * @param size Amount of bytes.
+ * @param seed Generator seed, same seed gives same bytes.
+ * @param alphabet Bytes are less, than this value.
+ */
+inline std::vector<uint8_t> random_bytes(std::size_t size, uint32_t seed, uint32_t alphabet = 256) {
+    std::mt19937 generator(seed);
+    std::vector<uint8_t> result(size);
+
+    for (auto& value : result) {
+        value = uint8_t(generator() % alphabet);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Function for generating byte array with
+ * seeded random bytes (the same as `random_bytes`).
+ */
+inline ba::bytearray<> random_bytearray(std::size_t size, uint32_t seed, uint32_t alphabet = 256) {
+    auto bytes = random_bytes(size, seed, alphabet);
+
+    return ba::bytearray<>(reinterpret_cast<const std::byte*>(bytes.data()), bytes.size());
+}
+
+}  // namespace test_data
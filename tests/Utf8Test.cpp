@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/utf8.hpp>
+
+#include <random>
+#include <string>
+
+namespace {
+
+// Random text with 1 - 4 byte code points
+std::string sample(std::size_t codePoints, uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::string result;
+
+    for (std::size_t i = 0; i < codePoints; ++i) {
+        uint32_t value;
+
+        switch (generator() % 4) {
+            case 0:
+                value = generator() % 0x80;
+                break;
+            case 1:
+                value = 0x80 + generator() % (0x800 - 0x80);
+                break;
+            case 2:
+                do {
+                    value = 0x800 + generator() % (0x10000 - 0x800);
+                } while (value >= 0xD800 && value <= 0xDFFF);
+                break;
+            default:
+                value = 0x10000 + generator() % (0x110000 - 0x10000);
+                break;
+        }
+
+        if (value < 0x80) {
+            result += char(value);
+        } else if (value < 0x800) {
+            result += char(0xC0 | (value >> 6));
+            result += char(0x80 | (value & 0x3F));
+        } else if (value < 0x10000) {
+            result += char(0xE0 | (value >> 12));
+            result += char(0x80 | ((value >> 6) & 0x3F));
+            result += char(0x80 | (value & 0x3F));
+        } else {
+            result += char(0xF0 | (value >> 18));
+            result += char(0x80 | ((value >> 12) & 0x3F));
+            result += char(0x80 | ((value >> 6) & 0x3F));
+            result += char(0x80 | (value & 0x3F));
+        }
+    }
+
+    return result;
+}
+
+bool valid(const std::string& text) {
+    return ba::validate_utf8(text.data(), text.size());
+}
+
+}  // namespace
+
+TEST(Utf8, Known) {
+    ASSERT_TRUE(valid(""));
+    ASSERT_TRUE(valid("plain ascii text"));
+    ASSERT_TRUE(valid("\xC2\x80"));
+    ASSERT_TRUE(valid("\xDF\xBF"));
+    ASSERT_TRUE(valid("\xE0\xA0\x80"));
+    ASSERT_TRUE(valid("\xED\x9F\xBF"));
+    ASSERT_TRUE(valid("\xEF\xBF\xBF"));
+    ASSERT_TRUE(valid("\xF0\x90\x80\x80"));
+    ASSERT_TRUE(valid("\xF4\x8F\xBF\xBF"));
+
+    // Continuation without lead byte
+    ASSERT_FALSE(valid("\x80"));
+    ASSERT_FALSE(valid("a\xBF"));
+    // Overlong forms
+    ASSERT_FALSE(valid("\xC0\x80"));
+    ASSERT_FALSE(valid("\xC1\xBF"));
+    ASSERT_FALSE(valid("\xE0\x9F\xBF"));
+    ASSERT_FALSE(valid("\xF0\x8F\xBF\xBF"));
+    // Surrogates
+    ASSERT_FALSE(valid("\xED\xA0\x80"));
+    ASSERT_FALSE(valid("\xED\xBF\xBF"));
+    // After U+10FFFF
+    ASSERT_FALSE(valid("\xF4\x90\x80\x80"));
+    ASSERT_FALSE(valid("\xF5\x80\x80\x80"));
+    ASSERT_FALSE(valid("\xFF"));
+    // Truncated and too long
+    ASSERT_FALSE(valid("\xC2"));
+    ASSERT_FALSE(valid("\xE2\x82"));
+    ASSERT_FALSE(valid("\xF0\x9F\x98"));
+    ASSERT_FALSE(valid("\xE2\x82\xAC\xAC"));
+    ASSERT_FALSE(valid("\xE2" "a" "\xAC"));
+}
+
+TEST(Utf8, Blocks) {
+    // Every error at every position relative to vector borders
+    for (std::size_t prefix = 0; prefix < 70; ++prefix) {
+        std::string base(prefix, 'a');
+
+        for (const char* error : {"\x80", "\xC2", "\xE2\x82", "\xF0\x9F\x98", "\xC0\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80"}) {
+            ASSERT_FALSE(valid(base + error)) << prefix;
+            ASSERT_FALSE(valid(base + error + std::string(40, 'b'))) << prefix;
+        }
+
+        for (const char* correct : {"\xC2\x80", "\xE2\x82\xAC", "\xF0\x9F\x98\x80"}) {
+            ASSERT_TRUE(valid(base + correct)) << prefix;
+            ASSERT_TRUE(valid(base + correct + std::string(40, 'b'))) << prefix;
+        }
+    }
+}
+
+TEST(Utf8, Random) {
+    for (uint32_t seed = 0; seed < 30; ++seed) {
+        auto text = sample(10 + seed * 20, seed);
+
+        ASSERT_TRUE(valid(text));
+
+        std::mt19937 generator(seed);
+
+        // Damaged texts are compared with scalar validation
+        for (std::size_t i = 0; i < 100; ++i) {
+            auto damaged = text;
+
+            damaged[generator() % damaged.size()] = char(generator());
+
+            if (generator() % 2) {
+                damaged.resize(generator() % damaged.size());
+            }
+
+            auto bytes = reinterpret_cast<const uint8_t*>(damaged.data());
+
+            ASSERT_EQ(valid(damaged), ba::detail::validate_utf8_scalar(bytes, damaged.size())) << seed << ' ' << i;
+        }
+    }
+}
+
+TEST(Utf8, Ascii) {
+    for (std::size_t size : {0, 1, 7, 8, 15, 16, 63, 64, 65, 200}) {
+        std::string text(size, '~');
+
+        ASSERT_TRUE(ba::is_ascii(text.data(), text.size()));
+
+        for (std::size_t i = 0; i < size; ++i) {
+            text[i] = char(0x80);
+            ASSERT_FALSE(ba::is_ascii(text.data(), text.size()));
+            text[i] = '~';
+        }
+    }
+
+    ASSERT_TRUE(ba::is_ascii("48656C6C6F"_ba));
+    ASSERT_FALSE(ba::is_ascii("48C3A9"_ba));
+}
+
+TEST(Utf8, Printable) {
+    ba::bytearray<> array;
+
+    for (std::size_t i = 0; i < 10000; ++i) {
+        array.push_back<uint8_t>(uint8_t(i * 7));
+    }
+
+    std::size_t expected = 0;
+
+    for (std::size_t i = 0; i < array.size(); ++i) {
+        auto value = uint8_t(array[i]);
+
+        expected += value >= 0x20 && value <= 0x7E;
+    }
+
+    ASSERT_EQ(ba::count_printable(array), expected);
+    ASSERT_EQ(ba::count_printable("1F207E7F80FF41"_ba), 3);
+}
+
+TEST(Utf8, StringView) {
+    auto array = "FF48C3A96C6C6FFF"_ba;
+
+    ba::bytearray_view view(array, 1, 6);
+
+    auto text = view.as_string_view();
+
+    ASSERT_TRUE(text.has_value());
+    ASSERT_EQ(*text, "H\xC3\xA9llo");
+    ASSERT_EQ(static_cast<const void*>(text->data()), static_cast<const void*>(array.data() + 1));
+
+    ASSERT_FALSE(ba::bytearray_view(array, 0, 6).as_string_view().has_value());
+    ASSERT_FALSE(ba::bytearray_view(array, 1, 2).as_string_view().has_value());
+    ASSERT_TRUE(ba::bytearray_view(array, 1, 0).as_string_view().has_value());
+    ASSERT_TRUE(ba::validate_utf8(view));
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <ba/bytearray.hpp>
+#include <ba/bytearray_view.hpp>
+#include <ba/varint.hpp>
+
+#include <random>
+
+TEST(Varint, PushBackRead) {
+    ba::bytearray<> array;
+
+    ASSERT_EQ(array.push_back_varint(0u), 1);
+    ASSERT_EQ(array.push_back_varint(300u), 2);
+    ASSERT_EQ(array.push_back_varint(std::numeric_limits<uint64_t>::max()), 10);
+
+    ASSERT_EQ(array, "00 AC02 FFFFFFFFFFFFFFFFFF01"_ba);
+
+    ASSERT_EQ(array.read_varint(0), std::make_pair(uint64_t(0), std::size_t(1)));
+    ASSERT_EQ(array.read_varint(1), std::make_pair(uint64_t(300), std::size_t(2)));
+    ASSERT_EQ(array.read_varint(3), std::make_pair(std::numeric_limits<uint64_t>::max(), std::size_t(10)));
+
+    // Doesn't fit
+    ASSERT_EQ(array.read_varint<uint8_t>(1).second, 0);
+    ASSERT_EQ(array.read_varint<uint16_t>(1).first, 300);
+}
+
+TEST(Varint, Malformed) {
+    // Truncated
+    auto truncated = "AC"_ba;
+
+    ASSERT_EQ(truncated.read_varint(0).second, 0);
+
+    // Longer, than 64 bits
+    auto overflow = "FFFFFFFFFFFFFFFFFF02"_ba;
+
+    ASSERT_EQ(overflow.read_varint(0).second, 0);
+
+    auto tooLong = "8080808080808080808000"_ba;
+
+    ASSERT_EQ(tooLong.read_varint(0).second, 0);
+}
+
+TEST(Varint, View) {
+    auto array = "FFFF"_ba;
+
+    ba::bytearray_view view(array, 1, 0);
+
+    view.push_back_varint(uint16_t(150));
+
+    ASSERT_EQ(array, "FF9601FF"_ba);
+    ASSERT_EQ(view.read_varint<uint32_t>(0), std::make_pair(uint32_t(150), std::size_t(2)));
+}
+
+TEST(Varint, Zigzag) {
+    ASSERT_EQ(ba::zigzag_encode(int32_t(0)), 0);
+    ASSERT_EQ(ba::zigzag_encode(int32_t(-1)), 1);
+    ASSERT_EQ(ba::zigzag_encode(int32_t(1)), 2);
+    ASSERT_EQ(ba::zigzag_encode(int32_t(-2)), 3);
+    ASSERT_EQ(ba::zigzag_encode(std::numeric_limits<int32_t>::min()), std::numeric_limits<uint32_t>::max());
+
+    for (int64_t value : {int64_t(0), int64_t(-1), int64_t(123456789), std::numeric_limits<int64_t>::min(),
+                          std::numeric_limits<int64_t>::max()}) {
+        ASSERT_EQ(ba::zigzag_decode(ba::zigzag_encode(value)), value);
+        ASSERT_EQ(ba::zigzag_decode(ba::zigzag_encode(int32_t(value))), int32_t(value));
+    }
+}
+
+TEST(Varint, Bulk) {
+    std::mt19937_64 generator(7);
+
+    for (auto maxBits : {7, 14, 32, 64}) {
+        ba::bytearray<> array;
+        std::vector<uint64_t> expected;
+
+        for (std::size_t i = 0; i < 5000; ++i) {
+            auto bits = 1 + generator() % maxBits;
+            auto value = bits == 64 ? generator() : generator() & ((uint64_t(1) << bits) - 1);
+
+            expected.push_back(value);
+            array.push_back_varint(value);
+        }
+
+        std::vector<uint64_t> decoded;
+
+        ASSERT_EQ(ba::decode_varints(array, decoded), array.size());
+        ASSERT_EQ(decoded, expected) << maxBits;
+
+        if (maxBits <= 32) {
+            std::vector<uint32_t> narrow;
+
+            ASSERT_EQ(ba::decode_varints(array, narrow), array.size());
+            ASSERT_TRUE(std::equal(narrow.begin(), narrow.end(), expected.begin(), expected.end()));
+        }
+    }
+}
+
+TEST(Varint, BulkStopsAtTruncated) {
+    ba::bytearray<> array;
+    std::vector<uint64_t> expected;
+
+    for (uint64_t i = 0; i < 100; ++i) {
+        array.push_back_varint(i * 1000);
+        expected.push_back(i * 1000);
+    }
+
+    auto complete = array.size();
+
+    // Truncated value at the end
+    array.push_back<uint8_t>(0x80);
+
+    std::vector<uint64_t> decoded;
+
+    ASSERT_EQ(ba::decode_varints(array.data(), array.size(), decoded), complete);
+    ASSERT_EQ(decoded, expected);
+
+    // Value doesn't fit into 32 bits
+    ba::bytearray<> wide;
+
+    wide.push_back_varint(1u);
+    wide.push_back_varint(uint64_t(1) << 40);
+
+    std::vector<uint32_t> narrow;
+
+    ASSERT_EQ(ba::decode_varints(wide, narrow), 1);
+    ASSERT_EQ(narrow, std::vector<uint32_t>{1});
+}
+
+TEST(Varint, BulkMixedLengths) {
+    // Varints of 1 - 5 bytes in every order, so every shuffle pattern is used
+    std::mt19937 generator(11);
+
+    ba::bytearray<> array;
+    std::vector<uint64_t> expected;
+
+    for (std::size_t i = 0; i < 20000; ++i) {
+        auto length = 1 + generator() % (i % 3 == 0 ? 5 : 3);
+        auto value = uint64_t(1) << (7 * (length - 1));
+
+        value |= generator() & (value - 1);
+
+        expected.push_back(value);
+        array.push_back_varint(value);
+    }
+
+    std::vector<uint64_t> decoded;
+
+    ASSERT_EQ(ba::decode_varints(array, decoded), array.size());
+    ASSERT_EQ(decoded, expected);
+
+    std::vector<uint32_t> narrow = {42};
+
+    ASSERT_EQ(ba::decode_varints(array, narrow), array.size());
+    ASSERT_EQ(narrow.front(), 42);
+    ASSERT_TRUE(std::equal(narrow.begin() + 1, narrow.end(), expected.begin(), expected.end()));
+
+    // 35 bit value in the middle of block
+    auto position = array.size();
+
+    array.push_back_varint(uint64_t(1) << 34);
+    array.push_back_multiple<uint8_t>(0, 32);
+
+    narrow.clear();
+
+    ASSERT_EQ(ba::decode_varints(array, narrow), position);
+    ASSERT_EQ(narrow.size(), expected.size());
+}